@@ -0,0 +1,637 @@
+/**
+ * @file astro_asteroids.c
+ * @brief Extended asteroid, centaur and TNO positions with mythology
+ *
+ * Apart from the main asteroids, every body has an ephemeris file of its
+ * own (ast0/se00433.se1 etc.). astro_asteroids_calc_multiple() keeps
+ * these files open in the asteroid pool of the Swiss Ephemeris, so that
+ * a set of asteroids can be computed for chart after chart without
+ * reopening the files.
+ */
+
+#include "astro_asteroids.h"
+#include "astro_core.h"
+#include "astro_aspects.h"
+#include "swephexp.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <math.h>
+
+/* Asteroid files kept open by astro_asteroids_calc_multiple() and
+ * astro_asteroids_sweep_contacts(), unless the caller has chosen a
+ * pool size */
+#define ASTEROID_POOL_FILES 128
+
+/* ========================================================================
+ * Asteroid Database
+ * ======================================================================== */
+
+typedef struct {
+    AstroidInfo info;
+    const char *category;
+} AsteroidEntry;
+
+static const AsteroidEntry g_asteroids[] = {
+    /* Major Asteroids */
+    {{ASTROID_CERES, "Ceres", "Grain goddess who searched the world for her abducted daughter",
+      {"nurturing", "harvest", "loss", "return", "mothering"}, "The Great Mother"}, "core"},
+    {{ASTROID_PALLAS, "Pallas", "Athena, born from the head of Zeus, goddess of strategy and craft",
+      {"wisdom", "strategy", "pattern", "craft", "justice"}, "The Strategist"}, "core"},
+    {{ASTROID_JUNO, "Juno", "Queen of the gods and guardian of marriage, faithful to a faithless husband",
+      {"partnership", "commitment", "loyalty", "jealousy", "equality"}, "The Consort"}, "core"},
+    {{ASTROID_VESTA, "Vesta", "Virgin keeper of the sacred hearth fire of Rome",
+      {"devotion", "focus", "purity", "service", "sacred flame"}, "The Priestess"}, "core"},
+    {{ASTROID_CHIRON, "Chiron", "Wise centaur and teacher of heroes, wounded by a poisoned arrow he could not heal",
+      {"wound", "healing", "teaching", "mentor", "bridge"}, "The Wounded Healer"}, "core"},
+    {{ASTROID_PHOLUS, "Pholus", "Centaur who opened the wine jar of the centaurs and set off their brawl",
+      {"catalyst", "release", "ancestry", "excess", "turning point"}, "The Catalyst"}, "core"},
+
+    /* Love & Relationship */
+    {{ASTROID_EROS, "Eros", "God of desire whose arrows kindle passion in mortals and gods",
+      {"passion", "desire", "attraction", "creativity", "vitality"}, "The Lover"}, "love"},
+    {{ASTROID_PSYCHE, "Psyche", "Mortal who won back Eros through trials and became immortal",
+      {"soul", "intimacy", "trust", "trial", "reunion"}, "The Soul"}, "love"},
+    {{ASTROID_AMOR, "Amor", "Roman Cupid, love that sees the beloved as a whole person",
+      {"romance", "compassion", "affection", "devotion", "tenderness"}, "The Beloved"}, "love"},
+    {{ASTROID_CUPIDO, "Cupido", "Winged child of Venus, playful and sudden attraction",
+      {"attraction", "play", "longing", "charm", "infatuation"}, "The Archer of Love"}, "love"},
+    {{ASTROID_SAPPHO, "Sappho", "Poetess of Lesbos who sang of love between women",
+      {"poetry", "sensuality", "beauty", "friendship", "expression"}, "The Poetess"}, "love"},
+    {{ASTROID_VALENTINE, "Valentine", "Martyred saint who married lovers in secret",
+      {"devotion", "loyalty", "romance", "sacrifice", "fidelity"}, "The Devoted"}, "love"},
+
+    /* Destiny & Fate */
+    {{ASTROID_KARMA, "Karma", "The law of cause and effect across lifetimes",
+      {"consequence", "pattern", "debt", "balance", "return"}, "The Reckoning"}, "destiny"},
+    {{ASTROID_MOIRA, "Moira", "The Fates who spin, measure and cut the thread of life",
+      {"fate", "destiny", "thread", "allotment", "acceptance"}, "The Spinner"}, "destiny"},
+    {{ASTROID_NEMESIS, "Nemesis", "Goddess who punishes hubris and restores due measure",
+      {"retribution", "hubris", "balance", "enemy", "reckoning"}, "The Avenger"}, "destiny"},
+    {{ASTROID_FORTUNA, "Fortuna", "Roman goddess of luck turning her wheel",
+      {"luck", "chance", "wheel", "opportunity", "reversal"}, "The Wheel"}, "destiny"},
+    {{ASTROID_TYCHE, "Tyche", "Greek goddess of the fortune of cities",
+      {"fortune", "chance", "prosperity", "risk", "providence"}, "The Gambler"}, "destiny"},
+
+    /* Wisdom & Knowledge */
+    {{ASTROID_SOPHIA, "Sophia", "Divine wisdom, the feminine aspect of God",
+      {"wisdom", "gnosis", "insight", "spirit", "understanding"}, "The Sage"}, "wisdom"},
+    {{ASTROID_ATHENE, "Athene", "Goddess of wisdom and war, protector of the city",
+      {"strategy", "intellect", "protection", "skill", "clarity"}, "The Warrior Sage"}, "wisdom"},
+    {{ASTROID_PANDORA, "Pandora", "First woman, who opened the jar of evils and kept hope",
+      {"curiosity", "revelation", "consequence", "hope", "opening"}, "The Opener"}, "wisdom"},
+    {{ASTROID_URANIA, "Urania", "Muse of astronomy and the heavens",
+      {"astronomy", "astrology", "cosmos", "inspiration", "knowledge"}, "The Star Gazer"}, "wisdom"},
+
+    /* Healing & Transformation */
+    {{ASTROID_HYGEIA, "Hygeia", "Daughter of Asclepius, goddess of health and cleanliness",
+      {"health", "prevention", "hygiene", "wellbeing", "balance"}, "The Healer"}, "healing"},
+    {{ASTROID_AESCULAPIA, "Aesculapia", "Asclepius, the physician who raised the dead",
+      {"medicine", "rescue", "regeneration", "surgery", "renewal"}, "The Physician"}, "healing"},
+    {{ASTROID_PHOENIX, "Phoenix", "Bird that burns and rises again from its ashes",
+      {"rebirth", "renewal", "fire", "resurrection", "endurance"}, "The Reborn"}, "healing"},
+    {{ASTROID_ISIS, "Isis", "Egyptian goddess who gathered and revived the dismembered Osiris",
+      {"magic", "devotion", "restoration", "wholeness", "protection"}, "The Restorer"}, "healing"},
+
+    /* Shadow & Underworld */
+    {{ASTROID_PERSEPHONE, "Persephone", "Maiden taken to the underworld who became its queen",
+      {"descent", "initiation", "seasons", "captivity", "sovereignty"}, "The Queen Below"}, "shadow"},
+    {{ASTROID_HADES, "Hades", "Ruler of the realm of the dead and its hidden riches",
+      {"underworld", "hidden", "wealth", "death", "invisibility"}, "The Hidden One"}, "shadow"},
+    {{ASTROID_HECATE, "Hecate", "Torch-bearing goddess of crossroads, magic and the night",
+      {"crossroads", "magic", "choice", "night", "guidance"}, "The Crone"}, "shadow"},
+    {{ASTROID_MEDUSA, "Medusa", "Gorgon whose gaze turned onlookers to stone",
+      {"rage", "victimisation", "power", "paralysis", "protection"}, "The Gorgon"}, "shadow"},
+    {{ASTROID_LILITH_ASTEROID, "Lilith", "First wife of Adam, who refused to submit",
+      {"independence", "rebellion", "exile", "sexuality", "refusal"}, "The Wild Woman"}, "shadow"},
+
+    /* Centaurs */
+    {{ASTROID_NESSUS, "Nessus", "Centaur whose poisoned blood killed Heracles",
+      {"abuse", "revenge", "poison", "boundaries", "the buck stops here"}, "The Abuser"}, "centaur"},
+    {{ASTROID_CHARIKLO, "Chariklo", "Nymph and wife of Chiron, graceful and steadfast",
+      {"grace", "presence", "support", "dignity", "devotion"}, "The Graceful Companion"}, "centaur"},
+    {{ASTROID_HYLONOME, "Hylonome", "Centauress who died with her slain lover Cyllarus",
+      {"grief", "loss", "attachment", "mourning", "release"}, "The Mourner"}, "centaur"},
+    {{ASTROID_ASBOLUS, "Asbolus", "Centaur seer who read the flight of birds",
+      {"divination", "intuition", "omen", "foresight", "warning"}, "The Seer"}, "centaur"},
+
+    /* Trans-Neptunian Objects */
+    {{ASTROID_ERIS, "Eris", "Goddess of strife who threw the golden apple",
+      {"discord", "disruption", "revelation", "exclusion", "truth"}, "The Disruptor"}, "tno"},
+    {{ASTROID_SEDNA, "Sedna", "Inuit sea goddess cast into the ocean by her father",
+      {"betrayal", "abandonment", "depths", "survival", "abundance"}, "The Sea Mother"}, "tno"},
+    {{ASTROID_QUAOAR, "Quaoar", "Tongva creation force who sang and danced the world into being",
+      {"creation", "harmony", "song", "dance", "order"}, "The Creator"}, "tno"},
+    {{ASTROID_MAKEMAKE, "Makemake", "Rapa Nui creator god and patron of the bird-man cult",
+      {"creation", "resourcefulness", "environment", "fertility", "cult"}, "The Maker"}, "tno"},
+    {{ASTROID_HAUMEA, "Haumea", "Hawaiian goddess of birth and fertility, reborn again and again",
+      {"birth", "fertility", "renewal", "nature", "abundance"}, "The Birth Mother"}, "tno"},
+    {{ASTROID_ORCUS, "Orcus", "Roman punisher of broken oaths",
+      {"oaths", "consequences", "integrity", "punishment", "underworld"}, "The Oath Keeper"}, "tno"},
+    {{ASTROID_IXION, "Ixion", "King who murdered and was bound to a fiery wheel",
+      {"transgression", "lawlessness", "second chance", "ingratitude", "redemption"}, "The Transgressor"}, "tno"},
+
+    /* Muses & Creativity */
+    {{ASTROID_TERPSICHORE, "Terpsichore", "Muse of dance and chorus",
+      {"dance", "movement", "rhythm", "joy", "embodiment"}, "The Dancer"}, "muses"},
+    {{ASTROID_ERATO, "Erato", "Muse of love poetry",
+      {"love poetry", "romance", "lyric", "desire", "expression"}, "The Love Poet"}, "muses"},
+    {{ASTROID_EUTERPE, "Euterpe", "Muse of music and lyric poetry",
+      {"music", "melody", "delight", "harmony", "song"}, "The Musician"}, "muses"},
+    {{ASTROID_THALIA, "Thalia", "Muse of comedy and pastoral poetry",
+      {"comedy", "humour", "festivity", "play", "lightness"}, "The Comedian"}, "muses"},
+    {{ASTROID_MELPOMENE, "Melpomene", "Muse of tragedy",
+      {"tragedy", "drama", "catharsis", "sorrow", "depth"}, "The Tragedian"}, "muses"},
+    {{ASTROID_CALLIOPE, "Calliope", "Muse of epic poetry and eloquence, chief of the Muses",
+      {"epic", "eloquence", "voice", "heroism", "storytelling"}, "The Storyteller"}, "muses"},
+
+    /* Nature & Elements */
+    {{ASTROID_GAIA, "Gaia", "Primordial Earth, mother of all",
+      {"earth", "ecology", "body", "origin", "nourishment"}, "The Earth Mother"}, "nature"},
+    {{ASTROID_DEMETER, "Demeter", "Greek goddess of grain and the cycle of the seasons",
+      {"agriculture", "nurturing", "seasons", "grief", "fertility"}, "The Provider"}, "nature"},
+    {{ASTROID_FLORA, "Flora", "Roman goddess of flowers and spring",
+      {"flowers", "spring", "blossoming", "youth", "beauty"}, "The Blossoming"}, "nature"},
+    {{ASTROID_POMONA, "Pomona", "Roman goddess of orchards and fruit trees",
+      {"fruit", "cultivation", "abundance", "patience", "harvest"}, "The Gardener"}, "nature"},
+
+    /* Justice & Truth */
+    {{ASTROID_JUSTITIA, "Justitia", "Blindfolded Roman goddess of justice",
+      {"justice", "fairness", "law", "impartiality", "judgement"}, "The Judge"}, "justice"},
+    {{ASTROID_VERITAS, "Veritas", "Roman goddess of truth, hidden at the bottom of a well",
+      {"truth", "honesty", "integrity", "disclosure", "virtue"}, "The Truth Teller"}, "justice"},
+    {{ASTROID_ASTRAEA, "Astraea", "Star maiden, last of the immortals to leave the earth",
+      {"innocence", "purity", "justice", "idealism", "golden age"}, "The Star Maiden"}, "justice"},
+
+    /* Communication & Trickster */
+    {{ASTROID_HERMES, "Hermes", "Messenger of the gods, guide of souls and trickster",
+      {"messages", "trickery", "commerce", "travel", "guidance"}, "The Trickster"}, "communication"},
+    {{ASTROID_IRIS, "Iris", "Goddess of the rainbow, messenger between heaven and earth",
+      {"rainbow", "messages", "bridge", "hope", "connection"}, "The Messenger"}, "communication"},
+
+    /* Power & War */
+    {{ASTROID_BELLONA, "Bellona", "Roman goddess of war who drove the chariot of Mars",
+      {"war", "ferocity", "determination", "conquest", "defence"}, "The War Goddess"}, "power"},
+    {{ASTROID_ARES, "Ares", "Greek god of battle, courage and bloodlust",
+      {"aggression", "courage", "conflict", "drive", "impulse"}, "The Warrior"}, "power"},
+
+    /* Additional Important Asteroids */
+    {{ASTROID_APOLLO, "Apollo", "God of the sun, prophecy, music and healing",
+      {"light", "prophecy", "art", "reason", "healing"}, "The Radiant"}, "mythic"},
+    {{ASTROID_DIANA, "Diana", "Roman huntress and goddess of the moon",
+      {"independence", "hunting", "wilderness", "protection", "moon"}, "The Huntress"}, "mythic"},
+    {{ASTROID_PROSERPINA, "Proserpina", "Roman Persephone, whose return brings the spring",
+      {"cycles", "seasons", "return", "descent", "renewal"}, "The Returning Maiden"}, "mythic"},
+    {{ASTROID_ORPHEUS, "Orpheus", "Singer who went down to the underworld to fetch his wife",
+      {"music", "descent", "doubt", "enchantment", "loss"}, "The Singer"}, "mythic"},
+    {{ASTROID_EURYDICE, "Eurydice", "Wife of Orpheus, lost again when he looked back",
+      {"lost love", "trust", "surrender", "separation", "shadow"}, "The Lost Beloved"}, "mythic"},
+};
+
+static const int g_num_asteroids = (int) (sizeof(g_asteroids) / sizeof(g_asteroids[0]));
+
+/* ========================================================================
+ * Helper Functions
+ * ======================================================================== */
+
+static const AsteroidEntry* find_entry(AstroidExtended asteroid) {
+    for (int i = 0; i < g_num_asteroids; i++) {
+        if (g_asteroids[i].info.number == (int) asteroid) {
+            return &g_asteroids[i];
+        }
+    }
+    return NULL;
+}
+
+/* Swiss Ephemeris body number; the main asteroids have body numbers of
+ * their own and are taken from the main asteroid file */
+static int asteroid_to_se_planet(AstroidExtended asteroid) {
+    switch (asteroid) {
+        case ASTROID_CERES:  return SE_CERES;
+        case ASTROID_PALLAS: return SE_PALLAS;
+        case ASTROID_JUNO:   return SE_JUNO;
+        case ASTROID_VESTA:  return SE_VESTA;
+        case ASTROID_CHIRON: return SE_CHIRON;
+        case ASTROID_PHOLUS: return SE_PHOLUS;
+        default:             return SE_AST_OFFSET + (int) asteroid;
+    }
+}
+
+/* ========================================================================
+ * Information Functions
+ * ======================================================================== */
+
+const AstroidInfo* astro_asteroids_get_info(AstroidExtended asteroid) {
+    const AsteroidEntry *entry = find_entry(asteroid);
+    return entry != NULL ? &entry->info : NULL;
+}
+
+int astro_asteroids_get_by_name(const char *name) {
+    if (name == NULL) {
+        return -1;
+    }
+    for (int i = 0; i < g_num_asteroids; i++) {
+        if (strcasecmp(g_asteroids[i].info.name, name) == 0) {
+            return g_asteroids[i].info.number;
+        }
+    }
+    return -1;
+}
+
+int astro_asteroids_get_by_category(const char *category,
+                                    AstroidExtended asteroids[],
+                                    int max_asteroids,
+                                    int *num_asteroids) {
+    if (category == NULL || asteroids == NULL || num_asteroids == NULL) {
+        return ASTRO_ERROR_NULL_POINTER;
+    }
+
+    int count = 0;
+    for (int i = 0; i < g_num_asteroids && count < max_asteroids; i++) {
+        if (strcasecmp(g_asteroids[i].category, category) == 0) {
+            asteroids[count++] = (AstroidExtended) g_asteroids[i].info.number;
+        }
+    }
+
+    *num_asteroids = count;
+    return ASTRO_OK;
+}
+
+/* ========================================================================
+ * Position Calculations
+ * ======================================================================== */
+
+/* fills position from longitude, latitude, distance and their speeds xx[] */
+static void set_position(int se_planet, const char *name, const double xx[6],
+                         AstroPlanetPosition *position) {
+    memset(position, 0, sizeof(*position));
+    position->planet = se_planet;
+    position->longitude = xx[0];
+    position->latitude = xx[1];
+    position->distance = xx[2];
+    position->longitude_speed = xx[3];
+    position->latitude_speed = xx[4];
+    position->distance_speed = xx[5];
+    position->sign = astro_core_get_sign(xx[0]);
+    position->sign_position = astro_core_get_sign_position(xx[0]);
+    position->is_retrograde = (xx[3] < 0.0) ? 1 : 0;
+    position->house = 0;  /* Set by the caller if houses are available */
+    strncpy(position->name, name, ASTRO_MAX_NAME_LEN - 1);
+    position->name[ASTRO_MAX_NAME_LEN - 1] = '\0';
+}
+
+/* position of Swiss Ephemeris body se_planet; returns the error code
+ * of swe_calc_ut() */
+static int calc_body(int se_planet, const char *name, double jd,
+                     AstroPlanetPosition *position, char *serr) {
+    double xx[6];
+    int result = swe_calc_ut(jd, se_planet, SEFLG_SWIEPH | SEFLG_SPEED, xx, serr);
+    if (result < 0) {
+        return result;
+    }
+    set_position(se_planet, name, xx, position);
+    return result;
+}
+
+/* switches the pool of open asteroid files on, if the caller has not
+ * set it up already */
+static void use_asteroid_pool(void) {
+    if (swe_get_asteroid_pool() == 0) {
+        swe_set_asteroid_pool(ASTEROID_POOL_FILES);
+    }
+}
+
+int astro_asteroids_calc_position(AstroidExtended asteroid,
+                                  const AstroDateTime *datetime,
+                                  AstroPlanetPosition *position) {
+    if (datetime == NULL || position == NULL) {
+        return ASTRO_ERROR_NULL_POINTER;
+    }
+
+    const AsteroidEntry *entry = find_entry(asteroid);
+    if (entry == NULL) {
+        return ASTRO_ERROR_INVALID_PLANET;
+    }
+
+    double jd = astro_core_get_julian_day(datetime);
+    char serr[256];
+    if (calc_body(asteroid_to_se_planet(asteroid), entry->info.name, jd, position, serr) < 0) {
+        fprintf(stderr, "Error calculating %s: %s\n", entry->info.name, serr);
+        return ASTRO_ERROR_EPHEMERIS_FILE;
+    }
+
+    return ASTRO_OK;
+}
+
+int astro_asteroids_calc_multiple(const AstroidExtended asteroids[],
+                                  int num_asteroids,
+                                  const AstroDateTime *datetime,
+                                  AstroPlanetPosition positions[]) {
+    if (asteroids == NULL || datetime == NULL || positions == NULL) {
+        return ASTRO_ERROR_NULL_POINTER;
+    }
+
+    /* Keep the asteroid files open from one call to the next */
+    use_asteroid_pool();
+
+    /* An asteroid that cannot be computed does not stop the others;
+     * its position is left empty except for the name */
+    int result = ASTRO_OK;
+    for (int i = 0; i < num_asteroids; i++) {
+        int r = astro_asteroids_calc_position(asteroids[i], datetime, &positions[i]);
+        if (r != ASTRO_OK) {
+            const AstroidInfo *info = astro_asteroids_get_info(asteroids[i]);
+            memset(&positions[i], 0, sizeof(positions[i]));
+            positions[i].planet = asteroid_to_se_planet(asteroids[i]);
+            if (info != NULL) {
+                strncpy(positions[i].name, info->name, ASTRO_MAX_NAME_LEN - 1);
+            }
+            result = r;
+        }
+    }
+
+    return result;
+}
+
+/* ========================================================================
+ * Contacts
+ * ======================================================================== */
+
+int astro_asteroids_is_conjunct(const AstroPlanetPosition *asteroid_pos,
+                                const AstroPlanetPosition *planet_pos,
+                                double orb) {
+    if (asteroid_pos == NULL || planet_pos == NULL) {
+        return 0;
+    }
+    return astro_core_angular_distance(asteroid_pos->longitude,
+                                       planet_pos->longitude) <= orb ? 1 : 0;
+}
+
+int astro_asteroids_find_contacts(const AstroPlanetPosition asteroid_positions[],
+                                  int num_asteroids,
+                                  const AstroPlanetPosition planet_positions[],
+                                  int num_planets,
+                                  double orb,
+                                  AstroAspect contacts[],
+                                  int max_contacts,
+                                  int *num_contacts) {
+    if (asteroid_positions == NULL || planet_positions == NULL ||
+        contacts == NULL || num_contacts == NULL) {
+        return ASTRO_ERROR_NULL_POINTER;
+    }
+
+    int count = 0;
+    for (int a = 0; a < num_asteroids && count < max_contacts; a++) {
+        for (int p = 0; p < num_planets && count < max_contacts; p++) {
+            const AstroPlanetPosition *ast = &asteroid_positions[a];
+            const AstroPlanetPosition *pl = &planet_positions[p];
+            double diff = astro_core_angular_distance(ast->longitude, pl->longitude);
+            if (diff > orb) {
+                continue;
+            }
+            AstroAspect *contact = &contacts[count++];
+            contact->planet1 = ast->planet;
+            contact->planet2 = pl->planet;
+            contact->aspect_type = ASTRO_ASPECT_CONJUNCTION;
+            contact->orb = diff;
+            contact->difference = diff;
+            contact->is_applying = astro_aspects_is_applying(ast, pl, contact);
+            contact->is_exact = (diff <= 1.0) ? 1 : 0;
+            snprintf(contact->name, ASTRO_MAX_NAME_LEN, "%.24s %s %.24s",
+                     ast->name, astro_aspects_get_name(ASTRO_ASPECT_CONJUNCTION), pl->name);
+        }
+    }
+
+    *num_contacts = count;
+    return ASTRO_OK;
+}
+
+/* ========================================================================
+ * Contact Searches over the Asteroid Catalog
+ * ======================================================================== */
+
+/* Allowance for the perturbations that the Keplerian orbits neglect,
+ * as heliocentric angle in degrees, growing with the years between the
+ * epoch of the elements and the date. Fitted to the osculating elements
+ * of Ceres, Pallas, Juno, Vesta, Chiron, Pholus, Mars, Jupiter and Saturn
+ * propagated over +-50 years. */
+#define KEPLER_ALLOW0       0.01
+#define KEPLER_ALLOW_YEAR   0.13
+/* Aberration, nutation and light-time, geocentric degrees */
+#define KEPLER_ALLOW_APPARENT 0.02
+
+/* value of a base-62 digit of the MPC packed formats */
+static int unpack_digit(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'A' && c <= 'Z') return c - 'A' + 10;
+    if (c >= 'a' && c <= 'z') return c - 'a' + 36;
+    return -1;
+}
+
+/* Julian day of an MPC packed epoch, e.g. "K24AH" = 2024 Oct 17.0 TT */
+static double unpack_epoch(const char *packed) {
+    int year = unpack_digit(packed[0]) * 100 + unpack_digit(packed[1]) * 10 + unpack_digit(packed[2]);
+    return swe_julday(year, unpack_digit(packed[3]), unpack_digit(packed[4]), 0.0, SE_GREG_CAL);
+}
+
+/* number in the columns col ... col + len - 1 (1-based) of an MPC record */
+static double mpc_field(const char *line, int col, int len) {
+    char buf[32];
+    memcpy(buf, line + col - 1, len);
+    buf[len] = '\0';
+    return atof(buf);
+}
+
+int astro_asteroids_load_elements(const char *path, AsteroidElements *elements) {
+    if (path == NULL || elements == NULL) {
+        return ASTRO_ERROR_NULL_POINTER;
+    }
+    memset(elements, 0, sizeof(*elements));
+
+    FILE *fp = fopen(path, "r");
+    if (fp == NULL) {
+        fprintf(stderr, "Cannot open asteroid elements %s\n", path);
+        return ASTRO_ERROR_EPHEMERIS_FILE;
+    }
+
+    int capacity = 0;
+    char line[512];
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        /* numbered asteroids only: readable designation "(433) Eros" 
+         * in columns 167 - 194 */
+        if (strlen(line) < 175 || line[166] != '(') {
+            continue;
+        }
+        if (elements->count == capacity) {
+            int n = capacity > 0 ? 2 * capacity : 4096;
+            int *number = realloc(elements->number, n * sizeof(int));
+            if (number != NULL) elements->number = number;
+            double *el = realloc(elements->elements, n * SE_KEPLER_NELEM * sizeof(double));
+            if (el != NULL) elements->elements = el;
+            char (*name)[ASTEROID_ELEM_NAME_LEN] = realloc(elements->name, n * sizeof(*name));
+            if (name != NULL) elements->name = name;
+            if (number == NULL || el == NULL || name == NULL) {
+                fclose(fp);
+                astro_asteroids_free_elements(elements);
+                return ASTRO_ERROR_CALCULATION;
+            }
+            capacity = n;
+        }
+
+        int i = elements->count;
+        elements->number[i] = atoi(line + 167);
+
+        /* name after the number, up to column 194 */
+        const char *sp = strchr(line + 167, ')');
+        int len = 0;
+        if (sp != NULL) {
+            for (sp++; *sp == ' '; sp++);
+            while (len < ASTEROID_ELEM_NAME_LEN - 1 && sp + len < line + 194 &&
+                   sp[len] != '\0' && sp[len] != '\n' && sp[len] != '\r') {
+                len++;
+            }
+            while (len > 0 && sp[len - 1] == ' ') len--;
+            memcpy(elements->name[i], sp, len);
+        }
+        elements->name[i][len] = '\0';
+
+        double *el = elements->elements + i * SE_KEPLER_NELEM;
+        el[0] = unpack_epoch(line + 20);
+        el[1] = mpc_field(line, 93, 11);    /* semimajor axis */
+        el[2] = mpc_field(line, 71, 9);     /* eccentricity */
+        el[3] = mpc_field(line, 60, 9);     /* inclination */
+        el[4] = mpc_field(line, 49, 9);     /* ascending node */
+        el[5] = mpc_field(line, 38, 9);     /* argument of perihelion */
+        el[6] = mpc_field(line, 27, 9);     /* mean anomaly */
+        el[7] = mpc_field(line, 81, 11);    /* mean daily motion */
+        elements->count++;
+    }
+    fclose(fp);
+
+    if (elements->count == 0) {
+        fprintf(stderr, "No numbered asteroids in %s\n", path);
+        return ASTRO_ERROR_EPHEMERIS_FILE;
+    }
+    return ASTRO_OK;
+}
+
+void astro_asteroids_free_elements(AsteroidElements *elements) {
+    if (elements == NULL) {
+        return;
+    }
+    free(elements->number);
+    free(elements->elements);
+    free(elements->name);
+    memset(elements, 0, sizeof(*elements));
+}
+
+int astro_asteroids_sweep_contacts(const AsteroidElements *elements,
+                                   const AstroDateTime *datetime,
+                                   const AstroPlanetPosition planet_positions[],
+                                   int num_planets,
+                                   double orb,
+                                   AstroAspect contacts[],
+                                   int max_contacts,
+                                   int *num_contacts) {
+    if (elements == NULL || datetime == NULL || planet_positions == NULL ||
+        contacts == NULL || num_contacts == NULL) {
+        return ASTRO_ERROR_NULL_POINTER;
+    }
+    *num_contacts = 0;
+    if (elements->count == 0 || num_planets <= 0) {
+        return ASTRO_OK;
+    }
+
+    double jd = astro_core_get_julian_day(datetime);
+    double tjd = jd + swe_deltat_ex(jd, SEFLG_SWIEPH, NULL);
+    char serr[256];
+
+    /* Stage one: approximate positions of all asteroids */
+    double *xx = malloc((size_t) elements->count * 3 * sizeof(double));
+    int *candidate = malloc((size_t) elements->count * sizeof(int));
+    if (xx == NULL || candidate == NULL) {
+        free(xx);
+        free(candidate);
+        return ASTRO_ERROR_CALCULATION;
+    }
+    if (swe_kepler_batch(tjd, elements->count, elements->elements, SEFLG_SWIEPH, xx, serr) < 0) {
+        fprintf(stderr, "Error in asteroid survey: %s\n", serr);
+        free(xx);
+        free(candidate);
+        return ASTRO_ERROR_CALCULATION;
+    }
+
+    /* Lower bound of the distance of a longitude in each degree from
+     * the nearest chart point, so that most asteroids are rejected with
+     * a single lookup */
+    double bin_dist[360];
+    for (int b = 0; b < 360; b++) {
+        bin_dist[b] = 180.0;
+        for (int p = 0; p < num_planets; p++) {
+            double d = astro_core_angular_distance(b + 0.5, planet_positions[p].longitude) - 0.5;
+            if (d < bin_dist[b]) {
+                bin_dist[b] = d < 0.0 ? 0.0 : d;
+            }
+        }
+    }
+
+    int num_candidates = 0;
+    for (int i = 0; i < elements->count; i++) {
+        const double *x = xx + 3 * i;
+        if (x[2] <= 0.0) {
+            continue;  /* not on an elliptic orbit */
+        }
+        /* the heliocentric allowance as seen from the Earth; r / delta
+         * is less than 1 + 1.02 / delta */
+        double years = fabs(tjd - elements->elements[i * SE_KEPLER_NELEM]) / 365.25;
+        double limit = orb + KEPLER_ALLOW_APPARENT +
+                       (KEPLER_ALLOW0 + KEPLER_ALLOW_YEAR * years) * (1.0 + 1.02 / x[2]);
+        int b = (int) x[0];
+        if (b >= 0 && b < 360 && bin_dist[b] > limit) {
+            continue;
+        }
+        for (int p = 0; p < num_planets; p++) {
+            if (astro_core_angular_distance(x[0], planet_positions[p].longitude) <= limit) {
+                candidate[num_candidates++] = i;
+                break;
+            }
+        }
+    }
+
+    /* Stage two: the candidates from their ephemeris files */
+    int result = ASTRO_OK;
+    AstroPlanetPosition *refined = malloc((num_candidates > 0 ? num_candidates : 1) * sizeof(AstroPlanetPosition));
+    if (refined == NULL) {
+        free(xx);
+        free(candidate);
+        return ASTRO_ERROR_CALCULATION;
+    }
+    use_asteroid_pool();
+    int num_refined = 0;
+    for (int k = 0; k < num_candidates; k++) {
+        int i = candidate[k];
+        char name[ASTRO_MAX_NAME_LEN];
+        if (elements->name[i][0] != '\0') {
+            snprintf(name, sizeof(name), "%s", elements->name[i]);
+        } else {
+            snprintf(name, sizeof(name), "%d", elements->number[i]);
+        }
+        int se_planet = asteroid_to_se_planet((AstroidExtended) elements->number[i]);
+        if (calc_body(se_planet, name, jd, &refined[num_refined], serr) < 0) {
+            /* no ephemeris file: the Keplerian position of stage one,
+             * without speed */
+            double xk[6] = {xx[3 * i], xx[3 * i + 1], xx[3 * i + 2], 0.0, 0.0, 0.0};
+            set_position(se_planet, name, xk, &refined[num_refined]);
+            result = ASTRO_ERROR_EPHEMERIS_FILE;
+        }
+        num_refined++;
+    }
+    free(xx);
+    free(candidate);
+
+    astro_asteroids_find_contacts(refined, num_refined, planet_positions, num_planets,
+                                  orb, contacts, max_contacts, num_contacts);
+    free(refined);
+    return result;
+}
@@ -128,6 +128,20 @@ typedef struct {
     const char *archetype;         /* Archetypal theme */
 } AstroidInfo;
 
+/**
+ * Osculating elements of many numbered asteroids, as read from the
+ * MPC file MPCORB.DAT, for contact searches over the whole catalog
+ */
+#define ASTEROID_ELEM_NAME_LEN 24
+
+typedef struct {
+    int count;                     /* Number of asteroids */
+    int *number;                   /* MPC numbers */
+    double *elements;              /* SE_KEPLER_NELEM doubles per asteroid,
+                                    * s. swe_kepler_batch() */
+    char (*name)[ASTEROID_ELEM_NAME_LEN];  /* Names */
+} AsteroidElements;
+
 /* ========================================================================
  * Functions
  * ======================================================================== */
@@ -155,6 +169,12 @@ int astro_asteroids_calc_position(AstroidExtended asteroid,
 /**
  * Calculate positions for multiple asteroids
  *
+ * The asteroid files stay open between calls (s. swe_set_asteroid_pool()),
+ * so that the same asteroids can be computed for many charts without
+ * reopening them. If the caller has set a pool size, it is kept. An asteroid that cannot be computed gets an empty
+ * position with its name, and the error is returned after all others
+ * have been computed.
+ *
  * @param asteroids Array of asteroid identifiers
  * @param num_asteroids Number of asteroids to calculate
  * @param datetime Date/time for calculation
@@ -177,7 +197,9 @@ int astro_asteroids_get_by_name(const char *name);
 /**
  * Get all asteroids in a category
  *
- * @param category Category name ("love", "healing", "destiny", etc.)
+ * @param category Category name: "core", "love", "destiny", "wisdom",
+ *                 "healing", "shadow", "centaur", "tno", "muses", "nature",
+ *                 "justice", "communication", "power" or "mythic"
  * @param asteroids Array to store asteroid identifiers
  * @param max_asteroids Maximum asteroids to return
  * @param num_asteroids Pointer to store count
@@ -222,6 +244,60 @@ int astro_asteroids_find_contacts(const AstroPlanetPosition asteroid_positions[]
                                   int max_contacts,
                                   int *num_contacts);
 
+/* ========================================================================
+ * Contact Searches over the Asteroid Catalog
+ * ======================================================================== */
+
+/**
+ * Load the numbered asteroids of an MPC orbit file
+ *
+ * @param path Path of MPCORB.DAT (or an extract in the same format)
+ * @param elements Pointer to store the elements; free with
+ *                 astro_asteroids_free_elements()
+ * @return ASTRO_OK on success, error code otherwise
+ */
+int astro_asteroids_load_elements(const char *path, AsteroidElements *elements);
+
+/**
+ * Free elements loaded by astro_asteroids_load_elements()
+ *
+ * @param elements Elements to free
+ */
+void astro_asteroids_free_elements(AsteroidElements *elements);
+
+/**
+ * Find all conjunctions of catalog asteroids with chart points
+ *
+ * Two stages: all asteroids are first propagated on Keplerian orbits
+ * (swe_kepler_batch()), and only those that come within the orb plus
+ * an allowance for the neglected perturbations are computed with
+ * swe_calc_ut() from their ephemeris files. The allowance grows with the
+ * distance of the date from the epoch of the elements and for asteroids
+ * close to the Earth; close encounters with planets between epoch and
+ * date are not accounted for.
+ *
+ * @param elements Asteroid elements
+ * @param datetime Date/time of the chart
+ * @param planet_positions Chart points
+ * @param num_planets Number of chart points
+ * @param orb Maximum orb for conjunction
+ * @param contacts Array to store aspects (the asteroid is planet1)
+ * @param max_contacts Maximum contacts to find
+ * @param num_contacts Pointer to store count
+ * @return ASTRO_OK on success; ASTRO_ERROR_EPHEMERIS_FILE if some
+ *         candidates have no ephemeris file. Their contacts are then
+ *         judged from the Keplerian positions of stage one, which may be
+ *         off by the allowance, and are returned with the others.
+ */
+int astro_asteroids_sweep_contacts(const AsteroidElements *elements,
+                                   const AstroDateTime *datetime,
+                                   const AstroPlanetPosition planet_positions[],
+                                   int num_planets,
+                                   double orb,
+                                   AstroAspect contacts[],
+                                   int max_contacts,
+                                   int *num_contacts);
+
 #ifdef __cplusplus
 }
 #endif
@@ -148,26 +148,9 @@ double astro_core_get_sidereal_time(const AstroDateTime *datetime, double longit
  * Planet Position Calculations
  * ======================================================================== */
 
-int astro_core_calc_planet(AstroPlanet planet, const AstroDateTime *datetime,
-                           int flags, AstroPlanetPosition *position) {
-    if (datetime == NULL || position == NULL) {
-        return ASTRO_ERROR_NULL_POINTER;
-    }
-
-    if (planet < 0 || planet >= ASTRO_MAX_PLANETS) {
-        return ASTRO_ERROR_INVALID_PLANET;
-    }
-
-    double jd = astro_core_get_julian_day(datetime);
-    double xx[6];
-    char serr[256];
-
-    /* Calculate planet position */
-    int result = swe_calc_ut(jd, planet, flags | SEFLG_SPEED, xx, serr);
-    if (result < 0) {
-        return ASTRO_ERROR_CALCULATION;
-    }
-
+/* Fill a position structure from a swe_calc() result vector */
+static void fill_planet_position(AstroPlanet planet, const double *xx,
+                                 AstroPlanetPosition *position) {
     /* Fill in position structure */
     position->planet = planet;
     position->longitude = xx[0];
@@ -190,7 +173,29 @@ int astro_core_calc_planet(AstroPlanet planet, const AstroDateTime *datetime,
 
     /* House will be filled in later when houses are calculated */
     position->house = 0;
+}
+
+int astro_core_calc_planet(AstroPlanet planet, const AstroDateTime *datetime,
+                           int flags, AstroPlanetPosition *position) {
+    if (datetime == NULL || position == NULL) {
+        return ASTRO_ERROR_NULL_POINTER;
+    }
 
+    if (planet < 0 || planet >= ASTRO_MAX_PLANETS) {
+        return ASTRO_ERROR_INVALID_PLANET;
+    }
+
+    double jd = astro_core_get_julian_day(datetime);
+    double xx[6];
+    char serr[256];
+
+    /* Calculate planet position */
+    int result = swe_calc_ut(jd, planet, flags | SEFLG_SPEED, xx, serr);
+    if (result < 0) {
+        return ASTRO_ERROR_CALCULATION;
+    }
+
+    fill_planet_position(planet, xx, position);
     return ASTRO_OK;
 }
 
@@ -200,34 +205,39 @@ int astro_core_calc_planets(const AstroDateTime *datetime, int flags,
         return ASTRO_ERROR_NULL_POINTER;
     }
 
+    int32 bodies[ASTRO_MAX_PLANETS];
+    int32 retflags[ASTRO_MAX_PLANETS];
+    double xx[ASTRO_MAX_PLANETS * 6];
+    char serr[256];
+    int nbodies = 0;
     int count = 0;
     int max_planet = g_config.include_asteroids ? ASTRO_VESTA : ASTRO_PLUTO;
 
-    /* Calculate main planets */
+    /* Main planets */
     for (int i = ASTRO_SUN; i <= max_planet; i++) {
         if (i == ASTRO_EARTH) continue; /* Skip Earth for geocentric */
-
-        int result = astro_core_calc_planet(i, datetime, flags, &positions[count]);
-        if (result == ASTRO_OK) {
-            count++;
-        }
+        bodies[nbodies++] = i;
     }
 
     /* Add nodes if configured */
     if (g_config.include_nodes) {
-        AstroPlanet node = g_config.use_true_node ? ASTRO_TRUE_NODE : ASTRO_MEAN_NODE;
-        int result = astro_core_calc_planet(node, datetime, flags, &positions[count]);
-        if (result == ASTRO_OK) {
-            count++;
-        }
+        bodies[nbodies++] = g_config.use_true_node ? ASTRO_TRUE_NODE : ASTRO_MEAN_NODE;
     }
 
     /* Add Lilith if configured */
     if (g_config.include_lilith) {
-        int result = astro_core_calc_planet(ASTRO_MEAN_APOGEE, datetime, flags, &positions[count]);
-        if (result == ASTRO_OK) {
-            count++;
-        }
+        bodies[nbodies++] = ASTRO_MEAN_APOGEE;
+    }
+
+    /* All bodies in one call, so that the work common to the epoch
+     * (delta T, nutation, Earth and Sun) is done only once */
+    double jd = astro_core_get_julian_day(datetime);
+    swe_calc_all_ut(jd, bodies, nbodies, flags | SEFLG_SPEED, xx, retflags, serr);
+
+    for (int i = 0; i < nbodies; i++) {
+        if (retflags[i] < 0) continue;
+        fill_planet_position((AstroPlanet) bodies[i], xx + 6 * i, &positions[count]);
+        count++;
     }
 
     *num_planets = count;
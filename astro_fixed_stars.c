@@ -0,0 +1,803 @@
+/**
+ * @file astro_fixed_stars.c
+ * @brief Fixed star positions, conjunctions and mythology
+ *
+ * Positions come from sefstars.txt via the Swiss Ephemeris. Conjunction
+ * searches use a FixedStarIndex, the stars sorted by longitude for one
+ * epoch, so that every chart point costs a range lookup instead of a
+ * scan of all stars.
+ */
+
+#include "astro_fixed_stars.h"
+#include "astro_core.h"
+#include "swephexp.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <math.h>
+
+/* ========================================================================
+ * Fixed Star Database
+ * ======================================================================== */
+
+static const FixedStarData g_fixed_stars[FIXED_STAR_COUNT] = {
+    /* Royal Stars */
+    {FIXED_STAR_ALDEBARAN, "Aldebaran", "Eye of the Bull", "Taurus",
+     69.79, -5.47, 0.86,
+     "Watcher of the East, the follower of the Pleiades. Honour gained "
+     "through integrity, lost through corruption.",
+     {"integrity", "honour", "courage", "success", "eloquence", "ambition"},
+     "Mars", 1, 0, 1},
+    {FIXED_STAR_REGULUS, "Regulus", "Heart of the Lion", "Leo",
+     149.83, 0.46, 1.40,
+     "Watcher of the North, the little king. Great success, as long as "
+     "revenge is avoided.",
+     {"royalty", "leadership", "fame", "power", "magnanimity", "pride"},
+     "Mars-Jupiter", 1, 0, 1},
+    {FIXED_STAR_ANTARES, "Antares", "Heart of the Scorpion", "Scorpio",
+     249.75, -4.57, 0.91,
+     "Watcher of the West, the rival of Mars. Intensity and obsession, "
+     "success through facing one's own extremes.",
+     {"intensity", "obsession", "courage", "recklessness", "strategy", "passion"},
+     "Mars-Jupiter", 1, 1, 0},
+    {FIXED_STAR_FOMALHAUT, "Fomalhaut", "Mouth of the Fish", "Piscis Austrinus",
+     333.85, -21.14, 1.16,
+     "Watcher of the South. Idealism and vision that must stay pure to "
+     "bring lasting fame.",
+     {"idealism", "vision", "mysticism", "art", "purity", "fame"},
+     "Venus-Mercury", 1, 0, 1},
+
+    /* First Magnitude Stars */
+    {FIXED_STAR_SIRIUS, "Sirius", "Dog Star", "Canis Major",
+     104.09, -39.61, -1.46,
+     "The scorching one, whose heliacal rising announced the flood of the "
+     "Nile. Ambition, fame and the burning of the sacred fire.",
+     {"ambition", "fame", "devotion", "guardianship", "heat", "renown"},
+     "Jupiter-Mars", 0, 0, 1},
+    {FIXED_STAR_CANOPUS, "Canopus", "Pilot of the Argo", "Carina",
+     104.98, -75.82, -0.74,
+     "Named after the helmsman of Menelaus; the star that guides voyages "
+     "across unknown waters.",
+     {"navigation", "voyage", "education", "guidance", "travel", "piety"},
+     "Saturn-Jupiter", 0, 0, 1},
+    {FIXED_STAR_ARCTURUS, "Arcturus", "Bear Guardian", "Bootes",
+     204.23, 30.73, -0.05,
+     "The herdsman who drives the bears around the pole. Pathfinding and "
+     "prosperity through new methods.",
+     {"pioneering", "prosperity", "guidance", "independence", "honour", "ingenuity"},
+     "Mars-Jupiter", 0, 0, 1},
+    {FIXED_STAR_VEGA, "Vega", "Falling Vulture", "Lyra",
+     285.30, 61.73, 0.03,
+     "The lyre of Orpheus, whose music moved stones and the lords of the "
+     "underworld. Charisma and artistic gifts.",
+     {"music", "charisma", "art", "magic", "refinement", "idealism"},
+     "Venus-Mercury", 0, 0, 1},
+    {FIXED_STAR_CAPELLA, "Capella", "Little She-Goat", "Auriga",
+     81.86, 22.86, 0.08,
+     "Amalthea, the goat that nursed the infant Zeus. Curiosity, learning "
+     "and independence.",
+     {"curiosity", "learning", "nurture", "independence", "honour", "wealth"},
+     "Mars-Mercury", 0, 0, 1},
+    {FIXED_STAR_RIGEL, "Rigel", "Foot of Orion", "Orion",
+     76.83, -31.12, 0.13,
+     "The foot of the giant hunter. Teaching, skill and lasting renown "
+     "through work with others.",
+     {"teaching", "skill", "inventiveness", "renown", "mechanics", "education"},
+     "Jupiter-Mars", 0, 0, 1},
+    {FIXED_STAR_PROCYON, "Procyon", "Little Dog", "Canis Minor",
+     115.79, -16.02, 0.37,
+     "The one before the dog, rising ahead of Sirius. Quick success that "
+     "may be short-lived.",
+     {"haste", "activity", "opportunity", "violence", "sudden", "fortune"},
+     "Mercury-Mars", 0, 1, 0},
+    {FIXED_STAR_BETELGEUSE, "Betelgeuse", "Shoulder of Orion", "Orion",
+     88.76, -16.03, 0.42,
+     "The armpit of the giant, a red supergiant. Martial honour and "
+     "success without complications.",
+     {"success", "honour", "fortune", "martial", "wealth", "achievement"},
+     "Mars-Mercury", 0, 0, 1},
+    {FIXED_STAR_ALTAIR, "Altair", "Flying Eagle", "Aquila",
+     301.77, 29.30, 0.76,
+     "The eagle that carried the thunderbolts of Zeus. Boldness, "
+     "confidence and sudden rise.",
+     {"boldness", "ambition", "confidence", "courage", "liberality", "rise"},
+     "Mars-Jupiter", 0, 0, 1},
+    {FIXED_STAR_SPICA, "Spica", "Wheat Shaft", "Virgo",
+     203.84, -2.05, 0.97,
+     "The ear of wheat in the hand of the Virgin. Gifts, talents and "
+     "protection, the brilliance of the harvest.",
+     {"gifts", "talent", "harvest", "protection", "success", "brilliance"},
+     "Venus-Mars", 0, 0, 1},
+    {FIXED_STAR_POLLUX, "Pollux", "Immortal Twin", "Gemini",
+     113.22, 6.68, 1.14,
+     "The immortal twin, a boxer, who shared his immortality with his "
+     "brother. Courage with a cruel edge.",
+     {"courage", "boxing", "cruelty", "subtlety", "boldness", "sacrifice"},
+     "Mars", 0, 1, 0},
+    {FIXED_STAR_DENEB, "Deneb", "Swan's Tail", "Cygnus",
+     335.32, 59.91, 1.25,
+     "The tail of the swan in which Zeus visited Leda. Ingenuity and a "
+     "clever, quick mind.",
+     {"ingenuity", "intelligence", "learning", "art", "quickness", "versatility"},
+     "Venus-Mercury", 0, 0, 1},
+
+    /* Mythologically Significant */
+    {FIXED_STAR_ALGOL, "Algol", "Demon Star", "Perseus",
+     56.17, 22.43, 2.12,
+     "The head of Medusa held by Perseus. Intense, raw power and the "
+     "rage that turns to stone.",
+     {"intensity", "rage", "passion", "loss", "power", "feminine"},
+     "Saturn-Jupiter", 0, 1, 0},
+    {FIXED_STAR_ALCYONE, "Alcyone", "Central Pleiades Star", "Taurus",
+     59.99, 4.05, 2.87,
+     "The brightest of the Seven Sisters, daughters of Atlas and Pleione. "
+     "Vision, and sorrow borne with dignity.",
+     {"vision", "mysticism", "sorrow", "judgement", "ambition", "sisterhood"},
+     "Moon-Mars", 0, 1, 0},
+    {FIXED_STAR_PLEIONE, "Pleione", "Mother of the Pleiades", "Taurus",
+     60.38, 4.00, 5.09,
+     "The ocean nymph, mother of the Seven Sisters, pursued with them by "
+     "Orion.",
+     {"motherhood", "grief", "protection", "pursuit", "loss", "care"},
+     "Moon-Mars", 0, 0, 0},
+    {FIXED_STAR_ALCOR, "Alcor", "Rider", "Ursa Major",
+     165.87, 56.55, 4.01,
+     "The faint companion of Mizar, used since antiquity as a test of "
+     "eyesight.",
+     {"perception", "testing", "vision", "subtlety", "companionship", "acuity"},
+     "Venus-Moon", 0, 0, 0},
+    {FIXED_STAR_MIZAR, "Mizar", "Horse's Waist", "Ursa Major",
+     165.70, 56.37, 2.27,
+     "The middle star of the handle of the Great Bear, paired with its "
+     "rider Alcor.",
+     {"artistry", "business", "ambition", "partnership", "endurance", "craft"},
+     "Mars", 0, 0, 0},
+    {FIXED_STAR_POLARIS, "Polaris", "North Star", "Ursa Minor",
+     88.58, 66.10, 2.02,
+     "The pole star around which the heavens turn. Orientation, direction "
+     "and steadfastness.",
+     {"direction", "orientation", "steadfastness", "spirituality", "guidance", "focus"},
+     "Saturn-Venus", 0, 0, 1},
+    {FIXED_STAR_ALPHERATZ, "Alpheratz", "Andromeda's Head", "Andromeda",
+     14.31, 25.68, 2.06,
+     "The head of the chained princess, shared with the horse Pegasus. "
+     "Freedom and independence.",
+     {"freedom", "independence", "movement", "honour", "speed", "riches"},
+     "Jupiter-Venus", 0, 0, 1},
+    {FIXED_STAR_SCHEAT, "Scheat", "Fortunate", "Pegasus",
+     359.37, 31.14, 2.42,
+     "The leg of the winged horse. Independent thinking, and misfortune "
+     "through water or rashness.",
+     {"intellect", "independence", "misfortune", "drowning", "rashness", "originality"},
+     "Mars-Mercury", 0, 1, 0},
+    {FIXED_STAR_MARKAB, "Markab", "Saddle of Pegasus", "Pegasus",
+     353.48, 19.41, 2.48,
+     "The saddle of the winged horse. Honour and danger from fire, cuts "
+     "and fevers.",
+     {"honour", "riches", "danger", "fire", "steadiness", "ambition"},
+     "Mars-Mercury", 0, 1, 0},
+    {FIXED_STAR_DENEB_ALGEDI, "Deneb Algedi", "Goat's Tail", "Capricornus",
+     323.53, -2.60, 2.83,
+     "The tail of the sea-goat, Pan who leapt into the Nile. Justice, "
+     "law and sorrow.",
+     {"justice", "law", "sorrow", "wisdom", "integrity", "beneficence"},
+     "Saturn-Jupiter", 0, 0, 1},
+    {FIXED_STAR_ACHERNAR, "Achernar", "River's End", "Eridanus",
+     345.30, -59.38, 0.46,
+     "The mouth of the river Eridanus, into which Phaethon fell. Success "
+     "in public office and religion.",
+     {"success", "office", "religion", "crisis", "endings", "benefit"},
+     "Jupiter", 0, 0, 1},
+    {FIXED_STAR_HAMAL, "Hamal", "Head of the Ram", "Aries",
+     37.66, 9.97, 2.01,
+     "The head of the golden ram whose fleece Jason sought. Independence "
+     "and headstrong force.",
+     {"independence", "force", "stubbornness", "violence", "drive", "quest"},
+     "Mars-Saturn", 0, 1, 0},
+    {FIXED_STAR_MENKAR, "Menkar", "Whale's Jaw", "Cetus",
+     44.32, -12.59, 2.53,
+     "The jaw of the sea monster sent against Andromeda. The collective "
+     "unconscious and its burdens.",
+     {"collective", "burden", "illness", "inheritance", "disgrace", "depth"},
+     "Saturn", 0, 1, 0},
+    {FIXED_STAR_CASTOR, "Castor", "Mortal Twin", "Gemini",
+     110.24, 10.10, 1.58,
+     "The mortal twin, a horseman, whose death was shared by his brother. "
+     "Intellect and writing, with sudden loss.",
+     {"intellect", "writing", "travel", "loss", "brotherhood", "fame"},
+     "Mercury", 0, 0, 0},
+    {FIXED_STAR_ALNILAM, "Alnilam", "Orion's Belt Center", "Orion",
+     83.47, -24.51, 1.69,
+     "The string of pearls in the belt of the giant. Fleeting public "
+     "honour.",
+     {"honour", "fame", "publicity", "brevity", "belt", "pearls"},
+     "Jupiter-Saturn", 0, 0, 0},
+    {FIXED_STAR_ALNITAK, "Alnitak", "Orion's Belt", "Orion",
+     84.68, -25.29, 1.79,
+     "The girdle of the giant hunter. Distinction and good fortune.",
+     {"distinction", "fortune", "belt", "hunter", "honour", "strength"},
+     "Mercury-Saturn", 0, 0, 0},
+    {FIXED_STAR_MINTAKA, "Mintaka", "Orion's Belt", "Orion",
+     82.36, -23.55, 2.41,
+     "The western star of the belt, the first to rise. Good fortune.",
+     {"fortune", "belt", "hunter", "rise", "honour", "stability"},
+     "Saturn-Mercury", 0, 0, 0},
+
+    /* Galactic Center */
+    {FIXED_STAR_GALACTIC_CENTER, "Galactic Center", "Center of Milky Way", "Sagittarius",
+     266.84, -5.61, 999.99,
+     "The center of the Milky Way, around which the galaxy turns. The "
+     "source, cosmic purpose and higher awareness.",
+     {"source", "purpose", "awareness", "origin", "spirit", "information"},
+     "Jupiter", 0, 0, 0},
+};
+
+/* Precession in longitude per Julian year, for the fallback position */
+#define PRECESSION_PER_YEAR (50.29 / 3600.0)
+
+/* ========================================================================
+ * Helper Functions
+ * ======================================================================== */
+
+/* Longitude of a star and its place in the unsorted arrays */
+typedef struct {
+    double longitude;
+    int i;
+} StarOrder;
+
+static int compare_longitude(const void *a, const void *b) {
+    const StarOrder *sa = (const StarOrder *)a;
+    const StarOrder *sb = (const StarOrder *)b;
+    if (sa->longitude != sb->longitude) {
+        return sa->longitude < sb->longitude ? -1 : 1;
+    }
+    return sa->i - sb->i;
+}
+
+/**
+ * Fill an index from unsorted positions; the arrays of the index
+ * must hold n entries
+ */
+static int index_sort(FixedStarIndex *index, int n, const int *numbers,
+                      const double *lon, const double *lat, const double *mag) {
+    StarOrder *order = (StarOrder *)malloc((size_t)(n > 0 ? n : 1) * sizeof(StarOrder));
+    int i, k;
+
+    if (order == NULL) {
+        return ASTRO_ERROR_CALCULATION;
+    }
+    for (i = 0; i < n; i++) {
+        order[i].longitude = lon[i];
+        order[i].i = i;
+    }
+    qsort(order, (size_t)n, sizeof(StarOrder), compare_longitude);
+    for (i = 0; i < n; i++) {
+        index->star_number[i] = numbers[order[i].i];
+        index->longitude[i] = lon[order[i].i];
+        index->latitude[i] = lat[order[i].i];
+        index->magnitude[i] = mag[order[i].i];
+    }
+    free(order);
+
+    /* First star at or after every whole degree */
+    k = 0;
+    for (i = 0; i <= 360; i++) {
+        while (k < n && index->longitude[k] < i) {
+            k++;
+        }
+        index->first_in_degree[i] = k;
+    }
+    index->num_stars = n;
+    return ASTRO_OK;
+}
+
+static int index_alloc(FixedStarIndex *index, int n) {
+    memset(index, 0, sizeof(*index));
+    if (n < 1) n = 1;
+    index->star_number = (int *)malloc((size_t)n * sizeof(int));
+    index->longitude = (double *)malloc((size_t)n * 3 * sizeof(double));
+    if (index->star_number == NULL || index->longitude == NULL) {
+        astro_fixed_stars_index_free(index);
+        return ASTRO_ERROR_CALCULATION;
+    }
+    index->latitude = index->longitude + n;
+    index->magnitude = index->longitude + 2 * n;
+    return ASTRO_OK;
+}
+
+/**
+ * Append the stars with lo <= longitude <= hi, lo and hi within 0..360
+ */
+static void index_range(const FixedStarIndex *index, double lo, double hi,
+                        int matches[], int max_matches, int *count) {
+    int k = index->first_in_degree[(int)lo];
+
+    while (k < index->num_stars && index->longitude[k] < lo) {
+        k++;
+    }
+    while (k < index->num_stars && index->longitude[k] <= hi && *count < max_matches) {
+        matches[(*count)++] = k++;
+    }
+}
+
+/**
+ * Position of a major star for a Julian day (UT)
+ */
+static void star_position(const FixedStarData *data, double jd,
+                          double *longitude, double *latitude) {
+    double xx[6];
+    char star[SE_MAX_STNAME * 2];
+    char serr[256];
+
+    strncpy(star, data->name, sizeof(star) - 1);
+    star[sizeof(star) - 1] = '\0';
+    if (swe_fixstar2_ut(star, jd, SEFLG_SWIEPH, xx, serr) < 0) {
+        /* Without sefstars.txt, precess the longitude of 2000 */
+        *longitude = astro_core_normalize_angle(data->longitude_2000 +
+                     (jd - 2451545.0) / 365.25 * PRECESSION_PER_YEAR);
+        *latitude = data->latitude;
+        return;
+    }
+
+    *longitude = xx[0];
+    *latitude = xx[1];
+}
+
+/**
+ * Index of the major stars for a Julian day; free it with
+ * astro_fixed_stars_index_free()
+ */
+static int major_index(double jd, FixedStarIndex *index) {
+    int numbers[FIXED_STAR_COUNT];
+    double lon[FIXED_STAR_COUNT], lat[FIXED_STAR_COUNT], mag[FIXED_STAR_COUNT];
+
+    if (index_alloc(index, FIXED_STAR_COUNT) != ASTRO_OK) {
+        return ASTRO_ERROR_CALCULATION;
+    }
+    for (int i = 0; i < FIXED_STAR_COUNT; i++) {
+        numbers[i] = g_fixed_stars[i].id;
+        mag[i] = g_fixed_stars[i].magnitude;
+        star_position(&g_fixed_stars[i], jd, &lon[i], &lat[i]);
+    }
+    if (index_sort(index, FIXED_STAR_COUNT, numbers, lon, lat, mag) != ASTRO_OK) {
+        astro_fixed_stars_index_free(index);
+        return ASTRO_ERROR_CALCULATION;
+    }
+    index->julian_day = jd;
+    return ASTRO_OK;
+}
+
+/* ========================================================================
+ * Core Data Functions
+ * ======================================================================== */
+
+const FixedStarData* astro_fixed_stars_get_data(FixedStarID star_id) {
+    if (star_id < 0 || star_id >= FIXED_STAR_COUNT) {
+        return NULL;
+    }
+    return &g_fixed_stars[star_id];
+}
+
+int astro_fixed_stars_get_by_name(const char *name) {
+    if (name == NULL) {
+        return -1;
+    }
+
+    for (int i = 0; i < FIXED_STAR_COUNT; i++) {
+        if (strcasecmp(g_fixed_stars[i].name, name) == 0 ||
+            strcasecmp(g_fixed_stars[i].traditional_name, name) == 0) {
+            return g_fixed_stars[i].id;
+        }
+    }
+
+    return -1;
+}
+
+/* ========================================================================
+ * Position Calculation Functions
+ * ======================================================================== */
+
+int astro_fixed_stars_calc_position(FixedStarID star_id,
+                                   const AstroDateTime *datetime,
+                                   double *longitude,
+                                   double *latitude) {
+    if (datetime == NULL || longitude == NULL || latitude == NULL) {
+        return ASTRO_ERROR_NULL_POINTER;
+    }
+
+    const FixedStarData *data = astro_fixed_stars_get_data(star_id);
+    if (data == NULL) {
+        return ASTRO_ERROR_INVALID_PLANET;
+    }
+
+    star_position(data, astro_core_get_julian_day(datetime), longitude, latitude);
+    return ASTRO_OK;
+}
+
+int astro_fixed_stars_calc_all_positions(const AstroDateTime *datetime,
+                                        double positions[][2],
+                                        int max_stars,
+                                        int *num_stars) {
+    if (datetime == NULL || positions == NULL || num_stars == NULL) {
+        return ASTRO_ERROR_NULL_POINTER;
+    }
+
+    int count = 0;
+
+    for (int i = 0; i < FIXED_STAR_COUNT && count < max_stars; i++) {
+        int result = astro_fixed_stars_calc_position(g_fixed_stars[i].id, datetime,
+                                                     &positions[count][0],
+                                                     &positions[count][1]);
+        if (result != ASTRO_OK) {
+            return result;
+        }
+        count++;
+    }
+
+    *num_stars = count;
+    return ASTRO_OK;
+}
+
+/* ========================================================================
+ * Longitude Index
+ * ======================================================================== */
+
+int astro_fixed_stars_index_build(const AstroDateTime *datetime,
+                                  double max_magnitude,
+                                  FixedStarIndex *index) {
+    if (datetime == NULL || index == NULL) {
+        return ASTRO_ERROR_NULL_POINTER;
+    }
+
+    double jd = astro_core_get_julian_day(datetime);
+    char serr[256];
+    int32 n = 0, nmax = 0;
+    int32 *numbers = NULL;
+    double *xx = NULL, *lon = NULL;
+    int result = ASTRO_OK;
+
+    memset(index, 0, sizeof(*index));
+
+    /* The catalog is returned by magnitude; grow the arrays until all
+     * stars up to max_magnitude fit */
+    do {
+        nmax = nmax == 0 ? 2048 : nmax * 2;
+        free(numbers);
+        free(xx);
+        free(lon);
+        numbers = (int32 *)malloc((size_t)nmax * sizeof(int32));
+        xx = (double *)malloc((size_t)nmax * 6 * sizeof(double));
+        /* longitudes, latitudes and magnitudes */
+        lon = (double *)malloc((size_t)nmax * 3 * sizeof(double));
+        if (numbers == NULL || xx == NULL || lon == NULL) {
+            result = ASTRO_ERROR_CALCULATION;
+            goto done;
+        }
+        if (swe_fixstar2_catalog_ut(jd, SEFLG_SWIEPH, max_magnitude, nmax,
+                                    numbers, xx, lon + 2 * nmax, &n, serr) < 0) {
+            result = ASTRO_ERROR_EPHEMERIS_FILE;
+            goto done;
+        }
+    } while (n == nmax);
+
+    if (index_alloc(index, n) != ASTRO_OK) {
+        result = ASTRO_ERROR_CALCULATION;
+        goto done;
+    }
+    for (int i = 0; i < n; i++) {
+        lon[i] = xx[6 * i];
+        lon[nmax + i] = xx[6 * i + 1];
+    }
+    if (index_sort(index, n, numbers, lon, lon + nmax, lon + 2 * nmax) != ASTRO_OK) {
+        astro_fixed_stars_index_free(index);
+        result = ASTRO_ERROR_CALCULATION;
+        goto done;
+    }
+    index->julian_day = jd;
+
+done:
+    free(numbers);
+    free(xx);
+    free(lon);
+    return result;
+}
+
+int astro_fixed_stars_index_query(const FixedStarIndex *index,
+                                  double longitude,
+                                  double orb,
+                                  int matches[],
+                                  int max_matches,
+                                  int *num_matches) {
+    if (index == NULL || matches == NULL || num_matches == NULL) {
+        return ASTRO_ERROR_NULL_POINTER;
+    }
+
+    int count = 0;
+
+    longitude = astro_core_normalize_angle(longitude);
+    if (orb >= 180.0) {
+        index_range(index, 0.0, 360.0, matches, max_matches, &count);
+    } else if (longitude - orb < 0.0) {
+        /* The orb reaches back over 0° */
+        index_range(index, longitude - orb + 360.0, 360.0, matches, max_matches, &count);
+        index_range(index, 0.0, longitude + orb, matches, max_matches, &count);
+    } else if (longitude + orb >= 360.0) {
+        /* The orb reaches forward over 360° */
+        index_range(index, longitude - orb, 360.0, matches, max_matches, &count);
+        index_range(index, 0.0, longitude + orb - 360.0, matches, max_matches, &count);
+    } else {
+        index_range(index, longitude - orb, longitude + orb, matches, max_matches, &count);
+    }
+
+    *num_matches = count;
+    return ASTRO_OK;
+}
+
+void astro_fixed_stars_index_free(FixedStarIndex *index) {
+    if (index == NULL) {
+        return;
+    }
+    free(index->star_number);
+    free(index->longitude);
+    memset(index, 0, sizeof(*index));
+}
+
+/* ========================================================================
+ * Conjunction Functions
+ * ======================================================================== */
+
+int astro_fixed_stars_find_conjunctions(const AstroChart *chart,
+                                       double orb,
+                                       FixedStarConjunction conjunctions[],
+                                       int max_conjunctions,
+                                       int *num_conjunctions) {
+    if (chart == NULL || conjunctions == NULL || num_conjunctions == NULL) {
+        return ASTRO_ERROR_NULL_POINTER;
+    }
+
+    FixedStarIndex index;
+    if (major_index(astro_core_get_julian_day(&chart->birth_time), &index) != ASTRO_OK) {
+        return ASTRO_ERROR_CALCULATION;
+    }
+
+    int count = 0;
+    int matches[FIXED_STAR_COUNT];
+    int num_matches;
+
+    /* One range lookup per natal planet */
+    for (int p = 0; p < chart->num_planets && count < max_conjunctions; p++) {
+        astro_fixed_stars_index_query(&index, chart->planets[p].longitude, orb,
+                                      matches, FIXED_STAR_COUNT, &num_matches);
+        for (int m = 0; m < num_matches && count < max_conjunctions; m++) {
+            const FixedStarData *data = &g_fixed_stars[index.star_number[matches[m]]];
+            double diff = astro_core_angular_distance(index.longitude[matches[m]],
+                                                      chart->planets[p].longitude);
+
+            conjunctions[count].star_id = data->id;
+            conjunctions[count].star_name = data->name;
+            conjunctions[count].planet = chart->planets[p].planet;
+            conjunctions[count].planet_name = chart->planets[p].name;
+            conjunctions[count].orb = diff;
+            conjunctions[count].is_exact = (diff <= 1.0) ? 1 : 0;
+            conjunctions[count].interpretation = data->mythology;
+            count++;
+        }
+    }
+    astro_fixed_stars_index_free(&index);
+
+    *num_conjunctions = count;
+    return ASTRO_OK;
+}
+
+int astro_fixed_stars_find_at_degree(double longitude,
+                                    const AstroDateTime *datetime,
+                                    double orb,
+                                    FixedStarID *star_id) {
+    if (datetime == NULL || star_id == NULL) {
+        return 0;
+    }
+
+    FixedStarIndex index;
+    if (major_index(astro_core_get_julian_day(datetime), &index) != ASTRO_OK) {
+        return 0;
+    }
+
+    int matches[FIXED_STAR_COUNT];
+    int num_matches;
+    double best = -1.0;
+
+    astro_fixed_stars_index_query(&index, longitude, orb, matches, FIXED_STAR_COUNT, &num_matches);
+
+    /* Closest star within the orb */
+    for (int m = 0; m < num_matches; m++) {
+        double diff = astro_core_angular_distance(index.longitude[matches[m]], longitude);
+        if (best < 0.0 || diff < best) {
+            best = diff;
+            *star_id = (FixedStarID)index.star_number[matches[m]];
+        }
+    }
+    astro_fixed_stars_index_free(&index);
+
+    return best >= 0.0 ? 1 : 0;
+}
+
+int astro_fixed_stars_find_royal_stars(const AstroChart *chart,
+                                       double orb,
+                                       FixedStarConjunction conjunctions[],
+                                       int max_conjunctions,
+                                       int *num_conjunctions) {
+    if (chart == NULL || conjunctions == NULL || num_conjunctions == NULL) {
+        return ASTRO_ERROR_NULL_POINTER;
+    }
+
+    FixedStarConjunction all[FIXED_STAR_COUNT * ASTRO_MAX_PLANETS];
+    int num_all;
+    int result = astro_fixed_stars_find_conjunctions(chart, orb, all,
+                                                     FIXED_STAR_COUNT * ASTRO_MAX_PLANETS,
+                                                     &num_all);
+    if (result != ASTRO_OK) {
+        return result;
+    }
+
+    int count = 0;
+
+    for (int i = 0; i < num_all && count < max_conjunctions; i++) {
+        if (g_fixed_stars[all[i].star_id].is_royal_star) {
+            conjunctions[count++] = all[i];
+        }
+    }
+
+    *num_conjunctions = count;
+    return ASTRO_OK;
+}
+
+int astro_fixed_stars_is_on_galactic_center(double longitude,
+                                            const AstroDateTime *datetime,
+                                            double orb) {
+    double gc_lon, gc_lat;
+
+    if (datetime == NULL ||
+        astro_fixed_stars_calc_position(FIXED_STAR_GALACTIC_CENTER, datetime,
+                                        &gc_lon, &gc_lat) != ASTRO_OK) {
+        return 0;
+    }
+
+    return astro_core_angular_distance(gc_lon, longitude) <= orb ? 1 : 0;
+}
+
+int astro_fixed_stars_find_pleiades(const AstroChart *chart,
+                                   double orb,
+                                   int *has_conjunction,
+                                   AstroPlanet *planet) {
+    if (chart == NULL || has_conjunction == NULL || planet == NULL) {
+        return ASTRO_ERROR_NULL_POINTER;
+    }
+
+    FixedStarConjunction all[FIXED_STAR_COUNT * ASTRO_MAX_PLANETS];
+    int num_all;
+    int result = astro_fixed_stars_find_conjunctions(chart, orb, all,
+                                                     FIXED_STAR_COUNT * ASTRO_MAX_PLANETS,
+                                                     &num_all);
+    if (result != ASTRO_OK) {
+        return result;
+    }
+
+    double best = -1.0;
+
+    *has_conjunction = 0;
+    for (int i = 0; i < num_all; i++) {
+        if ((all[i].star_id == FIXED_STAR_ALCYONE || all[i].star_id == FIXED_STAR_PLEIONE) &&
+            (best < 0.0 || all[i].orb < best)) {
+            best = all[i].orb;
+            *has_conjunction = 1;
+            *planet = all[i].planet;
+        }
+    }
+
+    return ASTRO_OK;
+}
+
+/* ========================================================================
+ * Interpretation Functions
+ * ======================================================================== */
+
+char* astro_fixed_stars_interpret_conjunction(FixedStarID star_id,
+                                              AstroPlanet planet,
+                                              char *buffer,
+                                              int buffer_size) {
+    if (buffer == NULL || buffer_size <= 0) {
+        return NULL;
+    }
+
+    const FixedStarData *data = astro_fixed_stars_get_data(star_id);
+    if (data == NULL) {
+        snprintf(buffer, buffer_size, "Unknown star");
+        return buffer;
+    }
+
+    snprintf(buffer, buffer_size,
+            "%s (%s, %s) conjunct %s:\n\n"
+            "%s\n\n"
+            "Nature: %s\n"
+            "Keywords: %s, %s, %s",
+            data->name,
+            data->traditional_name,
+            data->constellation,
+            astro_core_get_planet_name(planet),
+            data->mythology,
+            data->nature,
+            data->keywords[0],
+            data->keywords[1],
+            data->keywords[2]);
+
+    return buffer;
+}
+
+/* ========================================================================
+ * Output Functions
+ * ======================================================================== */
+
+char* astro_fixed_stars_format_conjunction(const FixedStarConjunction *conjunction,
+                                          char *buffer,
+                                          int buffer_size) {
+    if (conjunction == NULL || buffer == NULL || buffer_size <= 0) {
+        return NULL;
+    }
+
+    snprintf(buffer, buffer_size, "%s conjunct %s (orb %.2f°)%s",
+            conjunction->planet_name,
+            conjunction->star_name,
+            conjunction->orb,
+            conjunction->is_exact ? " - exact" : "");
+
+    return buffer;
+}
+
+void astro_fixed_stars_print_conjunctions(const FixedStarConjunction conjunctions[],
+                                         int num_conjunctions,
+                                         FILE *fp) {
+    char buffer[256];
+
+    if (conjunctions == NULL || fp == NULL) {
+        return;
+    }
+
+    for (int i = 0; i < num_conjunctions; i++) {
+        fprintf(fp, "  %s\n",
+                astro_fixed_stars_format_conjunction(&conjunctions[i], buffer, sizeof(buffer)));
+    }
+}
+
+int astro_fixed_stars_print_report(const AstroChart *chart, double orb, FILE *fp) {
+    if (chart == NULL || fp == NULL) {
+        return ASTRO_ERROR_NULL_POINTER;
+    }
+
+    FixedStarConjunction conjunctions[FIXED_STAR_COUNT * ASTRO_MAX_PLANETS];
+    int num_conjunctions;
+    int result = astro_fixed_stars_find_conjunctions(chart, orb, conjunctions,
+                                                     FIXED_STAR_COUNT * ASTRO_MAX_PLANETS,
+                                                     &num_conjunctions);
+    if (result != ASTRO_OK) {
+        return result;
+    }
+
+    fprintf(fp, "\n");
+    fprintf(fp, "═══════════════════════════════════════════════════════════════\n");
+    fprintf(fp, "  FIXED STARS REPORT\n");
+    fprintf(fp, "═══════════════════════════════════════════════════════════════\n\n");
+
+    if (num_conjunctions == 0) {
+        fprintf(fp, "  No fixed star conjunctions within %.1f°\n", orb);
+        return ASTRO_OK;
+    }
+
+    astro_fixed_stars_print_conjunctions(conjunctions, num_conjunctions, fp);
+    for (int i = 0; i < num_conjunctions; i++) {
+        const FixedStarData *data = astro_fixed_stars_get_data(conjunctions[i].star_id);
+        fprintf(fp, "\n%s (%s): %s\n", data->name, data->nature, data->mythology);
+    }
+
+    return ASTRO_OK;
+}
@@ -101,6 +101,24 @@ typedef struct {
     const char *interpretation;  /* Brief interpretation */
 } FixedStarConjunction;
 
+/**
+ * Fixed star positions for one epoch, indexed by ecliptic longitude
+ *
+ * The stars are sorted by longitude, and first_in_degree[] gives the
+ * first star at or after each whole degree, so that the stars within
+ * an orb of a point are found with a range lookup instead of a scan.
+ */
+typedef struct {
+    double julian_day;          /* Epoch (UT) of the positions */
+    int num_stars;
+    int *star_number;           /* Sequential number in sefstars.txt,
+                                   or FixedStarID for the major stars */
+    double *longitude;          /* Ecliptic longitude, ascending */
+    double *latitude;
+    double *magnitude;
+    int first_in_degree[361];   /* [360] = num_stars */
+} FixedStarIndex;
+
 /* ========================================================================
  * Functions
  * ======================================================================== */
@@ -157,6 +175,45 @@ int astro_fixed_stars_find_at_degree(double longitude,
                                     double orb,
                                     FixedStarID *star_id);
 
+/**
+ * Build a longitude index of all stars of sefstars.txt for a date
+ *
+ * @param datetime Date for calculation
+ * @param max_magnitude Faintest magnitude to include
+ * @param index Index to fill; free it with astro_fixed_stars_index_free()
+ * @return ASTRO_OK on success, error code otherwise
+ */
+int astro_fixed_stars_index_build(const AstroDateTime *datetime,
+                                  double max_magnitude,
+                                  FixedStarIndex *index);
+
+/**
+ * Find the stars of an index within an orb of a longitude
+ *
+ * Handles the wraparound at 0°/360°.
+ *
+ * @param index Index built for the epoch of interest
+ * @param longitude Ecliptic longitude
+ * @param orb Maximum orb
+ * @param matches Array to store positions in the index arrays
+ * @param max_matches Maximum matches to find
+ * @param num_matches Pointer to store count
+ * @return ASTRO_OK on success, error code otherwise
+ */
+int astro_fixed_stars_index_query(const FixedStarIndex *index,
+                                  double longitude,
+                                  double orb,
+                                  int matches[],
+                                  int max_matches,
+                                  int *num_matches);
+
+/**
+ * Free the arrays of an index
+ *
+ * @param index Index to free
+ */
+void astro_fixed_stars_index_free(FixedStarIndex *index);
+
 /**
  * Calculate current position of all major fixed stars
  *
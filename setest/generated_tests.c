@@ -0,0 +1,2988 @@
+/* Automatically generated file - do not change manually */
+/* Create or change source files named suite_*.c         */
+/* Generate this file using "make"                       */
+
+// This source file (i.e. globals_suite.c) contains utility functions for writing test case code
+
+#include "testsuite_final.h"
+#include "sweph.h"
+
+void check_swecalc_results(int rc,double *xx, char* serr, test_context* ctx) {
+  check_dd(xx,6,"xx",ctx);
+  check_i(rc,"rc",ctx);
+  check_s(serr,"serr",ctx);
+}
+
+void check_swehouses_results(int rc, double jd_ut, int ihsy, double *cusps, double *ascmc, char* serr, test_context* ctx) {
+  check_d(jd_ut,"jd_ut",ctx);
+  if (ihsy == 'G') {
+    check_dd(cusps,37,"cusps",ctx);
+  } else {
+    check_dd(cusps,13,"cusps",ctx);
+  }
+  check_dd(ascmc,6,"ascmc",ctx);	// 6 = do not test coasc2, 8 = all 
+  check_i(rc,"rc",ctx);
+}
+
+void check_swehouses_ex2_results(int rc, double jd_ut, int ihsy, double *cusps, double *ascmc, double *cusp_speed, double *ascmc_speed, char* serr, test_context* ctx) {
+  check_d(jd_ut,"jd_ut",ctx);
+  if (ihsy == 'G') {
+    check_dd(cusps,37,"cusps",ctx);
+    check_dd(cusp_speed,37,"cusp_speed",ctx);
+  } else {
+    check_dd(cusps,13,"cusps",ctx);
+    check_dd(cusp_speed,13,"cusp_speed",ctx);
+  }
+  check_dd(ascmc,6,"ascmc",ctx);	// 6 = do not test coasc2, 8 = all 
+  check_dd(ascmc_speed,6,"ascmc_speed",ctx);	// 6 = do not test coasc2, 8 = all 
+  check_i(rc,"rc",ctx);
+}
+
+void check_swehouses_armc_results(int rc, double armc, int ihsy, double *cusps, double *ascmc, char* serr, test_context* ctx) {
+  check_d(armc,"armc",ctx);
+  if (ihsy == 'G') {
+    check_dd(cusps,37,"cusps",ctx);
+  } else {
+    check_dd(cusps,13,"cusps",ctx);
+  }
+  check_dd(ascmc,6,"ascmc",ctx);	// 6 = do not test coasc2, 8 = all 
+  check_i(rc,"rc",ctx);
+}
+
+void check_swehouses_armc_ex2_results(int rc, double armc, int ihsy, double *cusps, double *ascmc, double *cusp_speed, double *ascmc_speed, char* serr, test_context* ctx) {
+  check_d(armc,"armc",ctx);
+  if (ihsy == 'G') {
+    check_dd(cusps,37,"cusps",ctx);
+    check_dd(cusp_speed,37,"cusp_speed",ctx);
+  } else {
+    check_dd(cusps,13,"cusps",ctx);
+    check_dd(cusp_speed,13,"cusp_speed",ctx);
+  }
+  check_dd(ascmc,6,"ascmc",ctx);	// 6 = do not test coasc2, 8 = all 
+  check_dd(ascmc_speed,6,"ascmc_speed",ctx);	// 6 = do not test coasc2, 8 = all 
+  check_i(rc,"rc",ctx);
+}
+
+// Writes an eclipse catalog for ephemeris iephe, 20 years before and after
+// jd, into a new temporary directory and puts this directory first into the
+// ephemeris path. Undo with close_test_eclipse_catalog().
+static char ecl_dir[40], ecl_env[AS_MAXCH];
+static int ecl_has_env;
+
+int open_test_eclipse_catalog(double jd, int32 iephe, char *serr) {
+  char path[2 * AS_MAXCH], fn[AS_MAXCH], *sp = getenv("SE_EPHE_PATH");
+  ecl_has_env = (sp != NULL);
+  if (sp != NULL)
+    snprintf(ecl_env, AS_MAXCH, "%s", sp);
+  strcpy(ecl_dir, "/tmp/setestXXXXXX");
+  if (mkdtemp(ecl_dir) == NULL) {
+    strcpy(serr, "could not create a temporary directory");
+    *ecl_dir = '\0';
+    return ERR;
+  }
+  snprintf(path, sizeof(path), "%s%c%s", ecl_dir, *PATH_SEPARATOR,
+           sp != NULL && *sp != '\0' ? ecl_env : SE_EPHE_PATH);
+  setenv("SE_EPHE_PATH", path, 1);
+  swe_set_ephe_path(NULL);
+  return swi_write_eclipse_catalog(jd - 7305, jd + 7305, iephe, fn, serr);
+}
+
+void close_test_eclipse_catalog(void) {
+  char fn[AS_MAXCH];
+  swi_close_eclipse_catalog();
+  if (*ecl_dir != '\0') {
+    snprintf(fn, AS_MAXCH, "%s/%s", ecl_dir, SE_ECLFILE);
+    remove(fn);
+    rmdir(ecl_dir);
+    *ecl_dir = '\0';
+  }
+  if (ecl_has_env)
+    setenv("SE_EPHE_PATH", ecl_env, 1);
+  else
+    unsetenv("SE_EPHE_PATH");
+  swe_set_ephe_path(NULL);
+}
+
+// Number of eclipses tret[0][0..n-1] that the mapped eclipse catalog
+// for iephe covers, i.e. that swe_*_eclipse_when*_cat() take from it
+// instead of the live search
+int eclipses_in_test_catalog(double *tret0, int n, int32 iephe) {
+  struct efile_header *ehp = (struct efile_header *) swed.eclcat.mptr;
+  int i, k = 0;
+  if (ehp == NULL || ehp->epheflag != iephe)
+    return 0;
+  for (i = 0; i < n; i++) {
+    if (tret0[i] > ehp->tstart && tret0[i] <= ehp->tend)
+      k++;
+  }
+  return k;
+}
+
+// End of source file globals_suite.c
+
+#include "testsuite_final.h"
+
+
+
+void testsuite_1(test_context *ctx) {
+
+double xx[6],jd;
+int iflag, iephe; // Keep ephemeris selector separate from other flags
+char serr[255];
+
+swe_set_ephe_path(NULL);
+swe_set_jpl_file("de431.eph");
+
+void testcase_1_1(test_context *ctx) {
+  int rc = swe_calc(jd, get_i("ipl",ctx), iflag | iephe, xx, serr);
+  check_swecalc_results(rc,xx,serr,ctx);
+  }
+
+void testcase_1_2(test_context *ctx) {
+  int ipl = get_i("ipl",ctx); 
+swe_set_ephe_path(NULL);
+  int rc = swe_calc_ut(jd, ipl, iflag | iephe, xx, serr);
+  check_swecalc_results(rc,xx,serr,ctx);
+  }
+
+void testcase_1_3(test_context *ctx) {
+  double geolon = get_d("geolon",ctx),
+         geolat = get_d("geolat",ctx),
+         altitude = get_d("altitude",ctx);
+swe_set_ephe_path(NULL);
+  int ipl = get_i("ipl",ctx);
+  swe_set_topo( geolon, geolat, altitude );
+  int rc = swe_calc(jd, ipl, iflag | iephe, xx, serr);
+  check_swecalc_results(rc,xx,serr,ctx);
+}
+
+void testcase_1_4(test_context *ctx) {
+  iflag = SEFLG_EQUATORIAL | iephe;
+  int ipl = get_i("ipl",ctx);
+swe_set_ephe_path(NULL);
+  swe_calc(jd, ipl, iflag, xx, serr);
+  iflag =  iephe;
+  int rc = swe_calc(jd, ipl, iflag, xx, serr);
+  check_equals_i(rc,iflag,"rc",ctx); // we expect rc = iflag = iephe
+  }
+
+void testcase_1_5(test_context *ctx) {
+  int rc = swe_calc_pctr(jd, get_i("ipl",ctx), get_i("iplctr",ctx), iflag | iephe, xx, serr);
+  check_swecalc_results(rc,xx,serr,ctx);
+  }
+
+void testcase_1_6(test_context *ctx) {
+  /* 2000 epochs 0.37 days apart, with and without the fits; 
+   * maximum difference in arcsec */
+  static double x0[2000][2];
+  int i, k, ipl = get_i("ipl",ctx);
+  double d, dmax = 0;
+  for (k = 0; k < 2; k++) {
+    swe_set_analytical_cache(k == 0 ? 0 : 0.001);
+    for (i = 0; i < 2000; i++) {
+      swe_calc(jd + i * 0.37, ipl, SEFLG_MOSEPH, xx, serr);
+      if (k == 0) {
+        x0[i][0] = xx[0];
+        x0[i][1] = xx[1];
+        continue;
+      }
+      d = fabs(swe_difdeg2n(xx[0], x0[i][0])) * 3600;
+      if (d > dmax) dmax = d;
+      d = fabs(xx[1] - x0[i][1]) * 3600;
+      if (d > dmax) dmax = d;
+    }
+  }
+  swe_set_analytical_cache(0);
+  check_equals_d(dmax,0,"dmax",ctx);
+  }
+
+void testcase_1_7(test_context *ctx) {
+  /* 500 epochs 7.3 days apart in one call, against swe_calc() with 
+   * the same frame; maximum difference of position (AU) and speed 
+   * (AU/day) */
+  static double tjd[500], xb[500 * 6];
+  int i, k, ipl = get_i("ipl",ctx), rc;
+  int32 iflgb = get_i("iflag",ctx) | SEFLG_SPEED;
+  int32 iflgc = iflgb | SEFLG_MOSEPH | SEFLG_J2000 | SEFLG_XYZ | SEFLG_TRUEPOS;
+  double d, dmax = 0;
+  if (ipl != SE_MOON)
+    iflgc |= SEFLG_HELCTR;
+  for (i = 0; i < 500; i++)
+    tjd[i] = jd + i * 7.3;
+  rc = swe_moshier_batch(ipl, tjd, 500, iflgb, xb, serr);
+  check_equals_i(rc & (SEFLG_EQUATORIAL | SEFLG_ICRS),iflgb & (SEFLG_EQUATORIAL | SEFLG_ICRS),"rc & (SEFLG_EQUATORIAL | SEFLG_ICRS)",ctx);
+  for (i = 0; i < 500; i++) {
+    swe_calc(tjd[i], ipl, iflgc, xx, serr);
+    for (k = 0; k < 6; k++) {
+      d = fabs(xx[k] - xb[6 * i + k]);
+      if (d > dmax) dmax = d;
+    }
+  }
+  check_equals_d(dmax,0,"dmax",ctx);
+  }
+
+void testcase_1_8(test_context *ctx) {
+  /* epochs in days from jd, which is the origin of the segment grid,
+   * in an order that revisits cached segments on both sides of it;
+   * maximum difference in arcsec */
+  static const double dt[] = {-20, 5, -20, -40, -10, 30, -40, -5, -36, 5};
+  double x0[10][2];
+  int i, ipl = get_i("ipl",ctx);
+  double d, dmax = 0;
+  swe_set_analytical_cache(0);
+  for (i = 0; i < 10; i++) {
+    swe_calc(jd + dt[i], ipl, SEFLG_MOSEPH, xx, serr);
+    x0[i][0] = xx[0];
+    x0[i][1] = xx[1];
+  }
+  swe_set_analytical_cache(0.001);
+  for (i = 0; i < 10; i++) {
+    swe_calc(jd + dt[i], ipl, SEFLG_MOSEPH, xx, serr);
+    d = fabs(swe_difdeg2n(xx[0], x0[i][0])) * 3600;
+    if (d > dmax) dmax = d;
+    d = fabs(xx[1] - x0[i][1]) * 3600;
+    if (d > dmax) dmax = d;
+  }
+  swe_set_analytical_cache(0);
+  check_equals_d(dmax,0,"dmax",ctx);
+  }
+
+void testcase_1_9(test_context *ctx) {
+  /* the moons computed in turn with npool files kept open, against 
+   * the files opened for each call; maximum difference and flags */
+  static const int ipl[] = {9606, 9801, 9607, 9901, 9608, 9704, 9902};
+  double x0[3][7][6];
+  int i, j, k, m, pass, rc, rc0[7];
+  double d, dmax = 0;
+  swe_set_asteroid_pool(0);
+  for (j = 0; j < 3; j++) {
+    for (i = 0; i < 7; i++)
+      rc0[i] = swe_calc(jd + j * 0.7, ipl[i], iephe | SEFLG_SPEED, x0[j][i], serr);
+  }
+  swe_set_asteroid_pool(get_i("npool",ctx));
+  check_equals_i(swe_get_asteroid_pool(),get_i("npool",ctx),"swe_get_asteroid_pool()",ctx);
+  /* forward, then backward, so that the pool is reused and refilled */
+  for (pass = 0; pass < 2; pass++) {
+    for (j = 0; j < 3; j++) {
+      for (k = 0; k < 7; k++) {
+        i = (pass == 0) ? k : 6 - k;
+        rc = swe_calc(jd + j * 0.7, ipl[i], iephe | SEFLG_SPEED, xx, serr);
+        check_equals_i(rc,rc0[i],"rc",ctx);
+        for (m = 0; m < 6; m++) {
+          d = fabs(xx[m] - x0[j][i][m]);
+          if (d > dmax) dmax = d;
+        }
+      }
+    }
+  }
+  swe_set_asteroid_pool(0);
+  check_equals_d(dmax,0,"dmax",ctx);
+  }
+
+void testcase_1_10(test_context *ctx) {
+  /* 200 epochs in mixed order, some of them twice, in one call, 
+   * against swe_calc() or swe_calc_ut() for each epoch; maximum 
+   * difference and flags */
+  static double tjd[200], xb[200 * 6];
+  int32 iflgb[200], iflgc = iflag | iephe;
+  int i, k, ipl = get_i("ipl",ctx), ut = get_i("ut",ctx), rc;
+  double d, dmax = 0;
+  for (i = 0; i < 200; i++)
+    tjd[i] = jd + ((i * 37) % 200) * 0.61;
+  for (i = 0; i < 200; i += 40)
+    tjd[i + 1] = tjd[i];
+  if (ut)
+    rc = swe_calc_batch_ut(ipl, tjd, 200, iflgc, xb, iflgb, serr);
+  else
+    rc = swe_calc_batch(ipl, tjd, 200, iflgc, xb, iflgb, serr);
+  for (i = 0; i < 200; i++) {
+    if (ut)
+      rc = swe_calc_ut(tjd[i], ipl, iflgc, xx, serr);
+    else
+      rc = swe_calc(tjd[i], ipl, iflgc, xx, serr);
+    check_equals_i(iflgb[i],rc,"iflgb[i]",ctx);
+    for (k = 0; k < 6; k++) {
+      d = fabs(xx[k] - xb[6 * i + k]);
+      if (d > dmax) dmax = d;
+    }
+  }
+  check_equals_d(dmax,0,"dmax",ctx);
+  }
+
+void testcase_1_11(test_context *ctx) {
+  /* 300 bodies, i.e. more than one block, every 37th of them not on an 
+   * elliptic orbit, against Kepler's equation solved for each body 
+   * with Newton's method; maximum difference in AU or degrees */
+  static const int32 iflags[] = {
+    SEFLG_HELCTR | SEFLG_J2000 | SEFLG_XYZ,
+    SEFLG_J2000 | SEFLG_XYZ,
+    SEFLG_HELCTR | SEFLG_J2000,
+  };
+  static double elem[300 * SE_KEPLER_NELEM], xb[300 * 3];
+  double *el, xearth[6], x[3], a, e, dmot, M, E, dE, xo, yo, d, dmax = 0;
+  double si, ci, so, co, sp, cp, lon;
+  int i, j, k, rc;
+  for (i = 0; i < 300; i++) {
+    el = elem + i * SE_KEPLER_NELEM;
+    el[0] = 2460000.5;
+    el[1] = 1.5 + 0.011 * i;
+    el[2] = fmod(i * 0.137, 0.95);
+    el[3] = fmod(i * 7.3, 40);
+    el[4] = fmod(i * 97.1, 360);
+    el[5] = fmod(i * 211.7, 360);
+    el[6] = fmod(i * 53.9, 360);
+    el[7] = (i % 2) ? 0 : 0.9856076686 / el[1] / sqrt(el[1]);
+    if (i % 37 == 5)
+      el[2] = 1.2;
+    if (i % 37 == 20)
+      el[1] = -1;
+  }
+  rc = swe_calc(jd, SE_EARTH, iephe | SEFLG_HELCTR | SEFLG_J2000 | SEFLG_XYZ | SEFLG_TRUEPOS | SEFLG_NONUT, xearth, serr);
+  for (j = 0; j < 3; j++) {
+    rc = swe_kepler_batch(jd, 300, elem, iephe | iflags[j], xb, serr);
+    check_equals_i(rc & ~(SEFLG_JPLEPH | SEFLG_SWIEPH | SEFLG_MOSEPH),iflags[j],"rc & ~(SEFLG_JPLEPH | SEFLG_SWIEPH | SEFLG_MOSEPH)",ctx);
+    for (i = 0; i < 300; i++) {
+      el = elem + i * SE_KEPLER_NELEM;
+      a = el[1];
+      e = el[2];
+      if (a <= 0 || e >= 1) {
+        x[0] = x[1] = x[2] = 0;
+      } else {
+        dmot = el[7] != 0 ? el[7] : 0.9856076686 / a / sqrt(a);
+        M = fmod(el[6] + (jd - el[0]) * dmot, 360);
+        if (M < 0) M += 360;
+        M *= M_PI / 180;
+        E = (e < 0.8) ? M : M_PI;
+        for (k = 0; k < 100; k++) {
+          dE = (M + e * sin(E) - E) / (1 - e * cos(E));
+          E += dE;
+          if (fabs(dE) < 1e-15) break;
+        }
+        xo = a * (cos(E) - e);
+        yo = a * sqrt(1 - e * e) * sin(E);
+        si = sin(el[3] * M_PI / 180); ci = cos(el[3] * M_PI / 180);
+        so = sin(el[4] * M_PI / 180); co = cos(el[4] * M_PI / 180);
+        sp = sin(el[5] * M_PI / 180); cp = cos(el[5] * M_PI / 180);
+        x[0] = (cp * co - sp * ci * so) * xo + (-sp * co - cp * ci * so) * yo;
+        x[1] = (cp * so + sp * ci * co) * xo + (-sp * so + cp * ci * co) * yo;
+        x[2] = sp * si * xo + cp * si * yo;
+        if (!(iflags[j] & SEFLG_HELCTR)) {
+          for (k = 0; k < 3; k++)
+            x[k] -= xearth[k];
+        }
+        if (!(iflags[j] & SEFLG_XYZ)) {
+          d = sqrt(x[0] * x[0] + x[1] * x[1] + x[2] * x[2]);
+          lon = swe_degnorm(atan2(x[1], x[0]) * 180 / M_PI);
+          x[1] = asin(x[2] / d) * 180 / M_PI;
+          x[0] = lon;
+          x[2] = d;
+        }
+      }
+      for (k = 0; k < 3; k++) {
+        d = fabs(xb[3 * i + k] - x[k]);
+        if (k == 0 && !(iflags[j] & SEFLG_XYZ))
+          d = fabs(swe_difdeg2n(xb[3 * i + k], x[k]));
+        if (d > dmax) dmax = d;
+      }
+    }
+  }
+  check_equals_d(dmax,0,"dmax",ctx);
+  }
+
+void setup_1() {
+  iflag = get_i("iflag",ctx);
+  iephe = get_i("iephe",ctx);
+  jd = get_d("jd",ctx);
+  *serr = '\0';
+  }
+
+void teardown_1() {
+  if (get_i("initialize",ctx)) swe_close( );
+  }
+
+
+  open_testsuite(1,"Various swe_calc calls in different modes",ctx);
+
+
+  if (is_testcase_selected( 1, ctx)) { 
+    open_testcase(1,"swe_calc( ) - Julian Date with Ephemeris Time",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_1();
+        testcase_1_1(ctx);
+        teardown_1();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 2, ctx)) { 
+    open_testcase(2,"swe_calc_ut( ) - Julian Date with Universal Time",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_1();
+        testcase_1_2(ctx);
+        teardown_1();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 3, ctx)) { 
+    open_testcase(3,"swe_set_topo( ) - Using topographic coordinates",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_1();
+        testcase_1_3(ctx);
+        teardown_1();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 4, ctx)) { 
+    open_testcase(4,"swe_calc( ) - Equatorial followed by Ecliptic",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_1();
+        testcase_1_4(ctx);
+        teardown_1();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 5, ctx)) { 
+    open_testcase(5,"swe_calc_pctr( ) - planetocentic position",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_1();
+        testcase_1_5(ctx);
+        teardown_1();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 6, ctx)) { 
+    open_testcase(6,"swe_set_analytical_cache( ) - fitted Moshier theories",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_1();
+        testcase_1_6(ctx);
+        teardown_1();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 7, ctx)) { 
+    open_testcase(7,"swe_moshier_batch( ) - against swe_calc( )",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_1();
+        testcase_1_7(ctx);
+        teardown_1();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 8, ctx)) { 
+    open_testcase(8,"swe_set_analytical_cache( ) - segments before and after the grid origin",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_1();
+        testcase_1_8(ctx);
+        teardown_1();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 9, ctx)) { 
+    open_testcase(9,"swe_set_asteroid_pool( ) - planetary moons in alternation",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_1();
+        testcase_1_9(ctx);
+        teardown_1();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 10, ctx)) { 
+    open_testcase(10,"swe_calc_batch( ) - against swe_calc( )",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_1();
+        testcase_1_10(ctx);
+        teardown_1();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 11, ctx)) { 
+    open_testcase(11,"swe_kepler_batch( ) - against a scalar solution",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_1();
+        testcase_1_11(ctx);
+        teardown_1();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+}
+#include "testsuite_final.h"
+
+
+void testsuite_2(test_context *ctx) {
+
+double xx[6],jd;
+int rc, iflag, ipl;
+char serr[255], star[100];
+
+// swe_fixstar doesn't read env.var. SE_EPHE_PATH
+// swe_calc does. So for this suite, we have to read it explicitly
+swe_set_ephe_path(NULL);
+
+
+void testcase_2_1(test_context *ctx) {
+
+  jd = get_d("jd",ctx);
+  iflag = get_i("iflag",ctx);
+  strcpy(star,get_s("star",ctx));
+
+  rc = swe_fixstar(star,jd,iflag,xx,serr);
+
+  check_swecalc_results(rc,xx,serr,ctx);
+
+  }
+
+void testcase_2_2(test_context *ctx) {
+
+  jd = get_d("jd",ctx);
+  strcpy(star,get_s("star",ctx));
+
+  rc = swe_fixstar_ut(star,jd,iflag,xx,serr);
+
+  check_swecalc_results(rc,xx,serr,ctx);
+
+  }
+
+void testcase_2_3(test_context *ctx) {
+  double mag;
+
+  strcpy(star,get_s("star",ctx));
+  rc = swe_fixstar_mag(star,&mag,serr);
+
+  check_d(mag,"mag",ctx);
+  check_i(rc,"rc",ctx);
+  check_s(serr,"serr",ctx); 
+
+  }
+
+void testcase_2_4(test_context *ctx) {
+  swe_set_ephe_path(NULL);
+  jd = get_d("jd",ctx);
+  ipl = 2;
+  strcpy(star,get_s("star",ctx));
+  rc = swe_calc(jd, ipl, iflag, xx, serr);
+  rc = swe_fixstar(star,jd,iflag,xx,serr);
+
+  check_swecalc_results(rc,xx,serr,ctx);
+
+  }
+
+void testcase_2_5(test_context *ctx) {
+  swe_set_ephe_path(NULL);
+  jd = get_d("jd",ctx);
+  ipl = 2;
+  strcpy(star, "Algol");
+  rc = swe_fixstar(star,jd,iflag,xx,serr);
+  strcpy(star,get_s("star",ctx));
+  rc = swe_fixstar(star,jd,iflag,xx,serr);
+
+  check_swecalc_results(rc,xx,serr,ctx);
+
+  }
+
+void testcase_2_6(test_context *ctx) {
+
+  swe_set_ephe_path(NULL);
+  jd = get_d("jd",ctx);
+  iflag = get_i("iflag",ctx);
+  strcpy(star,get_s("star",ctx));
+
+  rc = swe_fixstar2(star,jd,iflag,xx,serr);
+
+  check_swecalc_results(rc,xx,serr,ctx);
+
+  }
+
+void testcase_2_7(test_context *ctx) {
+
+  swe_set_ephe_path(NULL);
+  jd = get_d("jd",ctx);
+  strcpy(star,get_s("star",ctx));
+
+  rc = swe_fixstar2_ut(star,jd,iflag,xx,serr);
+
+  check_swecalc_results(rc,xx,serr,ctx);
+
+  }
+
+void testcase_2_8(test_context *ctx) {
+  /* all stars of sefstars.txt up to magnitude 2.5, for each of the flags
+   * below; return flags, and maximum difference of magnitude, position
+   * and speed in the units of the flags, distances relative to the 
+   * distance of the star */
+  static const int32 iflags[] = {
+    SEFLG_SPEED,
+    SEFLG_SPEED | SEFLG_HELCTR,
+    SEFLG_SPEED | SEFLG_BARYCTR,
+    SEFLG_SPEED | SEFLG_TRUEPOS,
+    SEFLG_SPEED | SEFLG_EQUATORIAL | SEFLG_XYZ,
+    SEFLG_SPEED | SEFLG_SIDEREAL,
+    SEFLG_NOABERR | SEFLG_NOGDEFL,
+  };
+  static int32 istar[200];
+  static double xc[200 * 6], magc[200];
+  int32 i, j, k, n, rc2;
+  double d, r, mag, dmax = 0;
+  swe_set_ephe_path(NULL);
+  jd = get_d("jd",ctx);
+  for (j = 0; j < (int32) (sizeof(iflags) / sizeof(iflags[0])); j++) {
+    iflag = iflags[j];
+    rc = swe_fixstar2_catalog(jd, iflag, 2.5, 200, istar, xc, magc, &n, serr);
+    check_equals_i(n > 0,1,"n > 0",ctx);
+    for (i = 0; i < n; i++) {
+      sprintf(star, "%d", istar[i]);
+      rc2 = swe_fixstar2(star, jd, iflag, xx, serr);
+      check_equals_i(rc,rc2,"rc",ctx);
+      swe_fixstar2_mag(star, &mag, serr);
+      if (fabs(mag - magc[i]) > dmax) dmax = fabs(mag - magc[i]);
+      r = (iflag & SEFLG_XYZ) ? sqrt(xx[0] * xx[0] + xx[1] * xx[1] + xx[2] * xx[2]) : xx[2];
+      for (k = 0; k < 6; k++) {
+        d = xx[k] - xc[6 * i + k];
+        if (k == 0 && !(iflag & SEFLG_XYZ))
+          d = swe_difdeg2n(xx[k], xc[6 * i + k]);
+        if ((iflag & SEFLG_XYZ) || k == 2 || k == 5)
+          d /= r;
+        if (fabs(d) > dmax) dmax = fabs(d);
+      }
+    }
+  }
+  check_equals_d(dmax,0,"dmax",ctx);
+  }
+
+
+  open_testsuite(2,"Fixed stars",ctx);
+
+
+  if (is_testcase_selected( 1, ctx)) { 
+    open_testcase(1,"Fixed stars with Ephemeris Time",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        
+        testcase_2_1(ctx);
+        
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 2, ctx)) { 
+    open_testcase(2,"Fixed stars with Universal Time",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        
+        testcase_2_2(ctx);
+        
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 3, ctx)) { 
+    open_testcase(3,"Magnitude of a fixed star",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        
+        testcase_2_3(ctx);
+        
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 4, ctx)) { 
+    open_testcase(4,"Mercury, then Betelgeuze",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        
+        testcase_2_4(ctx);
+        
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 5, ctx)) { 
+    open_testcase(5,"Algol, then Betelgeuze",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        
+        testcase_2_5(ctx);
+        
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 6, ctx)) { 
+    open_testcase(6,"Fixed stars (swe_fixstar2) with Ephemeris Time",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        
+        testcase_2_6(ctx);
+        
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 7, ctx)) { 
+    open_testcase(7,"Fixed stars (swe_fixstar2) with Universal Time",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        
+        testcase_2_7(ctx);
+        
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 8, ctx)) { 
+    open_testcase(8,"swe_fixstar2_catalog( ) - against swe_fixstar2( )",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        
+        testcase_2_8(ctx);
+        
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+}
+#include "testsuite_final.h"
+
+
+void testsuite_3(test_context *ctx) {
+
+void testcase_3_1(test_context *ctx) {
+  int ipl = get_i("ipl",ctx);
+  char name[255];
+  swe_get_planet_name(ipl,name);
+  check_s(name,"name",ctx);
+}
+
+void testcase_3_2(test_context *ctx) {
+  int sid_mode = get_i("sid_mode",ctx);
+  const char *name = swe_get_ayanamsa_name(sid_mode);
+  check_s(name,"name",ctx);
+}
+
+void testcase_3_3(test_context *ctx) {
+  /* 2000 epochs 3.7 years apart, nutation of model nmodel with the 
+   * SIMD series, then again with the scalar series; maximum difference 
+   * in microarcsec of each against the scalar series computed first */
+  static double tjd[2000], dpsi0[2000], deps0[2000], dpsi[2000], deps[2000];
+  int i, k;
+  double d, dmax = 0, dmax_scalar = 0;
+  char smod[30], serr[255];
+  sprintf(smod, "0,0,0,%d,0,0,0,0", get_i("nmodel",ctx));
+  swe_set_astro_models(smod, 0);
+  for (i = 0; i < 2000; i++)
+    tjd[i] = 2451545.0 + (i - 1000 + 0.37) * 3.7 * 365.25;
+  swe_nutation_batch(tjd, 2000, 0, dpsi0, deps0, serr);
+  for (k = 0; k < 2; k++) {
+    swe_set_nutation_simd(k == 0);
+    swe_nutation_batch(tjd, 2000, 0, dpsi, deps, serr);
+    for (i = 0; i < 2000; i++) {
+      d = fabs(dpsi[i] - dpsi0[i]) * 3600e6;
+      if (fabs(deps[i] - deps0[i]) * 3600e6 > d)
+        d = fabs(deps[i] - deps0[i]) * 3600e6;
+      if (k == 0 && d > dmax) dmax = d;
+      if (k == 1 && d > dmax_scalar) dmax_scalar = d;
+    }
+  }
+  swe_set_astro_models("", 0);
+  check_equals_d(dmax,0,"dmax",ctx);
+  check_equals_d(dmax_scalar,0,"dmax_scalar",ctx);
+}
+
+void testcase_3_4(test_context *ctx) {
+  /* 2000 epochs spread over a table of 1990 - 2010 with nodes step days 
+   * apart; nutation and mean obliquity of swe_calc( ) with SE_ECL_NUT 
+   * against the series of model nmodel. The maximum errors in mas must 
+   * be within the bounds stated at swe_set_nutation_table( ) */
+  static double tjd[2000], dpsi0[2000], deps0[2000], eps0[2000];
+  int i, rc, dpsi_in_bound, deps_in_bound, eps_in_bound;
+  double x[6], d, dpsimax = 0, depsmax = 0, epsmax = 0, bound;
+  double tstart = 2447892.5, tend = 2455197.5, step = get_d("step",ctx);
+  char smod[30], serr[255];
+  sprintf(smod, "0,0,0,%d,0,0,0,0", get_i("nmodel",ctx));
+  swe_set_astro_models(smod, 0);
+  if (step >= 2)
+    bound = 4;
+  else if (step >= 1)
+    bound = 0.13;
+  else if (step >= 0.5)
+    bound = 0.006;
+  else
+    bound = 0.0003;
+  for (i = 0; i < 2000; i++) {
+    tjd[i] = tstart + (tend - tstart) * fmod((i + 1) * 0.618033988749895, 1);
+    swe_calc(tjd[i], SE_ECL_NUT, 0, x, serr);
+    eps0[i] = x[1];
+  }
+  swe_nutation_batch(tjd, 2000, 0, dpsi0, deps0, serr);
+  rc = swe_set_nutation_table(tstart, tend, step, 0, serr);
+  check_equals_i(rc,OK,"rc",ctx);
+  for (i = 0; i < 2000; i++) {
+    swe_calc(tjd[i], SE_ECL_NUT, 0, x, serr);
+    d = fabs(x[2] - dpsi0[i]) * 3600e3;
+    if (d > dpsimax) dpsimax = d;
+    d = fabs(x[3] - deps0[i]) * 3600e3;
+    if (d > depsmax) depsmax = d;
+    d = fabs(x[1] - eps0[i]) * 3600e3;
+    if (d > epsmax) epsmax = d;
+  }
+  swe_set_nutation_table(0, 0, 0, 0, serr);
+  swe_set_astro_models("", 0);
+  dpsi_in_bound = (dpsimax <= bound);
+  deps_in_bound = (depsmax <= bound);
+  eps_in_bound = (epsmax <= 1e-7);
+  check_equals_i(dpsi_in_bound,1,"dpsi_in_bound",ctx);
+  check_equals_i(deps_in_bound,1,"deps_in_bound",ctx);
+  check_equals_i(eps_in_bound,1,"eps_in_bound",ctx);
+}
+
+void testcase_3_5(test_context *ctx) {
+  /* equatorial position vectors of the Sun of date, without nutation, 
+   * at 2000 epochs spread over -1000 - 2900 with precession model pmodel;
+   * maximum difference between interpolated and exact precession 
+   * matrices in mas, relative to the length of the vector, for tstep 
+   * 1, 10 and 100 days. It must be within 1.2e-5 mas * tstep * tstep, 
+   * as stated at swe_set_prec_interpolation( ) */
+  static double tjd[2000], x0[2000][3];
+  static const double tsteps[3] = {1, 10, 100};
+  int i, k, j, rc, in_bound = 1;
+  double x[6], d, r, dmax, tstep;
+  double tstart = 1355807.5, tend = 2780263.5;
+  int32 iflag = SEFLG_MOSEPH | SEFLG_EQUATORIAL | SEFLG_NONUT | SEFLG_XYZ;
+  char smod[30], serr[255];
+  sprintf(smod, "0,%d,%d,0,0,0,0,0", get_i("pmodel",ctx), get_i("pmodel",ctx));
+  swe_set_astro_models(smod, 0);
+  swe_set_prec_interpolation(0);
+  for (i = 0; i < 2000; i++) {
+    tjd[i] = tstart + (tend - tstart) * fmod((i + 1) * 0.618033988749895, 1);
+    rc = swe_calc(tjd[i], SE_SUN, iflag, x, serr);
+    for (j = 0; j < 3; j++)
+      x0[i][j] = x[j];
+  }
+  for (k = 0; k < 3; k++) {
+    tstep = tsteps[k];
+    swe_set_prec_interpolation(tstep);
+    dmax = 0;
+    for (i = 0; i < 2000; i++) {
+      swe_calc(tjd[i], SE_SUN, iflag, x, serr);
+      d = r = 0;
+      for (j = 0; j < 3; j++) {
+        d += (x[j] - x0[i][j]) * (x[j] - x0[i][j]);
+        r += x0[i][j] * x0[i][j];
+      }
+      d = sqrt(d / r) * RADTODEG * 3600e3;
+      if (d > dmax) dmax = d;
+    }
+    if (dmax > 1.2e-5 * tstep * tstep)
+      in_bound = 0;
+  }
+  swe_set_prec_interpolation(0);
+  swe_set_astro_models("", 0);
+  check_equals_i(rc,iflag,"rc",ctx);
+  check_equals_i(in_bound,1,"in_bound",ctx);
+}
+
+
+  open_testsuite(3,"Various small functions (names et al.)",ctx);
+
+
+  if (is_testcase_selected( 1, ctx)) { 
+    open_testcase(1,"swe_get_planet_name( ) - Getting a planet name",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        
+        testcase_3_1(ctx);
+        
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 2, ctx)) { 
+    open_testcase(2,"swe_get_aya_name( ) - Getting an ayanamsa name",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        
+        testcase_3_2(ctx);
+        
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 3, ctx)) { 
+    open_testcase(3,"swe_set_nutation_simd( ) - against the scalar series",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        
+        testcase_3_3(ctx);
+        
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 4, ctx)) { 
+    open_testcase(4,"swe_set_nutation_table( ) - against the series",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        
+        testcase_3_4(ctx);
+        
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 5, ctx)) { 
+    open_testcase(5,"swe_set_prec_interpolation( ) - against exact precession",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        
+        testcase_3_5(ctx);
+        
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+}
+
+
+
+
+#include "testsuite_final.h"
+
+void testsuite_4(test_context *ctx) {
+swe_set_ephe_path(NULL);
+
+    void set_sid_mode() {
+      double t0 = get_d("t0",ctx),
+             ayan_t0 = get_d("ayan_t0",ctx);
+      int    sid_mode = get_i("sid_mode",ctx);
+      swe_set_sid_mode(sid_mode,t0,ayan_t0);
+    }
+
+    void testcase_4_1(test_context *ctx) {
+
+    // Set specified sidereal mode
+       set_sid_mode( );
+
+    // swe_calc
+      double jd = get_d("jd",ctx);
+      int iflag = get_i("iflag",ctx);
+      int ipl = get_i("ipl",ctx);
+      double xx[6];
+      char serr[255];
+      //fprintf(stderr, "jd=%.17f, ipl=%d, iflag=%d, \n", jd, ipl, iflag);
+      int rc = swe_calc(jd,ipl,iflag,xx,serr);
+      //fprintf(stderr, "x0=%.17f, x3=%.17f\n", xx[0], xx[3]);
+      check_swecalc_results(rc,xx,serr,ctx);
+
+    }
+
+    void testcase_4_2(test_context *ctx) {
+
+      double daya_ex_ut,daya_ex;
+      char serr_ex_ut[255], serr_ex[255];
+      *serr_ex_ut = *serr_ex = '\0';
+
+      set_sid_mode( );
+
+      double jd = get_d("jd",ctx);
+      int iephe = get_i("iephe",ctx);
+
+    // swe_get_ayanamsa_ex_ut
+      int rc_aya_ex_ut = swe_get_ayanamsa_ex_ut(jd, iephe, &daya_ex_ut, serr_ex_ut);
+      check_i(rc_aya_ex_ut,"rc_aya_ex_ut",ctx);
+      check_d(daya_ex_ut,"daya_ex_ut",ctx);
+      check_s(serr_ex_ut,"serr_ex_ut",ctx);
+
+    // swe_get_ayanamsa_ex
+      int rc_aya_ex = swe_get_ayanamsa_ex(jd, iephe, &daya_ex, serr_ex);
+      check_i(rc_aya_ex,"rc_aya_ex",ctx);
+      check_d(daya_ex,"daya_ex",ctx);
+      check_s(serr_ex,"serr_ex",ctx);
+
+    }
+
+
+    void testcase_4_3(test_context *ctx) {
+
+      set_sid_mode( );
+
+      double jd = get_d("jd",ctx);
+
+    // swe_get_ayanamsa_ut
+      double daya_ut = swe_get_ayanamsa_ut(jd);
+      check_d(daya_ut,"daya_ut",ctx);
+
+    // swe_get_ayanamsa
+      double daya = swe_get_ayanamsa(jd);
+      check_d(daya,"daya",ctx);
+
+    }
+
+    void testcase_4_4(test_context *ctx) {
+
+      // Set sidereal mode as given in fixture file
+      set_sid_mode( );
+
+      // Get ayanamsa...
+      double jd = get_d("jd",ctx);
+      double daya = swe_get_ayanamsa_ut(jd);
+
+      // ... and check it
+      check_d(daya,"daya",ctx);
+
+
+    }
+
+
+
+
+  open_testsuite(4,"Some computations in sidereal mode",ctx);
+
+
+  if (is_testcase_selected( 1, ctx)) { 
+    open_testcase(1,"swe_set_aynamsa( ) - Calc planet using a specific Ayanamsa",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        
+        testcase_4_1(ctx);
+        
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 2, ctx)) { 
+    open_testcase(2,"swe_get_ayanamsa_ex and swe_get_ayanamsa_ex_ut",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        
+        testcase_4_2(ctx);
+        
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 3, ctx)) { 
+    open_testcase(3,"swe_get_aynamsa and swe_get_ayanamsa_ut",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        
+        testcase_4_3(ctx);
+        
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 4, ctx)) { 
+    open_testcase(4,"Initialization problem with swe_set_sid_mode",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        
+        testcase_4_4(ctx);
+        
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+}
+#include "testsuite_final.h"
+
+
+void testsuite_5(test_context *ctx) {
+
+  char serr[255];
+  int rc;
+swe_set_ephe_path(NULL);
+
+  void testcase_5_1(test_context *ctx) {
+    double jd = swe_julday(
+        get_i("year",ctx),
+        get_i("month",ctx),
+        get_i("day",ctx),
+        get_d("hour",ctx),
+        get_i("gregflag",ctx));
+    check_d(jd,"jd",ctx);
+  }
+
+  void testcase_5_2(test_context *ctx) {
+    int year,month,day;
+    double ut;
+    swe_revjul (get_d("jd",ctx), get_i("gregflag",ctx),
+           &year, &month, &day, &ut);
+    check_i(year,"year",ctx);
+    check_i(month,"month",ctx);
+    check_i(day,"day",ctx);
+    check_d(ut,"ut",ctx);
+  }
+
+  void testcase_5_3(test_context *ctx) {
+    double deltat;
+    int iephe = get_i("iephe",ctx);
+    double jd = get_d("jd",ctx);
+    if (iephe > 0) {
+//fprintf(stderr, "jd=%.11f, ie=%d\n", jd, iephe);
+      deltat = swe_deltat_ex(jd,iephe,serr);
+//fprintf(stderr, "dt=%.11f  s=%s\n", deltat, serr);
+      check_s(serr,"serr",ctx);
+    }
+    else {
+      deltat = swe_deltat(jd);
+    }
+    check_d(deltat,"deltat",ctx);
+  }
+
+  void testcase_5_4(test_context *ctx) {
+    double E;
+    int rc = swe_time_equ(get_d("jd",ctx), &E, serr);
+    check_d(E,"E",ctx);
+    check_i(rc,"rc",ctx);
+  }
+
+  void testcase_5_5(test_context *ctx) {
+    double tjd_lmt, tjd_lat, geolon;
+    tjd_lmt = get_d("tjd_lmt",ctx);
+    geolon = get_d("geolon",ctx);
+    rc = swe_lmt_to_lat(tjd_lmt,geolon,&tjd_lat,serr);
+    check_i(rc,"rc",ctx);
+    check_s(serr,"serr",ctx);
+    check_d(tjd_lat,"tjd_lat",ctx);
+  }
+
+  void testcase_5_6(test_context *ctx) {
+    double tjd_lmt, tjd_lat, geolon;
+    tjd_lat = get_d("tjd_lat",ctx);
+    geolon = get_d("geolon",ctx);
+    rc = swe_lat_to_lmt(tjd_lat,geolon,&tjd_lmt,serr);
+    check_i(rc,"rc",ctx);
+    check_s(serr,"serr",ctx);
+    check_d(tjd_lmt,"tjd_lmt",ctx);
+  }
+
+  void testcase_5_7(test_context *ctx) {
+    /* one epoch per year from -13000 to +17000, one per 10 days 
+     * from 1600 to 2100; maximum difference in seconds */
+    int i;
+    double tjd, dt0, dt1, d, dtmax = 0;
+    int iephe = get_i("iephe",ctx);
+    char smod[30];
+    sprintf(smod, "%d,9,9,4,3,0,0,4", get_i("dmodel",ctx));
+    swe_set_astro_models(smod, 0);
+    for (i = 0; i < 30000 + 18262; i++) {
+      if (i < 30000)
+        tjd = 2451545.0 + (i - 15000 + 0.37) * 365.25;
+      else
+        tjd = 2305447.5 + (i - 30000 + 0.37) * 10;
+      swe_set_deltat_table(TRUE);
+      dt1 = swe_deltat_ex(tjd, iephe, serr);
+      swe_set_deltat_table(FALSE);
+      dt0 = swe_deltat_ex(tjd, iephe, serr);
+      d = (dt1 - dt0) * 86400;
+      if (d < 0) d = -d;
+      if (d > dtmax) dtmax = d;
+    }
+    swe_set_deltat_table(FALSE);
+    swe_set_astro_models("", 0);
+    check_equals_d(dtmax,0,"dtmax",ctx);
+  }
+
+
+
+
+void setup_5() {
+    *serr = '\0';
+    rc = 0;
+  }
+
+  
+  open_testsuite(5,"Date and time functions",ctx);
+
+
+  if (is_testcase_selected( 1, ctx)) { 
+    open_testcase(1,"Julian Date from Calendar date",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_5();
+        testcase_5_1(ctx);
+        
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 2, ctx)) { 
+    open_testcase(2,"Calendar date from Julian Date",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_5();
+        testcase_5_2(ctx);
+        
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 3, ctx)) { 
+    open_testcase(3,"Delta T",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_5();
+        testcase_5_3(ctx);
+        
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 4, ctx)) { 
+    open_testcase(4,"Equation of time",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_5();
+        testcase_5_4(ctx);
+        
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 5, ctx)) { 
+    open_testcase(5,"Local Mean Time to Local Apparent Time",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_5();
+        testcase_5_5(ctx);
+        
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 6, ctx)) { 
+    open_testcase(6,"Local Apparent Time to Local Mean Time",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_5();
+        testcase_5_6(ctx);
+        
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 7, ctx)) { 
+    open_testcase(7,"Delta T tables against the model functions",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_5();
+        testcase_5_7(ctx);
+        
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+}
+#include "testsuite_final.h"
+
+
+void testsuite_6(test_context *ctx) {
+
+double cusps[37],ascmc[10], jd_ut, geolat, geolon, armc,xx[6];
+double cusp_speed[37], ascmc_speed[10];
+char serr[255], *sp;
+int rc, ihsy;
+swe_close();
+swe_set_ephe_path(NULL);
+
+void testcase_6_1(test_context *ctx) {
+  rc = swe_houses(jd_ut, geolat, geolon, ihsy, cusps, ascmc);
+  check_swehouses_results(rc,jd_ut,ihsy,cusps,ascmc,serr,ctx);
+  }
+void testcase_6_2(test_context *ctx) {
+  rc = swe_houses_ex(jd_ut, get_i("iflag",ctx), geolat, geolon, ihsy, cusps, ascmc);
+  check_swehouses_results(rc,jd_ut,ihsy,cusps,ascmc,serr,ctx);
+  }
+void testcase_6_3(test_context *ctx) {
+  swe_set_sid_mode(get_i("isid",ctx), 0, 0);
+  rc = swe_houses_ex(jd_ut, get_i("iflag",ctx), geolat, geolon, ihsy, cusps, ascmc);
+//if (ihsy == 'P') fprintf(stderr, " ==> %f\n", cusps[1]);
+  check_swehouses_results(rc,jd_ut,ihsy,cusps,ascmc,serr,ctx);
+  }
+void testcase_6_4(test_context *ctx) {
+  double eps;
+  rc = swe_calc(jd_ut, SE_ECL_NUT, 0, xx, serr);	// 
+  eps = xx[0];
+  armc = swe_degnorm(swe_sidtime(jd_ut) + geolon);
+  rc = swe_houses_armc(armc, geolat, eps, ihsy, cusps, ascmc);
+  check_swehouses_armc_results(rc,armc,ihsy,cusps,ascmc,serr,ctx);
+  }
+void testcase_6_5(test_context *ctx) {
+  sp = (char *) swe_house_name(ihsy);
+  check_s(sp,"sp",ctx);
+ }
+void testcase_6_6(test_context *ctx) {
+  double hp;
+  double eps;
+  // jd_ut loops through a day, 
+  rc = swe_calc(jd_ut, SE_ECL_NUT, 0, xx, serr);	// obliquity eps
+  eps = xx[0];
+  armc = swe_degnorm(swe_sidtime(jd_ut) * 15 + geolon);
+  rc = swe_calc(jd_ut, SE_SUN, 0, xx, serr);	// sun pos xx
+  hp = swe_house_pos(armc, geolat, eps, ihsy, xx, serr);
+  check_d(armc,"armc",ctx);	// to show
+  check_d(xx[0],"xx[0]",ctx);	// to show
+  check_d(hp,"hp",ctx);
+  }
+void testcase_6_7(test_context *ctx) {
+  // jd_ut loops through a day, 
+  int imeth = get_i("imeth",ctx);
+  double gp;
+  double geopos[3] = {geolon, geolat, 100};
+  rc = swe_gauquelin_sector(jd_ut, SE_SUN, NULL, 0, imeth, geopos, 0.0, 20.0, &gp, serr);	
+  check_d(jd_ut,"jd_ut",ctx);	// to show
+  check_d(gp,"gp",ctx);
+  check_i(rc,"rc",ctx);
+  check_s(serr,"serr",ctx);
+  }
+void testcase_6_8(test_context *ctx) {
+  rc = swe_houses_ex2(jd_ut, get_i("iflag",ctx), geolat, geolon, ihsy, cusps, ascmc, cusp_speed, ascmc_speed, serr);
+//if (ihsy == 'P') fprintf(stderr, " ==> %f\n", cusps[1]);
+  check_swehouses_ex2_results(rc,jd_ut,ihsy,cusps,ascmc,cusp_speed,ascmc_speed,serr,ctx);
+  }
+void testcase_6_9(test_context *ctx) {
+  double eps;
+  rc = swe_calc(jd_ut, SE_ECL_NUT, 0, xx, serr);	// 
+  eps = xx[0];
+  armc = swe_degnorm(swe_sidtime(jd_ut) + geolon);
+  rc = swe_houses_armc_ex2(armc, geolat, eps, ihsy, cusps, ascmc,cusp_speed,ascmc_speed,serr);
+  check_swehouses_armc_ex2_results(rc,armc,ihsy,cusps,ascmc,cusp_speed,ascmc_speed,serr,ctx);
+  }
+
+void testcase_6_10(test_context *ctx) {
+  /* 100 times step days apart; maximum difference of cusps and 
+   * angles in arcsec */
+  static double cs[100 * 13], as[100 * 10];
+  int32 i, k, n = 100;
+  double step = get_d("step",ctx), d, dmax = 0;
+  rc = swe_houses_series(jd_ut, step, n, 0, geolat, geolon, ihsy, cs, as, NULL, serr);
+  check_i(rc,"rc",ctx);
+  for (i = 0; i < n; i++) {
+    swe_houses_ex(jd_ut + i * step, 0, geolat, geolon, ihsy, cusps, ascmc);
+    for (k = 1; k <= 12; k++) {
+      d = fabs(swe_difdeg2n(cs[i * 13 + k], cusps[k])) * 3600;
+      if (d > dmax) dmax = d;
+    }
+    for (k = 0; k < SE_NASCMC; k++) {
+      d = fabs(swe_difdeg2n(as[i * 10 + k], ascmc[k])) * 3600;
+      if (d > dmax) dmax = d;
+    }
+  }
+  check_equals_d(dmax,0,"dmax",ctx);
+  }
+void testcase_6_11(test_context *ctx) {
+  /* crossings of a point over x2cross within 3 days, in direct or 
+   * retrograde motion; the time in seconds until the point reaches 
+   * x2cross with its speed from swe_houses_ex2( ) */
+  double tret[10], x2cross = get_d("x2cross",ctx), d, v, dmax = 0;
+  double cusp_speed[37], ascmc_speed[10];
+  int32 i, nret, ipoint = get_i("ipoint",ctx);
+  rc = swe_houses_cross(jd_ut, jd_ut + 3, 0, geolat, geolon, ihsy, ipoint, x2cross, tret, 10, &nret, serr);
+  check_i(rc,"rc",ctx);
+  check_i(nret,"nret",ctx);
+  for (i = 0; i < nret; i++) {
+    swe_houses_ex2(tret[i], 0, geolat, geolon, ihsy, cusps, ascmc, cusp_speed, ascmc_speed, serr);
+    if (ipoint >= SE_HOUSES_ANGLE) {
+      d = ascmc[ipoint - SE_HOUSES_ANGLE];
+      v = ascmc_speed[ipoint - SE_HOUSES_ANGLE];
+    } else {
+      d = cusps[ipoint];
+      v = cusp_speed[ipoint];
+    }
+    d = fabs(swe_difdeg2n(d, x2cross) / v) * 86400;
+    if (d > dmax) dmax = d;
+  }
+  check_equals_d(dmax,0,"dmax",ctx);
+  }
+
+void testcase_6_12(test_context *ctx) {
+  /* 5 x 5 points from latitude -75 and longitude -120; return code of
+   * each point and maximum difference of cusps and angles in degrees */
+  static double cs[25 * 37], as[25 * 10];
+  int32 cellret[25], i, k, ilat, ilon, ncusp, ito;
+  int32 iflag = get_i("iflag",ctx);
+  double d, dmax = 0, fac = (iflag & SEFLG_RADIANS) ? RADTODEG : 1;
+  ito = (ihsy == 'G') ? 36 : 12;
+  ncusp = ito + 1;
+  if (iflag & SEFLG_SIDEREAL)
+    swe_set_sid_mode(SE_SIDM_LAHIRI, 0, 0);
+  swe_houses_grid(jd_ut, iflag, ihsy, -75, 37.5, 5, -120, 60, 5, cs, as, cellret, serr);
+  for (ilat = 0; ilat < 5; ilat++) {
+    for (ilon = 0; ilon < 5; ilon++) {
+      i = ilat * 5 + ilon;
+      rc = swe_houses_ex(jd_ut, iflag, -75 + ilat * 37.5, -120 + ilon * 60, ihsy, cusps, ascmc);
+      check_equals_i(cellret[i],rc < 0 ? ERR : OK,"cellret[i]",ctx);
+      for (k = 1; k <= ito; k++) {
+        d = fabs(swe_difdeg2n(cs[i * ncusp + k] * fac, cusps[k] * fac));
+        if (d > dmax) dmax = d;
+      }
+      for (k = 0; k < SE_NASCMC; k++) {
+        d = fabs(swe_difdeg2n(as[i * 10 + k] * fac, ascmc[k] * fac));
+        if (d > dmax) dmax = d;
+      }
+    }
+  }
+  check_equals_d(dmax,0,"dmax",ctx);
+  }
+
+void testcase_6_13(test_context *ctx) {
+  /* seven house systems in one call; return code of each system and
+   * maximum difference of cusps, angles and their speeds */
+  static const int hsys[7] = {'P', 'K', 'W', 'G', 'I', 'B', 'Y'};
+  static double cs[7 * 37], as[7 * 10], css[7 * 37], ass[7 * 10];
+  int32 sysret[7], j, k, ito;
+  int32 iflag = get_i("iflag",ctx);
+  double d, dmax = 0, fac = (iflag & SEFLG_RADIANS) ? RADTODEG : 1;
+  if (iflag & SEFLG_SIDEREAL)
+    swe_set_sid_mode(SE_SIDM_LAHIRI, 0, 0);
+  swe_houses_multi(jd_ut, iflag, geolat, geolon, 7, hsys, cs, as, css, ass, sysret, serr);
+  for (j = 0; j < 7; j++) {
+    ito = (hsys[j] == 'G') ? 36 : 12;
+    rc = swe_houses_ex2(jd_ut, iflag, geolat, geolon, hsys[j], cusps, ascmc, cusp_speed, ascmc_speed, serr);
+    check_equals_i(sysret[j],rc < 0 ? ERR : OK,"sysret[j]",ctx);
+    for (k = 1; k <= ito; k++) {
+      d = fabs(swe_difdeg2n(cs[j * 37 + k] * fac, cusps[k] * fac));
+      if (d > dmax) dmax = d;
+      d = fabs(css[j * 37 + k] - cusp_speed[k]);
+      if (d > dmax) dmax = d;
+    }
+    for (k = 0; k < SE_NASCMC; k++) {
+      d = fabs(swe_difdeg2n(as[j * 10 + k] * fac, ascmc[k] * fac));
+      if (d > dmax) dmax = d;
+      d = fabs(ass[j * 10 + k] - ascmc_speed[k]);
+      if (d > dmax) dmax = d;
+    }
+  }
+  check_equals_d(dmax,0,"dmax",ctx);
+  }
+
+void testcase_6_14(test_context *ctx) {
+  /* the bodies Sun ... Pluto and the lunar node, and points on a 
+   * net of longitudes and latitudes; maximum difference of the house
+   * positions */
+  static double xp[(11 + 72 * 5) * 2], hp[11 + 72 * 5];
+  int32 i, k, n = 0;
+  double eps, d, dmax = 0;
+  rc = swe_calc_ut(jd_ut, SE_ECL_NUT, 0, xx, serr);
+  eps = xx[0];
+  armc = swe_degnorm(swe_sidtime(jd_ut) * 15 + geolon);
+  for (i = SE_SUN; i <= SE_TRUE_NODE; i++) {
+    swe_calc_ut(jd_ut, i, 0, xx, serr);
+    xp[2 * n] = xx[0];
+    xp[2 * n + 1] = xx[1];
+    n++;
+  }
+  for (i = 0; i < 72; i++) {
+    for (k = 0; k < 5; k++) {
+      xp[2 * n] = i * 5 + 0.3;
+      xp[2 * n + 1] = -60 + k * 30;
+      n++;
+    }
+  }
+  rc = swe_house_pos_batch(armc, geolat, eps, ihsy, n, xp, hp, serr);
+  check_i(rc,"rc",ctx);
+  for (i = 0; i < n; i++) {
+    d = fabs(hp[i] - swe_house_pos(armc, geolat, eps, ihsy, xp + 2 * i, serr));
+    if (d > dmax) dmax = d;
+  }
+  check_equals_d(dmax,0,"dmax",ctx);
+  }
+
+void setup_6() {
+  *serr = '\0';
+  jd_ut = get_d("jd",ctx) + get_d("ut",ctx) / 24.0;
+  ihsy = get_i("ihsy",ctx);
+  geolat = get_d("geolat",ctx);
+  geolon = get_d("geolon",ctx);
+  }
+
+void teardown_6() {
+  if (get_i("initialize",ctx)) swe_close( );
+  }
+
+
+  open_testsuite(6,"Houses functions",ctx);
+
+
+  if (is_testcase_selected( 1, ctx)) { 
+    open_testcase(1,"swe_houses( ) ",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_6();
+        testcase_6_1(ctx);
+        teardown_6();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 2, ctx)) { 
+    open_testcase(2,"swe_houses_ex( ) - degrees and radians",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_6();
+        testcase_6_2(ctx);
+        teardown_6();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 3, ctx)) { 
+    open_testcase(3,"swe_houses_ex( ) - sidereal ",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_6();
+        testcase_6_3(ctx);
+        teardown_6();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 4, ctx)) { 
+    open_testcase(4,"swe_houses_armc( ) - Koch and Placidus",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_6();
+        testcase_6_4(ctx);
+        teardown_6();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 5, ctx)) { 
+    open_testcase(5,"swe_house_name( ) ",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_6();
+        testcase_6_5(ctx);
+        teardown_6();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 6, ctx)) { 
+    open_testcase(6,"swe_house_pos( ) ",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_6();
+        testcase_6_6(ctx);
+        teardown_6();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 7, ctx)) { 
+    open_testcase(7,"swe_gauquelin_sector( ) ",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_6();
+        testcase_6_7(ctx);
+        teardown_6();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 8, ctx)) { 
+    open_testcase(8,"swe_houses_ex2( ) - with speeds of cusps ",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_6();
+        testcase_6_8(ctx);
+        teardown_6();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 9, ctx)) { 
+    open_testcase(9,"swe_houses_armc_ex2( ) - Koch and Placidus with cusp speeds",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_6();
+        testcase_6_9(ctx);
+        teardown_6();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 10, ctx)) { 
+    open_testcase(10,"swe_houses_series( ) - against swe_houses_ex( )",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_6();
+        testcase_6_10(ctx);
+        teardown_6();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 11, ctx)) { 
+    open_testcase(11,"swe_houses_cross( ) - times against swe_houses_ex( )",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_6();
+        testcase_6_11(ctx);
+        teardown_6();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 12, ctx)) { 
+    open_testcase(12,"swe_houses_grid( ) - against swe_houses_ex( )",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_6();
+        testcase_6_12(ctx);
+        teardown_6();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 13, ctx)) { 
+    open_testcase(13,"swe_houses_multi( ) - against swe_houses_ex2( )",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_6();
+        testcase_6_13(ctx);
+        teardown_6();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 14, ctx)) { 
+    open_testcase(14,"swe_house_pos_batch( ) - against swe_house_pos( )",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_6();
+        testcase_6_14(ctx);
+        teardown_6();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+}
+#include "testsuite_final.h"
+
+
+void testsuite_7(test_context *ctx) {
+
+double jd, xxnasc[6],xxndsc[6],xxperi[6],xxaphe[6], xxdret[20];
+int iflag, iephe; // Keep ephemeris selector separate from other flags
+char serr[255];
+int rc;
+swe_set_ephe_path(NULL);
+
+void testcase_7_1(test_context *ctx) {
+  jd = get_d("jd",ctx);
+  rc = swe_nod_aps(jd, get_i("ipl",ctx), iflag|iephe,  get_i("method",ctx), xxnasc, xxndsc, xxperi, xxaphe, serr);
+  check_i(rc,"rc",ctx);
+  check_s(serr,"serr",ctx);
+  check_dd(xxnasc,6,"xxnasc",ctx);
+  check_dd(xxndsc,6,"xxndsc",ctx);
+  check_dd(xxperi,6,"xxperi",ctx);
+  check_dd(xxaphe,6,"xxaphe",ctx);
+  }
+
+void testcase_7_2(test_context *ctx) {
+  jd = get_d("jd",ctx);
+  rc = swe_nod_aps_ut(jd, get_i("ipl",ctx), iflag|iephe,  get_i("method",ctx), xxnasc, xxndsc, xxperi, xxaphe, serr);
+  check_i(rc,"rc",ctx);
+  check_s(serr,"serr",ctx);
+  check_dd(xxnasc,6,"xxnasc",ctx);
+  check_dd(xxndsc,6,"xxndsc",ctx);
+  check_dd(xxperi,6,"xxperi",ctx);
+  check_dd(xxaphe,6,"xxaphe",ctx);
+  }
+
+void testcase_7_3(test_context *ctx) {
+  jd = get_d("jd",ctx);
+  rc = swe_get_orbital_elements(jd, get_i("ipl",ctx), iflag|iephe,  xxdret, serr);
+  check_i(rc,"rc",ctx);
+  check_s(serr,"serr",ctx);
+  check_dd(xxdret,17,"xxdret",ctx);
+  }
+
+void testcase_7_4(test_context *ctx) {
+  double dmax, dmin, dtrue;
+  jd = get_d("jd",ctx);
+  rc = swe_orbit_max_min_true_distance(jd, get_i("ipl",ctx), iflag|iephe,  &dmax, &dmin, &dtrue, serr);
+  check_i(rc,"rc",ctx);
+  check_s(serr,"serr",ctx);
+  check_d(dmax,"dmax",ctx);
+  check_d(dmin,"dmin",ctx);
+  check_d(dtrue,"dtrue",ctx);
+  }
+
+void setup_7() {
+  iflag = get_i("iflag",ctx);
+  iephe = get_i("iephe",ctx);
+  *serr = '\0';
+  }
+
+void teardown_7() {
+  if (get_i("initialize",ctx)) swe_close( );
+  }
+
+
+  open_testsuite(7,"Apsides and orbital elements functions",ctx);
+
+
+  if (is_testcase_selected( 1, ctx)) { 
+    open_testcase(1,"swe_nod_aps( ) ",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_7();
+        testcase_7_1(ctx);
+        teardown_7();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 2, ctx)) { 
+    open_testcase(2,"swe_nod_aps_ut( ) ",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_7();
+        testcase_7_2(ctx);
+        teardown_7();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 3, ctx)) { 
+    open_testcase(3,"swe_get_orbital_elements( ) ",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_7();
+        testcase_7_3(ctx);
+        teardown_7();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 4, ctx)) { 
+    open_testcase(4,"swe_orbit_max_min_true_distance( ) ",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_7();
+        testcase_7_4(ctx);
+        teardown_7();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+}
+#include "testsuite_final.h"
+
+
+void testsuite_8(test_context *ctx) {
+
+double jd, xxtret[10], xxgeopos[3], xxattr[20];
+double geolat, geolon, altitude;
+char serr[255], star[100];;
+int rc, ipl;
+swe_set_ephe_path(NULL);
+
+void testcase_8_1(test_context *ctx) {
+  jd = get_d("jd",ctx);
+  rc = swe_sol_eclipse_when_glob(jd, get_i("iephe",ctx), get_i("ifltype",ctx),
+       xxtret, get_i("backward",ctx), serr);
+  check_i(rc,"rc",ctx);
+  check_dd(xxtret,10,"xxtret",ctx);
+  }
+
+void testcase_8_2(test_context *ctx) {
+  jd = get_d("jd",ctx);
+  rc = swe_sol_eclipse_where(jd, get_i("iephe",ctx), xxgeopos, xxattr, serr);
+  check_i(rc,"rc",ctx);
+  check_dd(xxgeopos,2,"xxgeopos",ctx);
+  check_dd(xxattr,8,"xxattr",ctx);
+  }
+
+void testcase_8_3(test_context *ctx) {
+  jd = get_d("jd",ctx);
+  double geopos[3] = {geolon, geolat, altitude};
+  rc = swe_sol_eclipse_when_loc(jd, get_i("iephe",ctx), geopos, xxtret, xxattr, get_i("backward",ctx), serr);
+  check_i(rc,"rc",ctx);
+  check_dd(xxtret,7,"xxtret",ctx);
+  check_dd(xxattr,11,"xxattr",ctx);
+  }
+
+void testcase_8_4(test_context *ctx) {
+  jd = get_d("jd",ctx);
+  double geopos[3] = {geolon, geolat, altitude};
+  rc = swe_sol_eclipse_how(jd, get_i("iephe",ctx), geopos, xxattr, serr);
+  check_i(rc,"rc",ctx);
+  check_dd(xxattr,11,"xxattr",ctx);
+  }
+
+void testcase_8_5(test_context *ctx) {
+  jd = get_d("jd",ctx);
+  ipl = get_i("ipl",ctx);
+  *star = '\0';
+  if (ipl == -1)
+    strcpy(star,get_s("star",ctx));
+  rc = swe_lun_occult_when_glob(jd, ipl, star, get_i("iephe",ctx), get_i("ifltype",ctx),
+       xxtret, get_i("backward",ctx), serr);
+  check_i(rc,"rc",ctx);
+  check_dd(xxtret,10,"xxtret",ctx);
+  }
+
+void testcase_8_6(test_context *ctx) {
+  jd = get_d("jd",ctx);
+  ipl = get_i("ipl",ctx);
+  *star = '\0';
+  if (ipl == -1)
+    strcpy(star,get_s("star",ctx));
+  rc = swe_lun_occult_where(jd, ipl, star, get_i("iephe",ctx), xxgeopos, xxattr, serr);
+  check_dd(xxgeopos,2,"xxgeopos",ctx);
+  check_dd(xxattr,8,"xxattr",ctx);
+  }
+
+void testcase_8_7(test_context *ctx) {
+  double geopos[3] = {geolon, geolat, altitude};
+  jd = get_d("jd",ctx);
+  ipl = get_i("ipl",ctx);
+  *star = '\0';
+  if (ipl == -1)
+    strcpy(star,get_s("star",ctx));
+  rc = swe_lun_occult_when_loc(jd, ipl, star, get_i("iephe",ctx), geopos,
+       xxtret, xxattr, get_i("backward",ctx), serr);
+  check_i(rc,"rc",ctx);
+  check_dd(xxtret,7,"xxtret",ctx);
+  check_dd(xxattr,11,"xxattr",ctx);
+  }
+
+void testcase_8_8(test_context *ctx) {
+  jd = get_d("jd",ctx);
+  rc = swe_lun_eclipse_when(jd, get_i("iephe",ctx), get_i("ifltype",ctx),
+       xxtret, get_i("backward",ctx), serr);
+  check_i(rc,"rc",ctx);
+  check_dd(xxtret,10,"xxtret",ctx);
+  }
+
+void testcase_8_9(test_context *ctx) {
+  jd = get_d("jd",ctx);
+  double geopos[3] = {geolon, geolat, altitude};
+  rc = swe_sol_eclipse_when_loc(jd, get_i("iephe",ctx), geopos, xxtret, xxattr, get_i("backward",ctx), serr);
+  check_i(rc,"rc",ctx);
+  check_dd(xxtret,10,"xxtret",ctx);
+  check_dd(xxattr,11,"xxattr",ctx);
+  }
+
+void testcase_8_10(test_context *ctx) {
+  jd = get_d("jd",ctx);
+  double geopos[3] = {geolon, geolat, altitude};
+  rc = swe_lun_eclipse_how(jd, get_i("iephe",ctx), geopos, xxattr, serr);
+  check_i(rc,"rc",ctx);
+  check_dd(xxattr,11,"xxattr",ctx);
+  }
+
+void testcase_8_11(test_context *ctx) {
+  /* 10 eclipses in a row from a catalog written for the test; return 
+   * flags, maximum difference of the contacts in seconds, of the 
+   * attributes and of the geographic position of maximum, and the 
+   * number of eclipses taken from the catalog */
+  double tret[10], attr[20], geopos[2], ltret[10], lgeo[20], lattr[20], tmax[10];
+  double d, dmax = 0;
+  int32 i, k, rc2, ncat, iephe = get_i("iephe",ctx), ifltype = get_i("ifltype",ctx), backward = get_i("backward",ctx);
+  jd = get_d("jd",ctx);
+  rc = open_test_eclipse_catalog(jd, iephe, serr);
+  check_equals_i(rc,OK,"rc",ctx);
+  if (rc == ERR) {
+    close_test_eclipse_catalog();
+    return;
+  }
+  for (i = 0; i < 10; i++) {
+    rc = swe_sol_eclipse_when_glob_cat(jd, iephe, ifltype, tret, attr, geopos, backward, serr);
+    rc2 = swe_sol_eclipse_when_glob(jd, iephe, ifltype, ltret, backward, serr);
+    swe_sol_eclipse_where(ltret[0], iephe, lgeo, lattr, serr);
+    check_equals_i(rc,rc2,"rc",ctx);
+    for (k = 0; k < 8; k++) {
+      d = fabs(tret[k] - ltret[k]) * 86400;
+      if (d > dmax) dmax = d;
+    }
+    for (k = 0; k < 11; k++) {
+      d = fabs(attr[k] - lattr[k]);
+      if (d > dmax) dmax = d;
+    }
+    for (k = 0; k < 2; k++) {
+      d = fabs(geopos[k] - lgeo[k]);
+      if (d > dmax) dmax = d;
+    }
+    jd = tmax[i] = tret[0];
+  }
+  ncat = eclipses_in_test_catalog(tmax, 10, iephe);
+  close_test_eclipse_catalog();
+  check_equals_d(dmax,0,"dmax",ctx);
+  check_equals_i(ncat,10,"ncat",ctx);
+  }
+
+void testcase_8_12(test_context *ctx) {
+  /* as case 11, with lunar eclipses and their attributes */
+  double tret[10], attr[20], ltret[10], lattr[20], tmax[10];
+  double d, dmax = 0;
+  int32 i, k, rc2, ncat, iephe = get_i("iephe",ctx), ifltype = get_i("ifltype",ctx), backward = get_i("backward",ctx);
+  jd = get_d("jd",ctx);
+  rc = open_test_eclipse_catalog(jd, iephe, serr);
+  check_equals_i(rc,OK,"rc",ctx);
+  if (rc == ERR) {
+    close_test_eclipse_catalog();
+    return;
+  }
+  for (i = 0; i < 10; i++) {
+    rc = swe_lun_eclipse_when_cat(jd, iephe, ifltype, tret, attr, backward, serr);
+    rc2 = swe_lun_eclipse_when(jd, iephe, ifltype, ltret, backward, serr);
+    swe_lun_eclipse_how(ltret[0], iephe, NULL, lattr, serr);
+    check_equals_i(rc,rc2,"rc",ctx);
+    for (k = 0; k < 8; k++) {
+      d = fabs(tret[k] - ltret[k]) * 86400;
+      if (d > dmax) dmax = d;
+    }
+    for (k = 0; k < 11; k++) {
+      d = fabs(attr[k] - lattr[k]);
+      if (d > dmax) dmax = d;
+    }
+    jd = tmax[i] = tret[0];
+  }
+  ncat = eclipses_in_test_catalog(tmax, 10, iephe);
+  close_test_eclipse_catalog();
+  check_equals_d(dmax,0,"dmax",ctx);
+  check_equals_i(ncat,10,"ncat",ctx);
+  }
+
+void setup_8() {
+  *serr = '\0';
+  geolat = get_d("geolat",ctx);
+  geolon = get_d("geolon",ctx);
+  altitude = get_d("altitude",ctx);
+  }
+
+void teardown_8() {
+  if (get_i("initialize",ctx)) swe_close( );
+  }
+
+
+  open_testsuite(8,"Eclipses",ctx);
+
+
+  if (is_testcase_selected( 1, ctx)) { 
+    open_testcase(1,"swe_sol_eclipse_when_glob( ) ",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_8();
+        testcase_8_1(ctx);
+        teardown_8();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 2, ctx)) { 
+    open_testcase(2,"swe_sol_eclipse_where( ) ",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_8();
+        testcase_8_2(ctx);
+        teardown_8();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 3, ctx)) { 
+    open_testcase(3,"swe_sol_eclipse_when_loc( ) ",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_8();
+        testcase_8_3(ctx);
+        teardown_8();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 4, ctx)) { 
+    open_testcase(4,"swe_sol_eclipse_how( ) ",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_8();
+        testcase_8_4(ctx);
+        teardown_8();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 5, ctx)) { 
+    open_testcase(5,"swe_lun_occult_when_glob( ) ",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_8();
+        testcase_8_5(ctx);
+        teardown_8();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 6, ctx)) { 
+    open_testcase(6,"swe_lun_occult_where( ) ",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_8();
+        testcase_8_6(ctx);
+        teardown_8();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 7, ctx)) { 
+    open_testcase(7,"swe_lun_occult_when_loc( ) ",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_8();
+        testcase_8_7(ctx);
+        teardown_8();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 8, ctx)) { 
+    open_testcase(8,"swe_lun_eclipse_when( ) ",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_8();
+        testcase_8_8(ctx);
+        teardown_8();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 9, ctx)) { 
+    open_testcase(9,"swe_lun_eclipse_when_loc( ) ",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_8();
+        testcase_8_9(ctx);
+        teardown_8();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 10, ctx)) { 
+    open_testcase(10,"swe_lun_eclipse_how( ) ",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_8();
+        testcase_8_10(ctx);
+        teardown_8();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 11, ctx)) { 
+    open_testcase(11,"swe_sol_eclipse_when_glob_cat( ) - against the live search",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_8();
+        testcase_8_11(ctx);
+        teardown_8();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 12, ctx)) { 
+    open_testcase(12,"swe_lun_eclipse_when_cat( ) - against the live search",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_8();
+        testcase_8_12(ctx);
+        teardown_8();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+}
+#include "testsuite_final.h"
+
+
+void testsuite_9(test_context *ctx) {
+
+double jd, xxtret[10];
+double geolat, geolon, altitude, tret;
+double atpress, attemp, athumid, atktot, obsage, obsSN;
+char serr[255], star[100], object[100];
+int rc, ipl;
+swe_set_ephe_path(NULL);
+
+void testcase_9_1(test_context *ctx) {
+  double geopos[3] = {geolon, geolat, altitude};
+  int rsmi = get_i("ifltype",ctx) | get_i("method",ctx);
+  jd = get_d("jd",ctx);
+  ipl = get_i("ipl",ctx);
+  *star = '\0';
+  if (ipl == -1)
+    strcpy(star,get_s("star",ctx));
+  rc = swe_rise_trans(jd, get_i("ipl",ctx), star, get_i("iephe",ctx), rsmi,
+       geopos, get_d("atpress",ctx), get_d("attemp",ctx), &tret, serr);
+  check_i(rc,"rc",ctx);
+  check_d(tret,"tret",ctx);
+  }
+
+void testcase_9_2(test_context *ctx) {
+  double geopos[3] = {geolon, geolat, altitude};
+  int rsmi = get_i("ifltype",ctx) | get_i("method",ctx);
+  jd = get_d("jd",ctx);
+  ipl = get_i("ipl",ctx);
+  *star = '\0';
+  if (ipl == -1)
+    strcpy(star,get_s("star",ctx));
+  rc = swe_rise_trans_true_hor(jd, get_i("ipl",ctx), star, get_i("iephe",ctx), rsmi,
+       geopos, get_d("atpress",ctx), get_d("attemp",ctx), get_d("horhgt",ctx), &tret, serr);
+  check_i(rc,"rc",ctx);
+  check_d(tret,"tret",ctx);
+  }
+
+void testcase_9_3(test_context *ctx) {
+  double geopos[3] = {geolon, geolat, altitude};
+  double datm[4] = {atpress, attemp, athumid, atktot};
+  double dobs[5] = {obsage, obsSN,};
+  jd = get_d("jd",ctx);
+  rc = swe_heliacal_ut(jd, geopos, datm, dobs, strcpy(object,get_s("object",ctx)), get_i("evtype",ctx), get_i("helflag",ctx), xxtret, serr);
+  check_i(rc,"rc",ctx);
+  check_dd(xxtret,3,"xxtret",ctx);
+  }
+
+void testcase_9_4(test_context *ctx) {
+  double geopos[3] = {geolon, geolat, altitude};
+  double datm[4] = {atpress, attemp, athumid, atktot};
+  double dobs[5] = {obsage, obsSN,};
+  jd = get_d("jd",ctx);
+  rc = swe_heliacal_pheno_ut(jd, geopos, datm, dobs, strcpy(object,get_s("object",ctx)), get_i("evtype",ctx), get_i("helflag",ctx), xxtret, serr);
+  check_i(rc,"rc",ctx);
+  check_dd(xxtret,3,"xxtret",ctx);
+  }
+
+void testcase_9_5(test_context *ctx) {
+  double geopos[3] = {geolon, geolat, altitude};
+  double datm[4] = {atpress, attemp, athumid, atktot};
+  double dobs[5] = {obsage, obsSN,};
+  jd = get_d("jd",ctx);
+  rc = swe_vis_limit_mag(jd, geopos, datm, dobs, strcpy(object,get_s("object",ctx)), get_i("helflag",ctx), xxtret, serr);
+  check_i(rc,"rc",ctx);
+  check_dd(xxtret,3,"xxtret",ctx);
+  }
+
+void setup_9() {
+  *serr = '\0';
+  geolat = get_d("geolat",ctx);
+  geolon = get_d("geolon",ctx);
+  altitude = get_d("altitude",ctx);
+  atpress = get_d("atpress",ctx);
+  attemp = get_d("attemp",ctx);
+  athumid = get_d("athumid",ctx);
+  atktot = get_d("atktot",ctx);
+  obsage = get_d("obsage",ctx);
+  obsSN = get_d("obsSN",ctx);
+  }
+
+void teardown_9() {
+  if (get_i("initialize",ctx)) swe_close( );
+  }
+
+
+  open_testsuite(9,"risings, heliacal risings",ctx);
+
+
+  if (is_testcase_selected( 1, ctx)) { 
+    open_testcase(1,"swe_rise_trans( ) ",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_9();
+        testcase_9_1(ctx);
+        teardown_9();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 2, ctx)) { 
+    open_testcase(2,"swe_rise_trans_true_hor( ) ",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_9();
+        testcase_9_2(ctx);
+        teardown_9();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 3, ctx)) { 
+    open_testcase(3,"swe_heliacal_ut( ) ",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_9();
+        testcase_9_3(ctx);
+        teardown_9();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 4, ctx)) { 
+    open_testcase(4,"swe_heliacal_pheno_ut()( ) ",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_9();
+        testcase_9_4(ctx);
+        teardown_9();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 5, ctx)) { 
+    open_testcase(5,"swe_vis_limit_mag()( ) ",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_9();
+        testcase_9_5(ctx);
+        teardown_9();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+}
+#include "testsuite_final.h"
+
+
+
+void testsuite_10(test_context *ctx) {
+
+double xx[6],jd;
+int iflag, iephe; // Keep ephemeris selector separate from other flags
+char serr[255];
+
+swe_set_ephe_path(NULL);
+swe_set_jpl_file("de431.eph");
+
+void testcase_10_1(test_context *ctx) {
+  iflag = iephe;
+  double  xcross = get_d("xcross",ctx);
+  double jx = swe_solcross(xcross, jd,  iflag, serr);
+  int rc = swe_calc(jx, SE_SUN, iflag, xx, serr);
+  check_i(rc,"rc",ctx);
+  check_d(jx,"jx",ctx);
+  check_equals_d(xcross,xx[0],"xcross",ctx);
+  check_s(serr,"serr",ctx);
+  }
+
+void testcase_10_2(test_context *ctx) {
+  iflag = iephe;
+  double  xcross = get_d("xcross",ctx);
+  double jx = swe_solcross_ut(xcross, jd,  iflag, serr);
+  int rc = swe_calc_ut(jx, SE_SUN, iflag, xx, serr);
+  check_i(rc,"rc",ctx);
+  check_d(jx,"jx",ctx);
+  check_equals_d(xcross,xx[0],"xcross",ctx);
+  check_s(serr,"serr",ctx);
+  }
+
+void testcase_10_3(test_context *ctx) {
+  iflag = iephe;
+  double  xcross = get_d("xcross",ctx);
+  double jx = swe_mooncross(xcross, jd,  iflag, serr);
+  int rc = swe_calc(jx, SE_MOON, iflag, xx, serr);
+  check_i(rc,"rc",ctx);
+  check_d(jx,"jx",ctx);
+  check_equals_d(xcross,xx[0],"xcross",ctx);
+  check_s(serr,"serr",ctx);
+  }
+
+void testcase_10_4(test_context *ctx) {
+  iflag = iephe;
+  double  xcross = get_d("xcross",ctx);
+  double jx = swe_mooncross_ut(xcross, jd,  iflag, serr);
+  int rc = swe_calc_ut(jx, SE_MOON, iflag, xx, serr);
+  check_i(rc,"rc",ctx);
+  check_d(jx,"jx",ctx);
+  check_equals_d(xcross,xx[0],"xcross",ctx);
+  check_s(serr,"serr",ctx);
+  }
+
+void testcase_10_5(test_context *ctx) {
+  iflag = iephe;
+  double xlon, xlat;
+  double jx = swe_mooncross_node(jd,  iflag, &xlon, &xlat, serr);
+  int rc = swe_calc(jx, SE_MOON, iflag, xx, serr);
+  check_i(rc,"rc",ctx);
+  check_d(jx,"jx",ctx);
+  check_d(xlon,"xlon",ctx);
+  check_d(xlat,"xlat",ctx);
+  check_equals_d(xx[1],0,"xx[1]",ctx);	// latitude must  be zero
+  check_s(serr,"serr",ctx);
+  }
+
+void testcase_10_6(test_context *ctx) {
+  iflag = iephe;
+  double xlon, xlat;
+  double jx = swe_mooncross_node_ut(jd,  iflag, &xlon, &xlat, serr);
+  int rc = swe_calc_ut(jx, SE_MOON, iflag, xx, serr);
+  check_i(rc,"rc",ctx);
+  check_d(jx,"jx",ctx);
+  check_d(xlon,"xlon",ctx);
+  check_d(xlat,"xlat",ctx);
+  check_equals_d(xx[1],0,"xx[1]",ctx);	// latitude must  be zero
+  check_s(serr,"serr",ctx);
+  }
+
+void testcase_10_7(test_context *ctx) {
+  iflag = iephe;
+  double jx;
+  double  xcross = get_d("xcross",ctx);
+  int ipl = get_i("ipl",ctx);
+  int dir = get_i("dir",ctx);
+  int rc = swe_helio_cross(ipl, xcross, jd,  iflag, dir, &jx, serr);
+  check_d(jx,"jx",ctx);
+  check_i(rc,"rc",ctx);
+  check_s(serr,"serr",ctx);
+  }
+
+void testcase_10_8(test_context *ctx) {
+  iflag = iephe;
+  double jx;
+  double  xcross = get_d("xcross",ctx);
+  int ipl = get_i("ipl",ctx);
+  int dir = get_i("dir",ctx);
+  int rc = swe_helio_cross_ut(ipl, xcross, jd,  iflag, dir, &jx, serr);
+  check_d(jx,"jx",ctx);
+  check_i(rc,"rc",ctx);
+  check_s(serr,"serr",ctx);
+  }
+
+
+void setup_10() {
+  iephe = get_i("iephe",ctx);
+  jd = get_d("jd",ctx);
+  *serr = '\0';
+  }
+
+void teardown_10() {
+  if (get_i("initialize",ctx)) swe_close( );
+  }
+
+  open_testsuite(10,"Various swe_*cross calls ",ctx);
+
+
+  if (is_testcase_selected( 1, ctx)) { 
+    open_testcase(1,"swe_solcross( ) - sun crossing a position",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_10();
+        testcase_10_1(ctx);
+        teardown_10();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 2, ctx)) { 
+    open_testcase(2,"swe_solcross_ut( ) - sun crossing a position",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_10();
+        testcase_10_2(ctx);
+        teardown_10();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 3, ctx)) { 
+    open_testcase(3,"swe_mooncross( ) - moon crossing a position",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_10();
+        testcase_10_3(ctx);
+        teardown_10();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 4, ctx)) { 
+    open_testcase(4,"swe_mooncross_ut( ) - moon crossing a position",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_10();
+        testcase_10_4(ctx);
+        teardown_10();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 5, ctx)) { 
+    open_testcase(5,"swe_mooncross_node( ) - moon crossing node position",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_10();
+        testcase_10_5(ctx);
+        teardown_10();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 6, ctx)) { 
+    open_testcase(6,"swe_mooncross_node_ut( ) - moon crossing node position",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_10();
+        testcase_10_6(ctx);
+        teardown_10();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 7, ctx)) { 
+    open_testcase(7,"swe_helio_cross( ) - heliocentric crossing planet over a position",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_10();
+        testcase_10_7(ctx);
+        teardown_10();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+
+  if (is_testcase_selected( 8, ctx)) { 
+    open_testcase(8,"swe_helio_cross_ut( ) - heliocentric crossing planet over a position",ctx);   
+    ctx->current.iteration.id = 0;
+    do {
+      ctx->current.iteration.id++;
+      open_iteration( ctx->current.iteration.id, ctx );
+      if (is_iteration_selected(ctx)) {
+        setup_10();
+        testcase_10_8(ctx);
+        teardown_10();
+        close_iteration(ctx);
+      }
+    } while (has_more_iterations(ctx)); 
+    close_testcase(ctx);
+  }
+
+}
+
+void run_tests(test_context *ctx) {
+  if (is_suite_selected(1,ctx)) {
+    strcpy(ctx->current.file,"suite_01_calc.c");
+    testsuite_1(ctx);
+    close_testsuite(ctx);
+  }  
+  if (is_suite_selected(2,ctx)) {
+    strcpy(ctx->current.file,"suite_02_fixstar.c");
+    testsuite_2(ctx);
+    close_testsuite(ctx);
+  }  
+  if (is_suite_selected(3,ctx)) {
+    strcpy(ctx->current.file,"suite_03_misc.c");
+    testsuite_3(ctx);
+    close_testsuite(ctx);
+  }  
+  if (is_suite_selected(4,ctx)) {
+    strcpy(ctx->current.file,"suite_04_ayanamsa.c");
+    testsuite_4(ctx);
+    close_testsuite(ctx);
+  }  
+  if (is_suite_selected(5,ctx)) {
+    strcpy(ctx->current.file,"suite_05_date_time.c");
+    testsuite_5(ctx);
+    close_testsuite(ctx);
+  }  
+  if (is_suite_selected(6,ctx)) {
+    strcpy(ctx->current.file,"suite_06_houses.c");
+    testsuite_6(ctx);
+    close_testsuite(ctx);
+  }  
+  if (is_suite_selected(7,ctx)) {
+    strcpy(ctx->current.file,"suite_07_apsides.c");
+    testsuite_7(ctx);
+    close_testsuite(ctx);
+  }  
+  if (is_suite_selected(8,ctx)) {
+    strcpy(ctx->current.file,"suite_08_eclipses.c");
+    testsuite_8(ctx);
+    close_testsuite(ctx);
+  }  
+  if (is_suite_selected(9,ctx)) {
+    strcpy(ctx->current.file,"suite_09_rise.c");
+    testsuite_9(ctx);
+    close_testsuite(ctx);
+  }  
+  if (is_suite_selected(10,ctx)) {
+    strcpy(ctx->current.file,"suite_10_solcross.c");
+    testsuite_10(ctx);
+    close_testsuite(ctx);
+  }  
+}
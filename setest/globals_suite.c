@@ -1,6 +1,7 @@
 // This source file (i.e. globals_suite.c) contains utility functions for writing test case code
 
 #include "testsuite_facade.h"
+#include "sweph.h"
 
 void check_swecalc_results(int rc,double *xx, char* serr, test_context* ctx) {
   CHECK_DD(xx,6);
@@ -58,5 +59,60 @@ void check_swehouses_armc_ex2_results(int rc, double armc, int ihsy, double *cus
   CHECK_I(rc);
 }
 
+// Writes an eclipse catalog for ephemeris iephe, 20 years before and after
+// jd, into a new temporary directory and puts this directory first into the
+// ephemeris path. Undo with close_test_eclipse_catalog().
+static char ecl_dir[40], ecl_env[AS_MAXCH];
+static int ecl_has_env;
+
+int open_test_eclipse_catalog(double jd, int32 iephe, char *serr) {
+  char path[2 * AS_MAXCH], fn[AS_MAXCH], *sp = getenv("SE_EPHE_PATH");
+  ecl_has_env = (sp != NULL);
+  if (sp != NULL)
+    snprintf(ecl_env, AS_MAXCH, "%s", sp);
+  strcpy(ecl_dir, "/tmp/setestXXXXXX");
+  if (mkdtemp(ecl_dir) == NULL) {
+    strcpy(serr, "could not create a temporary directory");
+    *ecl_dir = '\0';
+    return ERR;
+  }
+  snprintf(path, sizeof(path), "%s%c%s", ecl_dir, *PATH_SEPARATOR,
+           sp != NULL && *sp != '\0' ? ecl_env : SE_EPHE_PATH);
+  setenv("SE_EPHE_PATH", path, 1);
+  swe_set_ephe_path(NULL);
+  return swi_write_eclipse_catalog(jd - 7305, jd + 7305, iephe, fn, serr);
+}
+
+void close_test_eclipse_catalog(void) {
+  char fn[AS_MAXCH];
+  swi_close_eclipse_catalog();
+  if (*ecl_dir != '\0') {
+    snprintf(fn, AS_MAXCH, "%s/%s", ecl_dir, SE_ECLFILE);
+    remove(fn);
+    rmdir(ecl_dir);
+    *ecl_dir = '\0';
+  }
+  if (ecl_has_env)
+    setenv("SE_EPHE_PATH", ecl_env, 1);
+  else
+    unsetenv("SE_EPHE_PATH");
+  swe_set_ephe_path(NULL);
+}
+
+// Number of eclipses tret[0][0..n-1] that the mapped eclipse catalog
+// for iephe covers, i.e. that swe_*_eclipse_when*_cat() take from it
+// instead of the live search
+int eclipses_in_test_catalog(double *tret0, int n, int32 iephe) {
+  struct efile_header *ehp = (struct efile_header *) swed.eclcat.mptr;
+  int i, k = 0;
+  if (ehp == NULL || ehp->epheflag != iephe)
+    return 0;
+  for (i = 0; i < n; i++) {
+    if (tret0[i] > ehp->tstart && tret0[i] <= ehp->tend)
+      k++;
+  }
+  return k;
+}
+
 // End of source file globals_suite.c
 
@@ -59,4 +59,222 @@ TESTCASE(5,"swe_calc_pctr( ) - planetocentic position") {
   check_swecalc_results(rc,xx,serr,ctx);
   }
 
+TESTCASE(6,"swe_set_analytical_cache( ) - fitted Moshier theories") {
+  /* 2000 epochs 0.37 days apart, with and without the fits; 
+   * maximum difference in arcsec */
+  static double x0[2000][2];
+  int i, k, ipl = GET_I(ipl);
+  double d, dmax = 0;
+  for (k = 0; k < 2; k++) {
+    swe_set_analytical_cache(k == 0 ? 0 : 0.001);
+    for (i = 0; i < 2000; i++) {
+      swe_calc(jd + i * 0.37, ipl, SEFLG_MOSEPH, xx, serr);
+      if (k == 0) {
+        x0[i][0] = xx[0];
+        x0[i][1] = xx[1];
+        continue;
+      }
+      d = fabs(swe_difdeg2n(xx[0], x0[i][0])) * 3600;
+      if (d > dmax) dmax = d;
+      d = fabs(xx[1] - x0[i][1]) * 3600;
+      if (d > dmax) dmax = d;
+    }
+  }
+  swe_set_analytical_cache(0);
+  CHECK_EQUALS_D(dmax, 0);
+  }
+
+TESTCASE(7,"swe_moshier_batch( ) - against swe_calc( )") {
+  /* 500 epochs 7.3 days apart in one call, against swe_calc() with 
+   * the same frame; maximum difference of position (AU) and speed 
+   * (AU/day) */
+  static double tjd[500], xb[500 * 6];
+  int i, k, ipl = GET_I(ipl), rc;
+  int32 iflgb = GET_I(iflag) | SEFLG_SPEED;
+  int32 iflgc = iflgb | SEFLG_MOSEPH | SEFLG_J2000 | SEFLG_XYZ | SEFLG_TRUEPOS;
+  double d, dmax = 0;
+  if (ipl != SE_MOON)
+    iflgc |= SEFLG_HELCTR;
+  for (i = 0; i < 500; i++)
+    tjd[i] = jd + i * 7.3;
+  rc = swe_moshier_batch(ipl, tjd, 500, iflgb, xb, serr);
+  CHECK_EQUALS_I(rc & (SEFLG_EQUATORIAL | SEFLG_ICRS), iflgb & (SEFLG_EQUATORIAL | SEFLG_ICRS));
+  for (i = 0; i < 500; i++) {
+    swe_calc(tjd[i], ipl, iflgc, xx, serr);
+    for (k = 0; k < 6; k++) {
+      d = fabs(xx[k] - xb[6 * i + k]);
+      if (d > dmax) dmax = d;
+    }
+  }
+  CHECK_EQUALS_D(dmax, 0);
+  }
+
+TESTCASE(8,"swe_set_analytical_cache( ) - segments before and after the grid origin") {
+  /* epochs in days from jd, which is the origin of the segment grid,
+   * in an order that revisits cached segments on both sides of it;
+   * maximum difference in arcsec */
+  static const double dt[] = {-20, 5, -20, -40, -10, 30, -40, -5, -36, 5};
+  double x0[10][2];
+  int i, ipl = GET_I(ipl);
+  double d, dmax = 0;
+  swe_set_analytical_cache(0);
+  for (i = 0; i < 10; i++) {
+    swe_calc(jd + dt[i], ipl, SEFLG_MOSEPH, xx, serr);
+    x0[i][0] = xx[0];
+    x0[i][1] = xx[1];
+  }
+  swe_set_analytical_cache(0.001);
+  for (i = 0; i < 10; i++) {
+    swe_calc(jd + dt[i], ipl, SEFLG_MOSEPH, xx, serr);
+    d = fabs(swe_difdeg2n(xx[0], x0[i][0])) * 3600;
+    if (d > dmax) dmax = d;
+    d = fabs(xx[1] - x0[i][1]) * 3600;
+    if (d > dmax) dmax = d;
+  }
+  swe_set_analytical_cache(0);
+  CHECK_EQUALS_D(dmax, 0);
+  }
+
+TESTCASE(9,"swe_set_asteroid_pool( ) - planetary moons in alternation") {
+  /* the moons computed in turn with npool files kept open, against 
+   * the files opened for each call; maximum difference and flags */
+  static const int ipl[] = {9606, 9801, 9607, 9901, 9608, 9704, 9902};
+  double x0[3][7][6];
+  int i, j, k, m, pass, rc, rc0[7];
+  double d, dmax = 0;
+  swe_set_asteroid_pool(0);
+  for (j = 0; j < 3; j++) {
+    for (i = 0; i < 7; i++)
+      rc0[i] = swe_calc(jd + j * 0.7, ipl[i], iephe | SEFLG_SPEED, x0[j][i], serr);
+  }
+  swe_set_asteroid_pool(GET_I(npool));
+  CHECK_EQUALS_I(swe_get_asteroid_pool(), GET_I(npool));
+  /* forward, then backward, so that the pool is reused and refilled */
+  for (pass = 0; pass < 2; pass++) {
+    for (j = 0; j < 3; j++) {
+      for (k = 0; k < 7; k++) {
+        i = (pass == 0) ? k : 6 - k;
+        rc = swe_calc(jd + j * 0.7, ipl[i], iephe | SEFLG_SPEED, xx, serr);
+        CHECK_EQUALS_I(rc, rc0[i]);
+        for (m = 0; m < 6; m++) {
+          d = fabs(xx[m] - x0[j][i][m]);
+          if (d > dmax) dmax = d;
+        }
+      }
+    }
+  }
+  swe_set_asteroid_pool(0);
+  CHECK_EQUALS_D(dmax, 0);
+  }
+
+TESTCASE(10,"swe_calc_batch( ) - against swe_calc( )") {
+  /* 200 epochs in mixed order, some of them twice, in one call, 
+   * against swe_calc() or swe_calc_ut() for each epoch; maximum 
+   * difference and flags */
+  static double tjd[200], xb[200 * 6];
+  int32 iflgb[200], iflgc = iflag | iephe;
+  int i, k, ipl = GET_I(ipl), ut = GET_I(ut), rc;
+  double d, dmax = 0;
+  for (i = 0; i < 200; i++)
+    tjd[i] = jd + ((i * 37) % 200) * 0.61;
+  for (i = 0; i < 200; i += 40)
+    tjd[i + 1] = tjd[i];
+  if (ut)
+    rc = swe_calc_batch_ut(ipl, tjd, 200, iflgc, xb, iflgb, serr);
+  else
+    rc = swe_calc_batch(ipl, tjd, 200, iflgc, xb, iflgb, serr);
+  for (i = 0; i < 200; i++) {
+    if (ut)
+      rc = swe_calc_ut(tjd[i], ipl, iflgc, xx, serr);
+    else
+      rc = swe_calc(tjd[i], ipl, iflgc, xx, serr);
+    CHECK_EQUALS_I(iflgb[i], rc);
+    for (k = 0; k < 6; k++) {
+      d = fabs(xx[k] - xb[6 * i + k]);
+      if (d > dmax) dmax = d;
+    }
+  }
+  CHECK_EQUALS_D(dmax, 0);
+  }
+
+TESTCASE(11,"swe_kepler_batch( ) - against a scalar solution") {
+  /* 300 bodies, i.e. more than one block, every 37th of them not on an 
+   * elliptic orbit, against Kepler's equation solved for each body 
+   * with Newton's method; maximum difference in AU or degrees */
+  static const int32 iflags[] = {
+    SEFLG_HELCTR | SEFLG_J2000 | SEFLG_XYZ,
+    SEFLG_J2000 | SEFLG_XYZ,
+    SEFLG_HELCTR | SEFLG_J2000,
+  };
+  static double elem[300 * SE_KEPLER_NELEM], xb[300 * 3];
+  double *el, xearth[6], x[3], a, e, dmot, M, E, dE, xo, yo, d, dmax = 0;
+  double si, ci, so, co, sp, cp, lon;
+  int i, j, k, rc;
+  for (i = 0; i < 300; i++) {
+    el = elem + i * SE_KEPLER_NELEM;
+    el[0] = 2460000.5;
+    el[1] = 1.5 + 0.011 * i;
+    el[2] = fmod(i * 0.137, 0.95);
+    el[3] = fmod(i * 7.3, 40);
+    el[4] = fmod(i * 97.1, 360);
+    el[5] = fmod(i * 211.7, 360);
+    el[6] = fmod(i * 53.9, 360);
+    el[7] = (i % 2) ? 0 : 0.9856076686 / el[1] / sqrt(el[1]);
+    if (i % 37 == 5)
+      el[2] = 1.2;
+    if (i % 37 == 20)
+      el[1] = -1;
+  }
+  rc = swe_calc(jd, SE_EARTH, iephe | SEFLG_HELCTR | SEFLG_J2000 | SEFLG_XYZ | SEFLG_TRUEPOS | SEFLG_NONUT, xearth, serr);
+  for (j = 0; j < 3; j++) {
+    rc = swe_kepler_batch(jd, 300, elem, iephe | iflags[j], xb, serr);
+    CHECK_EQUALS_I(rc & ~(SEFLG_JPLEPH | SEFLG_SWIEPH | SEFLG_MOSEPH), iflags[j]);
+    for (i = 0; i < 300; i++) {
+      el = elem + i * SE_KEPLER_NELEM;
+      a = el[1];
+      e = el[2];
+      if (a <= 0 || e >= 1) {
+        x[0] = x[1] = x[2] = 0;
+      } else {
+        dmot = el[7] != 0 ? el[7] : 0.9856076686 / a / sqrt(a);
+        M = fmod(el[6] + (jd - el[0]) * dmot, 360);
+        if (M < 0) M += 360;
+        M *= M_PI / 180;
+        E = (e < 0.8) ? M : M_PI;
+        for (k = 0; k < 100; k++) {
+          dE = (M + e * sin(E) - E) / (1 - e * cos(E));
+          E += dE;
+          if (fabs(dE) < 1e-15) break;
+        }
+        xo = a * (cos(E) - e);
+        yo = a * sqrt(1 - e * e) * sin(E);
+        si = sin(el[3] * M_PI / 180); ci = cos(el[3] * M_PI / 180);
+        so = sin(el[4] * M_PI / 180); co = cos(el[4] * M_PI / 180);
+        sp = sin(el[5] * M_PI / 180); cp = cos(el[5] * M_PI / 180);
+        x[0] = (cp * co - sp * ci * so) * xo + (-sp * co - cp * ci * so) * yo;
+        x[1] = (cp * so + sp * ci * co) * xo + (-sp * so + cp * ci * co) * yo;
+        x[2] = sp * si * xo + cp * si * yo;
+        if (!(iflags[j] & SEFLG_HELCTR)) {
+          for (k = 0; k < 3; k++)
+            x[k] -= xearth[k];
+        }
+        if (!(iflags[j] & SEFLG_XYZ)) {
+          d = sqrt(x[0] * x[0] + x[1] * x[1] + x[2] * x[2]);
+          lon = swe_degnorm(atan2(x[1], x[0]) * 180 / M_PI);
+          x[1] = asin(x[2] / d) * 180 / M_PI;
+          x[0] = lon;
+          x[2] = d;
+        }
+      }
+      for (k = 0; k < 3; k++) {
+        d = fabs(xb[3 * i + k] - x[k]);
+        if (k == 0 && !(iflags[j] & SEFLG_XYZ))
+          d = fabs(swe_difdeg2n(xb[3 * i + k], x[k]));
+        if (d > dmax) dmax = d;
+      }
+    }
+  }
+  CHECK_EQUALS_D(dmax, 0);
+  }
+
 END_TESTSUITE
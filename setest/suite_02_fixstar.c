@@ -96,4 +96,48 @@ TESTCASE(7,"Fixed stars (swe_fixstar2) with Universal Time") {
 
   }
 
+TESTCASE(8,"swe_fixstar2_catalog( ) - against swe_fixstar2( )") {
+  /* all stars of sefstars.txt up to magnitude 2.5, for each of the flags
+   * below; return flags, and maximum difference of magnitude, position
+   * and speed in the units of the flags, distances relative to the 
+   * distance of the star */
+  static const int32 iflags[] = {
+    SEFLG_SPEED,
+    SEFLG_SPEED | SEFLG_HELCTR,
+    SEFLG_SPEED | SEFLG_BARYCTR,
+    SEFLG_SPEED | SEFLG_TRUEPOS,
+    SEFLG_SPEED | SEFLG_EQUATORIAL | SEFLG_XYZ,
+    SEFLG_SPEED | SEFLG_SIDEREAL,
+    SEFLG_NOABERR | SEFLG_NOGDEFL,
+  };
+  static int32 istar[200];
+  static double xc[200 * 6], magc[200];
+  int32 i, j, k, n, rc2;
+  double d, r, mag, dmax = 0;
+  swe_set_ephe_path(NULL);
+  jd = GET_D(jd);
+  for (j = 0; j < (int32) (sizeof(iflags) / sizeof(iflags[0])); j++) {
+    iflag = iflags[j];
+    rc = swe_fixstar2_catalog(jd, iflag, 2.5, 200, istar, xc, magc, &n, serr);
+    CHECK_EQUALS_I(n > 0, 1);
+    for (i = 0; i < n; i++) {
+      sprintf(star, "%d", istar[i]);
+      rc2 = swe_fixstar2(star, jd, iflag, xx, serr);
+      CHECK_EQUALS_I(rc, rc2);
+      swe_fixstar2_mag(star, &mag, serr);
+      if (fabs(mag - magc[i]) > dmax) dmax = fabs(mag - magc[i]);
+      r = (iflag & SEFLG_XYZ) ? sqrt(xx[0] * xx[0] + xx[1] * xx[1] + xx[2] * xx[2]) : xx[2];
+      for (k = 0; k < 6; k++) {
+        d = xx[k] - xc[6 * i + k];
+        if (k == 0 && !(iflag & SEFLG_XYZ))
+          d = swe_difdeg2n(xx[k], xc[6 * i + k]);
+        if ((iflag & SEFLG_XYZ) || k == 2 || k == 5)
+          d /= r;
+        if (fabs(d) > dmax) dmax = fabs(d);
+      }
+    }
+  }
+  CHECK_EQUALS_D(dmax, 0);
+  }
+
 END_TESTSUITE
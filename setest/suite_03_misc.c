@@ -15,6 +15,127 @@ TESTCASE(2, "swe_get_aya_name( ) - Getting an ayanamsa name") {
   CHECK_S(name);
 }
 
+TESTCASE(3, "swe_set_nutation_simd( ) - against the scalar series") {
+  /* 2000 epochs 3.7 years apart, nutation of model nmodel with the 
+   * SIMD series, then again with the scalar series; maximum difference 
+   * in microarcsec of each against the scalar series computed first */
+  static double tjd[2000], dpsi0[2000], deps0[2000], dpsi[2000], deps[2000];
+  int i, k;
+  double d, dmax = 0, dmax_scalar = 0;
+  char smod[30], serr[255];
+  sprintf(smod, "0,0,0,%d,0,0,0,0", GET_I(nmodel));
+  swe_set_astro_models(smod, 0);
+  for (i = 0; i < 2000; i++)
+    tjd[i] = 2451545.0 + (i - 1000 + 0.37) * 3.7 * 365.25;
+  swe_nutation_batch(tjd, 2000, 0, dpsi0, deps0, serr);
+  for (k = 0; k < 2; k++) {
+    swe_set_nutation_simd(k == 0);
+    swe_nutation_batch(tjd, 2000, 0, dpsi, deps, serr);
+    for (i = 0; i < 2000; i++) {
+      d = fabs(dpsi[i] - dpsi0[i]) * 3600e6;
+      if (fabs(deps[i] - deps0[i]) * 3600e6 > d)
+        d = fabs(deps[i] - deps0[i]) * 3600e6;
+      if (k == 0 && d > dmax) dmax = d;
+      if (k == 1 && d > dmax_scalar) dmax_scalar = d;
+    }
+  }
+  swe_set_astro_models("", 0);
+  CHECK_EQUALS_D(dmax, 0);
+  CHECK_EQUALS_D(dmax_scalar, 0);
+}
+
+TESTCASE(4, "swe_set_nutation_table( ) - against the series") {
+  /* 2000 epochs spread over a table of 1990 - 2010 with nodes step days 
+   * apart; nutation and mean obliquity of swe_calc( ) with SE_ECL_NUT 
+   * against the series of model nmodel. The maximum errors in mas must 
+   * be within the bounds stated at swe_set_nutation_table( ) */
+  static double tjd[2000], dpsi0[2000], deps0[2000], eps0[2000];
+  int i, rc, dpsi_in_bound, deps_in_bound, eps_in_bound;
+  double x[6], d, dpsimax = 0, depsmax = 0, epsmax = 0, bound;
+  double tstart = 2447892.5, tend = 2455197.5, step = GET_D(step);
+  char smod[30], serr[255];
+  sprintf(smod, "0,0,0,%d,0,0,0,0", GET_I(nmodel));
+  swe_set_astro_models(smod, 0);
+  if (step >= 2)
+    bound = 4;
+  else if (step >= 1)
+    bound = 0.13;
+  else if (step >= 0.5)
+    bound = 0.006;
+  else
+    bound = 0.0003;
+  for (i = 0; i < 2000; i++) {
+    tjd[i] = tstart + (tend - tstart) * fmod((i + 1) * 0.618033988749895, 1);
+    swe_calc(tjd[i], SE_ECL_NUT, 0, x, serr);
+    eps0[i] = x[1];
+  }
+  swe_nutation_batch(tjd, 2000, 0, dpsi0, deps0, serr);
+  rc = swe_set_nutation_table(tstart, tend, step, 0, serr);
+  CHECK_EQUALS_I(rc, OK);
+  for (i = 0; i < 2000; i++) {
+    swe_calc(tjd[i], SE_ECL_NUT, 0, x, serr);
+    d = fabs(x[2] - dpsi0[i]) * 3600e3;
+    if (d > dpsimax) dpsimax = d;
+    d = fabs(x[3] - deps0[i]) * 3600e3;
+    if (d > depsmax) depsmax = d;
+    d = fabs(x[1] - eps0[i]) * 3600e3;
+    if (d > epsmax) epsmax = d;
+  }
+  swe_set_nutation_table(0, 0, 0, 0, serr);
+  swe_set_astro_models("", 0);
+  dpsi_in_bound = (dpsimax <= bound);
+  deps_in_bound = (depsmax <= bound);
+  eps_in_bound = (epsmax <= 1e-7);
+  CHECK_EQUALS_I(dpsi_in_bound, 1);
+  CHECK_EQUALS_I(deps_in_bound, 1);
+  CHECK_EQUALS_I(eps_in_bound, 1);
+}
+
+TESTCASE(5, "swe_set_prec_interpolation( ) - against exact precession") {
+  /* equatorial position vectors of the Sun of date, without nutation, 
+   * at 2000 epochs spread over -1000 - 2900 with precession model pmodel;
+   * maximum difference between interpolated and exact precession 
+   * matrices in mas, relative to the length of the vector, for tstep 
+   * 1, 10 and 100 days. It must be within 1.2e-5 mas * tstep * tstep, 
+   * as stated at swe_set_prec_interpolation( ) */
+  static double tjd[2000], x0[2000][3];
+  static const double tsteps[3] = {1, 10, 100};
+  int i, k, j, rc, in_bound = 1;
+  double x[6], d, r, dmax, tstep;
+  double tstart = 1355807.5, tend = 2780263.5;
+  int32 iflag = SEFLG_MOSEPH | SEFLG_EQUATORIAL | SEFLG_NONUT | SEFLG_XYZ;
+  char smod[30], serr[255];
+  sprintf(smod, "0,%d,%d,0,0,0,0,0", GET_I(pmodel), GET_I(pmodel));
+  swe_set_astro_models(smod, 0);
+  swe_set_prec_interpolation(0);
+  for (i = 0; i < 2000; i++) {
+    tjd[i] = tstart + (tend - tstart) * fmod((i + 1) * 0.618033988749895, 1);
+    rc = swe_calc(tjd[i], SE_SUN, iflag, x, serr);
+    for (j = 0; j < 3; j++)
+      x0[i][j] = x[j];
+  }
+  for (k = 0; k < 3; k++) {
+    tstep = tsteps[k];
+    swe_set_prec_interpolation(tstep);
+    dmax = 0;
+    for (i = 0; i < 2000; i++) {
+      swe_calc(tjd[i], SE_SUN, iflag, x, serr);
+      d = r = 0;
+      for (j = 0; j < 3; j++) {
+        d += (x[j] - x0[i][j]) * (x[j] - x0[i][j]);
+        r += x0[i][j] * x0[i][j];
+      }
+      d = sqrt(d / r) * RADTODEG * 3600e3;
+      if (d > dmax) dmax = d;
+    }
+    if (dmax > 1.2e-5 * tstep * tstep)
+      in_bound = 0;
+  }
+  swe_set_prec_interpolation(0);
+  swe_set_astro_models("", 0);
+  CHECK_EQUALS_I(rc, iflag);
+  CHECK_EQUALS_I(in_bound, 1);
+}
 
 END_TESTSUITE
 
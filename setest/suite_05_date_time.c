@@ -75,6 +75,33 @@ swe_set_ephe_path(NULL);
     CHECK_D(tjd_lmt);
   }
 
+  TESTCASE(7,"Delta T tables against the model functions") {
+    /* one epoch per year from -13000 to +17000, one per 10 days 
+     * from 1600 to 2100; maximum difference in seconds */
+    int i;
+    double tjd, dt0, dt1, d, dtmax = 0;
+    int iephe = GET_I(iephe);
+    char smod[30];
+    sprintf(smod, "%d,9,9,4,3,0,0,4", GET_I(dmodel));
+    swe_set_astro_models(smod, 0);
+    for (i = 0; i < 30000 + 18262; i++) {
+      if (i < 30000)
+        tjd = 2451545.0 + (i - 15000 + 0.37) * 365.25;
+      else
+        tjd = 2305447.5 + (i - 30000 + 0.37) * 10;
+      swe_set_deltat_table(TRUE);
+      dt1 = swe_deltat_ex(tjd, iephe, serr);
+      swe_set_deltat_table(FALSE);
+      dt0 = swe_deltat_ex(tjd, iephe, serr);
+      d = (dt1 - dt0) * 86400;
+      if (d < 0) d = -d;
+      if (d > dtmax) dtmax = d;
+    }
+    swe_set_deltat_table(FALSE);
+    swe_set_astro_models("", 0);
+    CHECK_EQUALS_D(dtmax, 0);
+  }
+
 
 
 
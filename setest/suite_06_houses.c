@@ -85,4 +85,143 @@ TESTCASE(9,"swe_houses_armc_ex2( ) - Koch and Placidus with cusp speeds") {
   check_swehouses_armc_ex2_results(rc,armc,ihsy,cusps,ascmc,cusp_speed,ascmc_speed,serr,ctx);
   }
 
+TESTCASE(10,"swe_houses_series( ) - against swe_houses_ex( )") {
+  /* 100 times step days apart; maximum difference of cusps and 
+   * angles in arcsec */
+  static double cs[100 * 13], as[100 * 10];
+  int32 i, k, n = 100;
+  double step = GET_D(step), d, dmax = 0;
+  rc = swe_houses_series(jd_ut, step, n, 0, geolat, geolon, ihsy, cs, as, NULL, serr);
+  CHECK_I(rc);
+  for (i = 0; i < n; i++) {
+    swe_houses_ex(jd_ut + i * step, 0, geolat, geolon, ihsy, cusps, ascmc);
+    for (k = 1; k <= 12; k++) {
+      d = fabs(swe_difdeg2n(cs[i * 13 + k], cusps[k])) * 3600;
+      if (d > dmax) dmax = d;
+    }
+    for (k = 0; k < SE_NASCMC; k++) {
+      d = fabs(swe_difdeg2n(as[i * 10 + k], ascmc[k])) * 3600;
+      if (d > dmax) dmax = d;
+    }
+  }
+  CHECK_EQUALS_D(dmax, 0);
+  }
+TESTCASE(11,"swe_houses_cross( ) - times against swe_houses_ex( )") {
+  /* crossings of a point over x2cross within 3 days, in direct or 
+   * retrograde motion; the time in seconds until the point reaches 
+   * x2cross with its speed from swe_houses_ex2( ) */
+  double tret[10], x2cross = GET_D(x2cross), d, v, dmax = 0;
+  double cusp_speed[37], ascmc_speed[10];
+  int32 i, nret, ipoint = GET_I(ipoint);
+  rc = swe_houses_cross(jd_ut, jd_ut + 3, 0, geolat, geolon, ihsy, ipoint, x2cross, tret, 10, &nret, serr);
+  CHECK_I(rc);
+  CHECK_I(nret);
+  for (i = 0; i < nret; i++) {
+    swe_houses_ex2(tret[i], 0, geolat, geolon, ihsy, cusps, ascmc, cusp_speed, ascmc_speed, serr);
+    if (ipoint >= SE_HOUSES_ANGLE) {
+      d = ascmc[ipoint - SE_HOUSES_ANGLE];
+      v = ascmc_speed[ipoint - SE_HOUSES_ANGLE];
+    } else {
+      d = cusps[ipoint];
+      v = cusp_speed[ipoint];
+    }
+    d = fabs(swe_difdeg2n(d, x2cross) / v) * 86400;
+    if (d > dmax) dmax = d;
+  }
+  CHECK_EQUALS_D(dmax, 0);
+  }
+
+TESTCASE(12,"swe_houses_grid( ) - against swe_houses_ex( )") {
+  /* 5 x 5 points from latitude -75 and longitude -120; return code of
+   * each point and maximum difference of cusps and angles in degrees */
+  static double cs[25 * 37], as[25 * 10];
+  int32 cellret[25], i, k, ilat, ilon, ncusp, ito;
+  int32 iflag = GET_I(iflag);
+  double d, dmax = 0, fac = (iflag & SEFLG_RADIANS) ? RADTODEG : 1;
+  ito = (ihsy == 'G') ? 36 : 12;
+  ncusp = ito + 1;
+  if (iflag & SEFLG_SIDEREAL)
+    swe_set_sid_mode(SE_SIDM_LAHIRI, 0, 0);
+  swe_houses_grid(jd_ut, iflag, ihsy, -75, 37.5, 5, -120, 60, 5, cs, as, cellret, serr);
+  for (ilat = 0; ilat < 5; ilat++) {
+    for (ilon = 0; ilon < 5; ilon++) {
+      i = ilat * 5 + ilon;
+      rc = swe_houses_ex(jd_ut, iflag, -75 + ilat * 37.5, -120 + ilon * 60, ihsy, cusps, ascmc);
+      CHECK_EQUALS_I(cellret[i], rc < 0 ? ERR : OK);
+      for (k = 1; k <= ito; k++) {
+        d = fabs(swe_difdeg2n(cs[i * ncusp + k] * fac, cusps[k] * fac));
+        if (d > dmax) dmax = d;
+      }
+      for (k = 0; k < SE_NASCMC; k++) {
+        d = fabs(swe_difdeg2n(as[i * 10 + k] * fac, ascmc[k] * fac));
+        if (d > dmax) dmax = d;
+      }
+    }
+  }
+  CHECK_EQUALS_D(dmax, 0);
+  }
+
+TESTCASE(13,"swe_houses_multi( ) - against swe_houses_ex2( )") {
+  /* seven house systems in one call; return code of each system and
+   * maximum difference of cusps, angles and their speeds */
+  static const int hsys[7] = {'P', 'K', 'W', 'G', 'I', 'B', 'Y'};
+  static double cs[7 * 37], as[7 * 10], css[7 * 37], ass[7 * 10];
+  int32 sysret[7], j, k, ito;
+  int32 iflag = GET_I(iflag);
+  double d, dmax = 0, fac = (iflag & SEFLG_RADIANS) ? RADTODEG : 1;
+  if (iflag & SEFLG_SIDEREAL)
+    swe_set_sid_mode(SE_SIDM_LAHIRI, 0, 0);
+  swe_houses_multi(jd_ut, iflag, geolat, geolon, 7, hsys, cs, as, css, ass, sysret, serr);
+  for (j = 0; j < 7; j++) {
+    ito = (hsys[j] == 'G') ? 36 : 12;
+    rc = swe_houses_ex2(jd_ut, iflag, geolat, geolon, hsys[j], cusps, ascmc, cusp_speed, ascmc_speed, serr);
+    CHECK_EQUALS_I(sysret[j], rc < 0 ? ERR : OK);
+    for (k = 1; k <= ito; k++) {
+      d = fabs(swe_difdeg2n(cs[j * 37 + k] * fac, cusps[k] * fac));
+      if (d > dmax) dmax = d;
+      d = fabs(css[j * 37 + k] - cusp_speed[k]);
+      if (d > dmax) dmax = d;
+    }
+    for (k = 0; k < SE_NASCMC; k++) {
+      d = fabs(swe_difdeg2n(as[j * 10 + k] * fac, ascmc[k] * fac));
+      if (d > dmax) dmax = d;
+      d = fabs(ass[j * 10 + k] - ascmc_speed[k]);
+      if (d > dmax) dmax = d;
+    }
+  }
+  CHECK_EQUALS_D(dmax, 0);
+  }
+
+TESTCASE(14,"swe_house_pos_batch( ) - against swe_house_pos( )") {
+  /* the bodies Sun ... Pluto and the lunar node, and points on a 
+   * net of longitudes and latitudes; maximum difference of the house
+   * positions */
+  static double xp[(11 + 72 * 5) * 2], hp[11 + 72 * 5];
+  int32 i, k, n = 0;
+  double eps, d, dmax = 0;
+  rc = swe_calc_ut(jd_ut, SE_ECL_NUT, 0, xx, serr);
+  eps = xx[0];
+  armc = swe_degnorm(swe_sidtime(jd_ut) * 15 + geolon);
+  for (i = SE_SUN; i <= SE_TRUE_NODE; i++) {
+    swe_calc_ut(jd_ut, i, 0, xx, serr);
+    xp[2 * n] = xx[0];
+    xp[2 * n + 1] = xx[1];
+    n++;
+  }
+  for (i = 0; i < 72; i++) {
+    for (k = 0; k < 5; k++) {
+      xp[2 * n] = i * 5 + 0.3;
+      xp[2 * n + 1] = -60 + k * 30;
+      n++;
+    }
+  }
+  rc = swe_house_pos_batch(armc, geolat, eps, ihsy, n, xp, hp, serr);
+  CHECK_I(rc);
+  for (i = 0; i < n; i++) {
+    d = fabs(hp[i] - swe_house_pos(armc, geolat, eps, ihsy, xp + 2 * i, serr));
+    if (d > dmax) dmax = d;
+  }
+  CHECK_EQUALS_D(dmax, 0);
+  }
+
 END_TESTSUITE
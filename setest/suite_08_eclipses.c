@@ -114,4 +114,77 @@ TESTCASE(10,"swe_lun_eclipse_how( ) ") {
   CHECK_DD(xxattr,11);
   }
 
+TESTCASE(11,"swe_sol_eclipse_when_glob_cat( ) - against the live search") {
+  /* 10 eclipses in a row from a catalog written for the test; return 
+   * flags, maximum difference of the contacts in seconds, of the 
+   * attributes and of the geographic position of maximum, and the 
+   * number of eclipses taken from the catalog */
+  double tret[10], attr[20], geopos[2], ltret[10], lgeo[20], lattr[20], tmax[10];
+  double d, dmax = 0;
+  int32 i, k, rc2, ncat, iephe = GET_I(iephe), ifltype = GET_I(ifltype), backward = GET_I(backward);
+  jd = GET_D(jd);
+  rc = open_test_eclipse_catalog(jd, iephe, serr);
+  CHECK_EQUALS_I(rc, OK);
+  if (rc == ERR) {
+    close_test_eclipse_catalog();
+    return;
+  }
+  for (i = 0; i < 10; i++) {
+    rc = swe_sol_eclipse_when_glob_cat(jd, iephe, ifltype, tret, attr, geopos, backward, serr);
+    rc2 = swe_sol_eclipse_when_glob(jd, iephe, ifltype, ltret, backward, serr);
+    swe_sol_eclipse_where(ltret[0], iephe, lgeo, lattr, serr);
+    CHECK_EQUALS_I(rc, rc2);
+    for (k = 0; k < 8; k++) {
+      d = fabs(tret[k] - ltret[k]) * 86400;
+      if (d > dmax) dmax = d;
+    }
+    for (k = 0; k < 11; k++) {
+      d = fabs(attr[k] - lattr[k]);
+      if (d > dmax) dmax = d;
+    }
+    for (k = 0; k < 2; k++) {
+      d = fabs(geopos[k] - lgeo[k]);
+      if (d > dmax) dmax = d;
+    }
+    jd = tmax[i] = tret[0];
+  }
+  ncat = eclipses_in_test_catalog(tmax, 10, iephe);
+  close_test_eclipse_catalog();
+  CHECK_EQUALS_D(dmax, 0);
+  CHECK_EQUALS_I(ncat, 10);
+  }
+
+TESTCASE(12,"swe_lun_eclipse_when_cat( ) - against the live search") {
+  /* as case 11, with lunar eclipses and their attributes */
+  double tret[10], attr[20], ltret[10], lattr[20], tmax[10];
+  double d, dmax = 0;
+  int32 i, k, rc2, ncat, iephe = GET_I(iephe), ifltype = GET_I(ifltype), backward = GET_I(backward);
+  jd = GET_D(jd);
+  rc = open_test_eclipse_catalog(jd, iephe, serr);
+  CHECK_EQUALS_I(rc, OK);
+  if (rc == ERR) {
+    close_test_eclipse_catalog();
+    return;
+  }
+  for (i = 0; i < 10; i++) {
+    rc = swe_lun_eclipse_when_cat(jd, iephe, ifltype, tret, attr, backward, serr);
+    rc2 = swe_lun_eclipse_when(jd, iephe, ifltype, ltret, backward, serr);
+    swe_lun_eclipse_how(ltret[0], iephe, NULL, lattr, serr);
+    CHECK_EQUALS_I(rc, rc2);
+    for (k = 0; k < 8; k++) {
+      d = fabs(tret[k] - ltret[k]) * 86400;
+      if (d > dmax) dmax = d;
+    }
+    for (k = 0; k < 11; k++) {
+      d = fabs(attr[k] - lattr[k]);
+      if (d > dmax) dmax = d;
+    }
+    jd = tmax[i] = tret[0];
+  }
+  ncat = eclipses_in_test_catalog(tmax, 10, iephe);
+  close_test_eclipse_catalog();
+  CHECK_EQUALS_D(dmax, 0);
+  CHECK_EQUALS_I(ncat, 10);
+  }
+
 END_TESTSUITE
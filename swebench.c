@@ -0,0 +1,870 @@
+/********************************************************************
+swebench.c	
+
+Micro-benchmarks of time critical routines of the Swiss Ephemeris.
+
+usage:	swebench [-nN] [-eDIR] [test ...]
+options: -nN	number of evaluations per test (default 1000000)
+	 -eDIR	ephemeris directory, where sefstars.txt and the files
+		of the planetary moons are searched
+tests:	 cheb	Chebyshev series of x, y, z with derivatives:
+		swi_echeb() and swi_edcheb() per coordinate, as sweph()
+		evaluated them formerly, against swi_echeb_xyz_scalar() and
+		swi_echeb_xyz() with the kernel selected for this CPU.
+		The maximum difference from the first method is shown.
+	 nut	nutation IAU 2000A and 2000B, the series evaluated with 
+		the scalar code and with the SIMD kernel, 
+		swi_nutation_iau2000ab(); n / 100 evaluations.
+	 prec	precession J2000 -> date of a vector in steps of one minute,
+		with matrices for every epoch and interpolated between
+		matrices one day apart, s. swe_set_prec_interpolation();
+		models Vondrak 2011, IAU 2006 and Simon 1994.
+	 mosh	Moshier planet theory, swi_moshplan2() for each epoch 
+		against swi_moshplan2_batch() with the kernel selected for
+		this CPU; n / 100 evaluations per planet.
+	 moon	Moshier lunar theory, swi_moshmoon2() for each epoch 
+		against swi_moshmoon2_batch() with the kernel selected for
+		this CPU; n / 100 evaluations.
+	 fit	Moshier Moon and Mars in steps of one hour, from the theory 
+		and from Chebyshev fits of it, s. swe_set_analytical_cache(),
+		with a precision of 0.001 arcsec; n / 10 evaluations.
+	 stars	apparent positions of all stars of sefstars.txt with 
+		swe_fixstar2() per star, against swe_fixstar2_catalog(),
+		one day apart; n / 10000 epochs.
+	 ast	planetary moons of the files in sat/ in alternation, i.e.
+		single body files that share one file slot, one day apart, 
+		without and with the pool of open files, s. 
+		swe_set_asteroid_pool(); n / 1000 epochs.
+	 kep	Keplerian positions of n asteroids with swe_kepler_batch(),
+		copies of the osculating elements of Ceres ... Pholus with
+		other mean anomalies; the maximum difference from swe_calc()
+		at the epoch of the elements is shown.
+	 grid	houses Placidus and Porphyry for a world grid of 1 x 1 
+		degrees, swe_houses_ex() per point against 
+		swe_houses_grid(); n / 1000000 grids.
+	 multi	houses of all house systems for one chart, swe_houses_ex2()
+		per system against swe_houses_multi(); n / 1000 charts.
+	 hpos	house positions of 1000 points in Placidus, Koch and 
+		Gauquelin sectors, swe_house_pos() per point against 
+		swe_house_pos_batch(); n / 1000 frames.
+	 series	houses Placidus and Porphyry in steps of one minute, 
+		swe_houses_ex() per minute against swe_houses_series();
+		n / 100 minutes.
+	 ecl	the next solar and lunar eclipses with attributes, one after
+		the other from 1 Jan 2000, with swe_sol_eclipse_when_glob() 
+		and swe_lun_eclipse_when() against the eclipse catalog, 
+		s. swe_sol_eclipse_when_glob_cat(); n / 10000 eclipses of
+		each kind. The catalog seeclips.sec must be in the 
+		ephemeris path, s. swephunp.c.
+Without test names all tests are run.
+
+example: swebench -n5000000 cheb
+
+*********************************************************************/
+/* Copyright (C) 1997 - 2021 Astrodienst AG, Switzerland.  All rights reserved.
+
+  License conditions
+  ------------------
+
+  This file is part of Swiss Ephemeris.
+
+  Swiss Ephemeris is distributed with NO WARRANTY OF ANY KIND.  No author
+  or distributor accepts any responsibility for the consequences of using it,
+  or for whether it serves any particular purpose or works at all, unless he
+  or she says so in writing.  
+
+  Swiss Ephemeris is made available by its authors under a dual licensing
+  system. The software developer, who uses any part of Swiss Ephemeris
+  in his or her software, must choose between one of the two license models,
+  which are
+  a) GNU Affero General Public License (AGPL)
+  b) Swiss Ephemeris Professional License
+
+  The choice must be made before the software developer distributes software
+  containing parts of Swiss Ephemeris to others, and before any public
+  service using the developed software is activated.
+
+  If the developer choses the AGPL software license, he or she must fulfill
+  the conditions of that license, which includes the obligation to place his
+  or her whole software project under the AGPL or a compatible license.
+  See https://www.gnu.org/licenses/agpl-3.0.html
+
+  If the developer choses the Swiss Ephemeris Professional license,
+  he must follow the instructions as found in http://www.astro.com/swisseph/ 
+  and purchase the Swiss Ephemeris Professional Edition from Astrodienst
+  and sign the corresponding license contract.
+
+  The License grants you the right to use, copy, modify and redistribute
+  Swiss Ephemeris, but only under certain conditions described in the License.
+  Among other things, the License requires that the copyright notices and
+  this notice be preserved on all copies.
+
+  Authors of the Swiss Ephemeris: Dieter Koch and Alois Treindl
+
+  The authors of Swiss Ephemeris have no control or influence over any of
+  the derived works, i.e. over software or services created by other
+  programmers which use Swiss Ephemeris functions.
+
+  The names of the authors or of the copyright holder (Astrodienst) must not
+  be used for promoting any software, product or service which uses or contains
+  the Swiss Ephemeris. This copyright notice is the ONLY place where the
+  names of the authors can legally appear, except in cases where they have
+  given special permission in writing.
+
+  The trademarks 'Swiss Ephemeris' and 'Swiss Ephemeris inside' may be used
+  for promoting such software, products or services.
+*/
+
+# include <stdlib.h>
+# include <string.h>
+# include <time.h>
+# include <math.h>
+# include "swephexp.h"
+# include "sweph.h"
+# include "swephlib.h"
+
+static char *arg0;
+
+/* seconds since first call */
+static double cpu_time(void)
+{
+  return (double) clock() / CLOCKS_PER_SEC;
+}
+
+/* numbers of coefficients as found in the SWISSEPH files */
+static const int cheb_ncoe[] = {10, 14, 18, 26, 38};
+
+#define CHEB_NSETS	64	/* coefficient sets, i.e. segments, per test */
+
+static int bench_cheb(long n)
+{
+  int i, k, m, ncf, nstride;
+  long l;
+  double *coef, *tx, dmax, t0, tsec[3], sum[3];
+  double xp[6], xr[6];
+  static const char *meth[3] = {"swi_echeb + swi_edcheb", "swi_echeb_xyz_scalar", "swi_echeb_xyz"};
+  printf("cheb: kernel %s, %ld evaluations\n", swi_simd_name(), n);
+  nstride = cheb_ncoe[sizeof(cheb_ncoe) / sizeof(int) - 1];
+  coef = (double *) malloc((size_t) CHEB_NSETS * 3 * nstride * sizeof(double));
+  tx = (double *) malloc((size_t) n * sizeof(double));
+  if (coef == NULL || tx == NULL) {
+    fprintf(stderr, "%s: error in malloc()\n", arg0);
+    return 1;
+  }
+  /* decreasing coefficients as in a real series; random arguments */
+  srand(1);
+  for (i = 0; i < CHEB_NSETS * 3 * nstride; i++) 
+    coef[i] = ((double) rand() / RAND_MAX - 0.5) * pow(0.3, i % nstride);
+  for (l = 0; l < n; l++)
+    tx[l] = 2.0 * rand() / RAND_MAX - 1;
+  for (k = 0; k < (int) (sizeof(cheb_ncoe) / sizeof(int)); k++) {
+    ncf = cheb_ncoe[k];
+    /* maximum difference from swi_echeb()/swi_edcheb() */
+    dmax = 0;
+    for (l = 0; l < 10000 && l < n; l++) {
+      double *cp = coef + (l % CHEB_NSETS) * 3 * nstride;
+      for (i = 0; i < 3; i++) {
+	xr[i] = swi_echeb(tx[l], cp + i * nstride, ncf);
+	xr[i+3] = swi_edcheb(tx[l], cp + i * nstride, ncf);
+      }
+      swi_echeb_xyz(tx[l], cp, ncf, nstride, xp, xp + 3);
+      for (i = 0; i < 6; i++) 
+	if (fabs(xp[i] - xr[i]) > dmax)
+	  dmax = fabs(xp[i] - xr[i]);
+    }
+    for (m = 0; m < 3; m++) {
+      sum[m] = 0;
+      t0 = cpu_time();
+      for (l = 0; l < n; l++) {
+	double *cp = coef + (l % CHEB_NSETS) * 3 * nstride;
+	switch (m) {
+	  case 0:
+	    for (i = 0; i < 3; i++) {
+	      xp[i] = swi_echeb(tx[l], cp + i * nstride, ncf);
+	      xp[i+3] = swi_edcheb(tx[l], cp + i * nstride, ncf);
+	    }
+	    break;
+	  case 1:
+	    swi_echeb_xyz_scalar(tx[l], cp, ncf, nstride, xp, xp + 3);
+	    break;
+	  default:
+	    swi_echeb_xyz(tx[l], cp, ncf, nstride, xp, xp + 3);
+	    break;
+	}
+	sum[m] += xp[0] + xp[4];
+      }
+      tsec[m] = cpu_time() - t0;
+    }
+    printf("  ncoe %2d:", ncf);
+    for (m = 0; m < 3; m++)
+      printf("  %s %6.1f ns", meth[m], tsec[m] * 1e9 / n);
+    printf("  speedup %.2f, max. diff %g\n", tsec[2] > 0 ? tsec[0] / tsec[2] : 0, dmax);
+    if (sum[0] != sum[2] && dmax == 0)
+      printf("  (checksums differ)\n");
+  }
+  free(coef);
+  free(tx);
+  return 0;
+}
+
+/* the nutation series is slow; one evaluation per 100 of n */
+static int bench_nut(long n)
+{
+  int k, m, simd;
+  long l, nep = n / 100 + 1;
+  double *tjd, dmax, t0, tsec[2], nutlo[2], nutref[2];
+  static const int model[2] = {SEMOD_NUT_IAU_2000A, SEMOD_NUT_IAU_2000B};
+  static const char *mname[2] = {"2000A", "2000B"};
+  printf("nut: kernel %s, %ld evaluations\n", swi_simd_name(), nep);
+  tjd = (double *) malloc((size_t) nep * sizeof(double));
+  if (tjd == NULL) {
+    fprintf(stderr, "%s: error in malloc()\n", arg0);
+    return 1;
+  }
+  /* epochs between 3000 BC and 3000 AD */
+  srand(1);
+  for (l = 0; l < nep; l++)
+    tjd[l] = J2000 + (2.0 * rand() / RAND_MAX - 1) * 5000 * 365.25;
+  for (k = 0; k < 2; k++) {
+    /* maximum difference from the scalar code, in microarcsec */
+    dmax = 0;
+    for (l = 0; l < 10000 && l < nep; l++) {
+      swi_nutation_iau2000ab(tjd[l], model[k], SWI_SIMD_SCALAR, nutref);
+      swi_nutation_iau2000ab(tjd[l], model[k], swi_simd_level(), nutlo);
+      for (m = 0; m < 2; m++)
+	if (fabs(nutlo[m] - nutref[m]) * RADTODEG * 3600e6 > dmax)
+	  dmax = fabs(nutlo[m] - nutref[m]) * RADTODEG * 3600e6;
+    }
+    for (m = 0; m < 2; m++) {
+      simd = (m == 0) ? SWI_SIMD_SCALAR : swi_simd_level();
+      t0 = cpu_time();
+      for (l = 0; l < nep; l++)
+	swi_nutation_iau2000ab(tjd[l], model[k], simd, nutlo);
+      tsec[m] = cpu_time() - t0;
+    }
+    printf("  %s:  scalar %8.0f ns  %s %8.0f ns  speedup %.2f, max. diff %g microarcsec\n", 
+      mname[k], tsec[0] * 1e9 / nep, swi_simd_name(), tsec[1] * 1e9 / nep, 
+      tsec[1] > 0 ? tsec[0] / tsec[1] : 0, dmax);
+  }
+  free(tjd);
+  return 0;
+}
+
+/* a sweep in steps of one minute, as with intraday searches */
+static int bench_prec(long n)
+{
+  int k, m, i;
+  long l;
+  double x[3], xref[3], dmax, t0, tsec[2], sum[2], tjd;
+  char smod[40];
+  static const int model[3] = {SEMOD_PREC_VONDRAK_2011, SEMOD_PREC_IAU_2006, SEMOD_PREC_SIMON_1994};
+  static const char *mname[3] = {"Vondrak 2011", "IAU 2006", "Simon 1994"};
+  printf("prec: %ld evaluations\n", n);
+  for (k = 0; k < 3; k++) {
+    sprintf(smod, "0,%d,%d", model[k], model[k]);
+    swe_set_astro_models(smod, 0);
+    /* maximum difference of the interpolated matrix, in milliarcsec */
+    dmax = 0;
+    for (l = 0; l < 10000 && l < n; l++) {
+      tjd = J2000 + 1000.3 + l / 1440.0;
+      xref[0] = x[0] = 0.6; xref[1] = x[1] = 0.48; xref[2] = x[2] = 0.64;
+      swe_set_prec_interpolation(0);
+      swi_precess(xref, tjd, 0, -1);
+      swe_set_prec_interpolation(1);
+      swi_precess(x, tjd, 0, -1);
+      for (i = 0; i < 3; i++)
+	if (fabs(x[i] - xref[i]) * RADTODEG * 3600e3 > dmax)
+	  dmax = fabs(x[i] - xref[i]) * RADTODEG * 3600e3;
+    }
+    for (m = 0; m < 2; m++) {
+      swe_set_prec_interpolation(m == 0 ? 0 : 1);
+      sum[m] = 0;
+      t0 = cpu_time();
+      for (l = 0; l < n; l++) {
+	x[0] = 0.6; x[1] = 0.48; x[2] = 0.64;
+	swi_precess(x, J2000 + 1000.3 + l / 1440.0, 0, -1);
+	sum[m] += x[0];
+      }
+      tsec[m] = cpu_time() - t0;
+    }
+    printf("  %-12s  exact %6.1f ns  interpolated %6.1f ns  speedup %.2f, max. diff %g milliarcsec\n", 
+      mname[k], tsec[0] * 1e9 / n, tsec[1] * 1e9 / n, 
+      tsec[1] > 0 ? tsec[0] / tsec[1] : 0, dmax);
+  }
+  swe_set_prec_interpolation(0);
+  swe_set_astro_models("", 0);
+  return 0;
+}
+
+static int bench_mosh(long n)
+{
+  int iplm;
+  long l, nep = n / 100 + 1;
+  double *tjd, *p0, *p1, dmax, t0, tsec[2];
+  static const char *pname[9] = {"Mercury", "Venus", "EMB", "Mars", "Jupiter", "Saturn", "Uranus", "Neptune", "Pluto"};
+  printf("mosh: kernel %s, %ld evaluations\n", swi_simd_name(), nep);
+  tjd = (double *) malloc((size_t) nep * 7 * sizeof(double));
+  if (tjd == NULL) {
+    fprintf(stderr, "%s: error in malloc()\n", arg0);
+    return 1;
+  }
+  p0 = tjd + nep;
+  p1 = p0 + 3 * nep;
+  /* epochs between 3000 BC and 3000 AD */
+  srand(1);
+  for (l = 0; l < nep; l++)
+    tjd[l] = J2000 + (2.0 * rand() / RAND_MAX - 1) * 5000 * 365.25;
+  for (iplm = 0; iplm < 9; iplm++) {
+    t0 = cpu_time();
+    for (l = 0; l < nep; l++)
+      swi_moshplan2(tjd[l], iplm, p0 + 3 * l);
+    tsec[0] = cpu_time() - t0;
+    t0 = cpu_time();
+    swi_moshplan2_batch(tjd, (int) nep, iplm, swi_simd_level(), p1);
+    tsec[1] = cpu_time() - t0;
+    /* maximum difference in arcsec, of the radius relative */
+    dmax = 0;
+    for (l = 0; l < 3 * nep; l++) {
+      double d = fabs(p1[l] - p0[l]) * (l % 3 == 2 ? 1 / p0[l] : RADTODEG * 3600);
+      if (d > dmax)
+	dmax = d;
+    }
+    printf("  %-8s  single %6.0f ns  batch %6.0f ns  speedup %.2f, max. diff %g arcsec\n", 
+      pname[iplm], tsec[0] * 1e9 / nep, tsec[1] * 1e9 / nep, 
+      tsec[1] > 0 ? tsec[0] / tsec[1] : 0, dmax);
+  }
+  free(tjd);
+  return 0;
+}
+
+static int bench_moon(long n)
+{
+  long l, nep = n / 100 + 1;
+  double *tjd, *p0, *p1, dmax, d, t0, tsec[2];
+  struct moshmoon_state *ms;
+  printf("moon: kernel %s, %ld evaluations\n", swi_simd_name(), nep);
+  tjd = (double *) malloc((size_t) nep * 7 * sizeof(double));
+  ms = (struct moshmoon_state *) malloc(sizeof(struct moshmoon_state));
+  if (tjd == NULL || ms == NULL) {
+    fprintf(stderr, "%s: error in malloc()\n", arg0);
+    return 1;
+  }
+  p0 = tjd + nep;
+  p1 = p0 + 3 * nep;
+  /* epochs between 3000 BC and 3000 AD */
+  srand(1);
+  for (l = 0; l < nep; l++)
+    tjd[l] = J2000 + (2.0 * rand() / RAND_MAX - 1) * 5000 * 365.25;
+  t0 = cpu_time();
+  for (l = 0; l < nep; l++)
+    swi_moshmoon2(tjd[l], p0 + 3 * l);
+  tsec[0] = cpu_time() - t0;
+  t0 = cpu_time();
+  swi_moshmoon2_batch(tjd, (int) nep, swi_simd_level(), ms, p1);
+  tsec[1] = cpu_time() - t0;
+  /* maximum difference in arcsec, of the radius relative */
+  dmax = 0;
+  for (l = 0; l < 3 * nep; l++) {
+    d = fabs(p1[l] - p0[l]) * (l % 3 == 2 ? 1 / p0[l] : RADTODEG * 3600);
+    if (d > dmax)
+      dmax = d;
+  }
+  printf("  single %6.0f ns  batch %6.0f ns  speedup %.2f, max. diff %g arcsec\n", 
+    tsec[0] * 1e9 / nep, tsec[1] * 1e9 / nep, 
+    tsec[1] > 0 ? tsec[0] / tsec[1] : 0, dmax);
+  free(ms);
+  free(tjd);
+  return 0;
+}
+
+static int bench_fit(long n)
+{
+  int k;
+  long l, nep = n / 10 + 1;
+  double *p0, *p1, dmax, d, t0, tsec[2];
+  static const char *fname[] = {"moon", "mars"};
+  p0 = (double *) malloc((size_t) nep * 6 * sizeof(double));
+  if (p0 == NULL) {
+    fprintf(stderr, "%s: error in malloc()\n", arg0);
+    return 1;
+  }
+  p1 = p0 + 3 * nep;
+  printf("fit: %ld evaluations\n", nep);
+  for (k = 0; k < 2; k++) {
+    swe_set_analytical_cache(0);
+    t0 = cpu_time();
+    for (l = 0; l < nep; l++) {
+      if (k == 0)
+	swi_moshmoon2(J2000 + l / 24.0, p0 + 3 * l);
+      else
+	swi_moshplan2(J2000 + l / 24.0, 3, p0 + 3 * l);
+    }
+    tsec[0] = cpu_time() - t0;
+    swe_set_analytical_cache(0.001);
+    t0 = cpu_time();
+    for (l = 0; l < nep; l++) {
+      if (k == 0)
+	swi_moshmoon2(J2000 + l / 24.0, p1 + 3 * l);
+      else
+	swi_moshplan2(J2000 + l / 24.0, 3, p1 + 3 * l);
+    }
+    tsec[1] = cpu_time() - t0;
+    swe_set_analytical_cache(0);
+    /* maximum difference in arcsec, of the radius relative */
+    dmax = 0;
+    for (l = 0; l < 3 * nep; l++) {
+      if (l % 3 == 0)
+	d = fabs(swe_difrad2n(p1[l], p0[l])) * RADTODEG * 3600;
+      else
+	d = fabs(p1[l] - p0[l]) * (l % 3 == 2 ? 1 / p0[l] : RADTODEG * 3600);
+      if (d > dmax)
+	dmax = d;
+    }
+    printf("  %s: theory %6.0f ns  fitted %6.0f ns  speedup %.2f, max. diff %g arcsec\n", 
+      fname[k], tsec[0] * 1e9 / nep, tsec[1] * 1e9 / nep, 
+      tsec[1] > 0 ? tsec[0] / tsec[1] : 0, dmax);
+  }
+  free(p0);
+  return 0;
+}
+
+#define BENCH_NSTARS	100000	/* more than the stars in sefstars.txt */
+
+static int bench_stars(long n)
+{
+  int32 i, k, nstar = 0, iflag = SEFLG_SWIEPH | SEFLG_SPEED;
+  long l, nep = n / 10000 + 1;
+  int32 *istar;
+  double *xx, x[6], dmax = 0, d, t0, tsec[2];
+  char star[AS_MAXCH], serr[AS_MAXCH];
+  istar = (int32 *) malloc((size_t) BENCH_NSTARS * sizeof(int32));
+  xx = (double *) malloc((size_t) BENCH_NSTARS * 6 * sizeof(double));
+  if (istar == NULL || xx == NULL) {
+    fprintf(stderr, "%s: error in malloc()\n", arg0);
+    return 1;
+  }
+  if (swe_fixstar2_catalog(J2000, iflag, 99, BENCH_NSTARS, istar, xx, NULL, &nstar, serr) == ERR || nstar == 0) {
+    fprintf(stderr, "%s: stars: %s\n", arg0, serr);
+    free(istar);
+    free(xx);
+    return 1;
+  }
+  printf("stars: kernel %s, %ld epochs, %d stars\n", swi_simd_name(), nep, nstar);
+  t0 = cpu_time();
+  for (l = 0; l < nep; l++) {
+    for (k = 0; k < nstar; k++) {
+      sprintf(star, "%d", istar[k]);
+      swe_fixstar2(star, J2000 + l, iflag, x, serr);
+    }
+  }
+  tsec[0] = cpu_time() - t0;
+  t0 = cpu_time();
+  for (l = 0; l < nep; l++) 
+    swe_fixstar2_catalog(J2000 + l, iflag, 99, BENCH_NSTARS, istar, xx, NULL, &nstar, serr);
+  tsec[1] = cpu_time() - t0;
+  /* maximum difference in arcsec at the last epoch */
+  for (k = 0; k < nstar; k++) {
+    sprintf(star, "%d", istar[k]);
+    swe_fixstar2(star, J2000 + nep - 1, iflag, x, serr);
+    for (i = 0; i < 2; i++) {
+      d = fabs(i == 0 ? swe_difdeg2n(xx[6 * k], x[0]) : xx[6 * k + 1] - x[1]) * 3600;
+      if (d > dmax)
+	dmax = d;
+    }
+  }
+  printf("  per star %8.1f us  catalog %8.1f us  per epoch, speedup %.2f, max. diff %g arcsec\n", 
+    tsec[0] * 1e6 / nep, tsec[1] * 1e6 / nep, 
+    tsec[1] > 0 ? tsec[0] / tsec[1] : 0, dmax);
+  free(istar);
+  free(xx);
+  return 0;
+}
+
+/* planetary moons, each with a file of its own in sat/ */
+static const int ast_bodies[] = {9504, 9606, 9607, 9608, 9704, 9801, 9802, 9901, 9902, 9903, 9904, 9905};
+
+#define BENCH_NAST	((int) (sizeof(ast_bodies) / sizeof(ast_bodies[0])))
+
+static int bench_ast(long n)
+{
+  int k, ipass;
+  int32 iflag = SEFLG_SWIEPH | SEFLG_SPEED;
+  long l, i, nep = n / 1000 + 1;
+  double *xx[2], dmax = 0, d, t0, tsec[2];
+  char serr[AS_MAXCH];
+  xx[0] = (double *) malloc((size_t) nep * BENCH_NAST * 6 * 2 * sizeof(double));
+  if (xx[0] == NULL) {
+    fprintf(stderr, "%s: error in malloc()\n", arg0);
+    return 1;
+  }
+  xx[1] = xx[0] + nep * BENCH_NAST * 6;
+  for (k = 0; k < BENCH_NAST; k++) {
+    if (swe_calc(J2000, ast_bodies[k], iflag, xx[0], serr) < 0) {
+      fprintf(stderr, "%s: ast: %s\n", arg0, serr);
+      free(xx[0]);
+      return 1;
+    }
+  }
+  printf("ast: %ld epochs, %d bodies\n", nep, BENCH_NAST);
+  /* pass 0 without, pass 1 with pool */
+  for (ipass = 0; ipass < 2; ipass++) {
+    swe_set_asteroid_pool(ipass == 0 ? 0 : BENCH_NAST);
+    t0 = cpu_time();
+    for (l = 0; l < nep; l++) {
+      for (k = 0; k < BENCH_NAST; k++)
+	swe_calc(J2000 + l, ast_bodies[k], iflag, xx[ipass] + (l * BENCH_NAST + k) * 6, serr);
+    }
+    tsec[ipass] = cpu_time() - t0;
+  }
+  swe_set_asteroid_pool(0);
+  for (i = 0; i < nep * BENCH_NAST * 6; i++) {
+    d = fabs(xx[1][i] - xx[0][i]);
+    if (d > dmax)
+      dmax = d;
+  }
+  printf("  files reopened %8.1f us  pool %8.1f us  per body, speedup %.2f, max. diff %g\n", 
+    tsec[0] * 1e6 / nep / BENCH_NAST, tsec[1] * 1e6 / nep / BENCH_NAST, 
+    tsec[1] > 0 ? tsec[0] / tsec[1] : 0, dmax);
+  free(xx[0]);
+  return 0;
+}
+
+/* main asteroids, for osculating elements */
+static const int kep_bodies[] = {SE_CERES, SE_PALLAS, SE_JUNO, SE_VESTA, SE_CHIRON, SE_PHOLUS};
+
+#define BENCH_NKEP	((int) (sizeof(kep_bodies) / sizeof(kep_bodies[0])))
+
+static int bench_kep(long n)
+{
+  int k;
+  int32 iflag = SEFLG_SWIEPH;
+  long l;
+  double *elem, *xx, dret[50], x[6], dmax = 0, d, t0, tsec;
+  char serr[AS_MAXCH];
+  if (n < BENCH_NKEP)
+    n = BENCH_NKEP;
+  elem = (double *) malloc((size_t) n * (SE_KEPLER_NELEM + 3) * sizeof(double));
+  if (elem == NULL) {
+    fprintf(stderr, "%s: error in malloc()\n", arg0);
+    return 1;
+  }
+  xx = elem + n * SE_KEPLER_NELEM;
+  for (k = 0; k < BENCH_NKEP; k++) {
+    if (swe_get_orbital_elements(J2000, kep_bodies[k], iflag | SEFLG_HELCTR | SEFLG_J2000, dret, serr) == ERR) {
+      fprintf(stderr, "%s: kep: %s\n", arg0, serr);
+      free(elem);
+      return 1;
+    }
+    elem[k * SE_KEPLER_NELEM] = J2000;
+    elem[k * SE_KEPLER_NELEM + 1] = dret[0];
+    elem[k * SE_KEPLER_NELEM + 2] = dret[1];
+    elem[k * SE_KEPLER_NELEM + 3] = dret[2];
+    elem[k * SE_KEPLER_NELEM + 4] = dret[3];
+    elem[k * SE_KEPLER_NELEM + 5] = dret[4];
+    elem[k * SE_KEPLER_NELEM + 6] = dret[6];
+    elem[k * SE_KEPLER_NELEM + 7] = dret[11];
+  }
+  /* the real bodies first, then copies with other mean anomalies */
+  for (l = BENCH_NKEP; l < n; l++) {
+    memcpy((void *) (elem + l * SE_KEPLER_NELEM), (void *) (elem + (l % BENCH_NKEP) * SE_KEPLER_NELEM), SE_KEPLER_NELEM * sizeof(double));
+    elem[l * SE_KEPLER_NELEM + 6] = fmod(elem[l * SE_KEPLER_NELEM + 6] + l * 0.37, 360);
+  }
+  printf("kep: kernel %s, %ld bodies\n", swi_simd_name(), n);
+  t0 = cpu_time();
+  if (swe_kepler_batch(J2000, (int32) n, elem, iflag, xx, serr) == ERR) {
+    fprintf(stderr, "%s: kep: %s\n", arg0, serr);
+    free(elem);
+    return 1;
+  }
+  tsec = cpu_time() - t0;
+  for (k = 0; k < BENCH_NKEP; k++) {
+    swe_calc(J2000, kep_bodies[k], iflag | SEFLG_TRUEPOS | SEFLG_NONUT, x, serr);
+    d = fabs(swe_difdeg2n(xx[3 * k], x[0]));
+    if (d > dmax)
+      dmax = d;
+  }
+  printf("  %8.1f ns per body, max. diff %g deg\n", tsec * 1e9 / n, dmax);
+  free(elem);
+  return 0;
+}
+
+#define GRID_NLAT	181
+#define GRID_NLON	360
+
+static int bench_grid(long n)
+{
+  int k, m, hsys[] = {'P', 'O'};
+  int32 ilat, ilon, i;
+  long l, ngrid = n / 1000000 + 1;
+  double *cusps, *ascmc, cusp[13], asc[10], dmax = 0, d, t0, tsec[2];
+  char serr[AS_MAXCH];
+  cusps = (double *) malloc((size_t) GRID_NLAT * GRID_NLON * (13 + 10) * sizeof(double));
+  if (cusps == NULL) {
+    fprintf(stderr, "%s: error in malloc()\n", arg0);
+    return 1;
+  }
+  ascmc = cusps + GRID_NLAT * GRID_NLON * 13;
+  printf("grid: %ld grids of %d x %d points\n", ngrid, GRID_NLAT, GRID_NLON);
+  for (k = 0; k < 2; k++) {
+    t0 = cpu_time();
+    for (l = 0; l < ngrid; l++) {
+      for (ilat = 0; ilat < GRID_NLAT; ilat++) 
+	for (ilon = 0; ilon < GRID_NLON; ilon++)
+	  swe_houses_ex(J2000 + l, 0, -90 + ilat, -180 + ilon, hsys[k], cusp, asc);
+    }
+    tsec[0] = cpu_time() - t0;
+    t0 = cpu_time();
+    for (l = 0; l < ngrid; l++) 
+      swe_houses_grid(J2000 + l, 0, hsys[k], -90, 1, GRID_NLAT, -180, 1, GRID_NLON, cusps, ascmc, NULL, serr);
+    tsec[1] = cpu_time() - t0;
+    /* maximum difference at the last epoch */
+    for (ilat = 0; ilat < GRID_NLAT; ilat++) {
+      for (ilon = 0; ilon < GRID_NLON; ilon++) {
+	i = ilat * GRID_NLON + ilon;
+	swe_houses_ex(J2000 + ngrid - 1, 0, -90 + ilat, -180 + ilon, hsys[k], cusp, asc);
+	for (m = 1; m <= 12; m++) {
+	  d = fabs(swe_difdeg2n(cusps[i * 13 + m], cusp[m]));
+	  if (d > dmax)
+	    dmax = d;
+	}
+      }
+    }
+    printf("  %c: per point %8.1f ms  grid %8.1f ms  per grid, speedup %.2f, max. diff %g\n", 
+      hsys[k], tsec[0] * 1e3 / ngrid, tsec[1] * 1e3 / ngrid, 
+      tsec[1] > 0 ? tsec[0] / tsec[1] : 0, dmax);
+  }
+  free(cusps);
+  return 0;
+}
+
+static const int multi_hsys[] = {'P', 'K', 'O', 'R', 'C', 'B', 'E', 'W', 'G', 'I', 'X', 'T', 'Y', 'M', 'A', 'L', 'N', 'Q', 'S', 'U', 'V', 'H', 'F', 'D', 'J'};
+
+#define BENCH_NHSYS	((int) (sizeof(multi_hsys) / sizeof(multi_hsys[0])))
+
+static int bench_multi(long n)
+{
+  int k, m;
+  long l, nchart = n / 1000 + 1;
+  double cusps[BENCH_NHSYS * 37], ascmc[BENCH_NHSYS * 10], cusp_speed[BENCH_NHSYS * 37];
+  double ascmc_speed[BENCH_NHSYS * 10], cusp[37], asc[10], dmax = 0, d, t0, tsec[2];
+  char serr[AS_MAXCH];
+  printf("multi: %ld charts, %d house systems\n", nchart, BENCH_NHSYS);
+  t0 = cpu_time();
+  for (l = 0; l < nchart; l++) {
+    for (k = 0; k < BENCH_NHSYS; k++) 
+      swe_houses_ex2(J2000 + l * 0.37, 0, 47.4, 8.5, multi_hsys[k], cusps + k * 37, ascmc + k * 10, cusp_speed + k * 37, ascmc_speed + k * 10, serr);
+  }
+  tsec[0] = cpu_time() - t0;
+  t0 = cpu_time();
+  for (l = 0; l < nchart; l++) 
+    swe_houses_multi(J2000 + l * 0.37, 0, 47.4, 8.5, BENCH_NHSYS, multi_hsys, cusps, ascmc, cusp_speed, ascmc_speed, NULL, serr);
+  tsec[1] = cpu_time() - t0;
+  /* maximum difference of the last chart */
+  for (k = 0; k < BENCH_NHSYS; k++) {
+    swe_houses_ex2(J2000 + (nchart - 1) * 0.37, 0, 47.4, 8.5, multi_hsys[k], cusp, asc, NULL, NULL, serr);
+    for (m = 1; m <= 12; m++) {
+      d = fabs(swe_difdeg2n(cusps[k * 37 + m], cusp[m]));
+      if (d > dmax)
+	dmax = d;
+    }
+  }
+  printf("  per system %8.1f us  multi %8.1f us  per chart, speedup %.2f, max. diff %g\n", 
+    tsec[0] * 1e6 / nchart, tsec[1] * 1e6 / nchart, 
+    tsec[1] > 0 ? tsec[0] / tsec[1] : 0, dmax);
+  return 0;
+}
+
+#define BENCH_NHPOS	1000
+
+static int bench_hpos(long n)
+{
+  int k, hsys[] = {'P', 'K', 'G'};
+  int32 i;
+  long l, nframe = n / 1000 + 1;
+  double *xpin, *hpos, h, dmax = 0, d, t0, tsec[2];
+  char serr[AS_MAXCH];
+  xpin = (double *) malloc((size_t) BENCH_NHPOS * 3 * sizeof(double));
+  if (xpin == NULL) {
+    fprintf(stderr, "%s: error in malloc()\n", arg0);
+    return 1;
+  }
+  hpos = xpin + BENCH_NHPOS * 2;
+  for (i = 0; i < BENCH_NHPOS; i++) {
+    xpin[2 * i] = fmod(i * 137.508, 360);
+    xpin[2 * i + 1] = fmod(i * 7.3, 20) - 10;
+  }
+  printf("hpos: %ld frames, %d points\n", nframe, BENCH_NHPOS);
+  for (k = 0; k < 3; k++) {
+    t0 = cpu_time();
+    for (l = 0; l < nframe; l++) {
+      for (i = 0; i < BENCH_NHPOS; i++)
+	swe_house_pos(fmod(l * 0.25, 360), 47.4, 23.44, hsys[k], xpin + 2 * i, serr);
+    }
+    tsec[0] = cpu_time() - t0;
+    t0 = cpu_time();
+    for (l = 0; l < nframe; l++) 
+      swe_house_pos_batch(fmod(l * 0.25, 360), 47.4, 23.44, hsys[k], BENCH_NHPOS, xpin, hpos, serr);
+    tsec[1] = cpu_time() - t0;
+    /* maximum difference in the last frame */
+    for (i = 0; i < BENCH_NHPOS; i++) {
+      h = swe_house_pos(fmod((nframe - 1) * 0.25, 360), 47.4, 23.44, hsys[k], xpin + 2 * i, serr);
+      d = fabs(h - hpos[i]);
+      if (d > dmax)
+	dmax = d;
+    }
+    printf("  %c: per point %8.1f ns  batch %8.1f ns  per point, speedup %.2f, max. diff %g\n", 
+      hsys[k], tsec[0] * 1e9 / nframe / BENCH_NHPOS, tsec[1] * 1e9 / nframe / BENCH_NHPOS, 
+      tsec[1] > 0 ? tsec[0] / tsec[1] : 0, dmax);
+  }
+  free(xpin);
+  return 0;
+}
+
+static int bench_series(long n)
+{
+  int k, m, hsys[] = {'P', 'O'};
+  long l, nmin = n / 100 + 1;
+  double *cusps, *ascmc, cusp[13], asc[10], dmax = 0, d, t0, tsec[2];
+  char serr[AS_MAXCH];
+  cusps = (double *) malloc((size_t) nmin * (13 + 10) * sizeof(double));
+  if (cusps == NULL) {
+    fprintf(stderr, "%s: error in malloc()\n", arg0);
+    return 1;
+  }
+  ascmc = cusps + nmin * 13;
+  printf("series: %ld minutes\n", nmin);
+  for (k = 0; k < 2; k++) {
+    t0 = cpu_time();
+    for (l = 0; l < nmin; l++) 
+      swe_houses_ex(J2000 + l / 1440.0, 0, 47.4, 8.5, hsys[k], cusp, asc);
+    tsec[0] = cpu_time() - t0;
+    t0 = cpu_time();
+    swe_houses_series(J2000, 1 / 1440.0, (int32) nmin, 0, 47.4, 8.5, hsys[k], cusps, ascmc, NULL, serr);
+    tsec[1] = cpu_time() - t0;
+    for (l = 0; l < nmin; l += 97) {
+      swe_houses_ex(J2000 + l / 1440.0, 0, 47.4, 8.5, hsys[k], cusp, asc);
+      for (m = 1; m <= 12; m++) {
+	d = fabs(swe_difdeg2n(cusps[l * 13 + m], cusp[m])) * 3600;
+	if (d > dmax)
+	  dmax = d;
+      }
+    }
+    printf("  %c: per minute %8.1f ns  series %8.1f ns  per minute, speedup %.2f, max. diff %g arcsec\n", 
+      hsys[k], tsec[0] * 1e9 / nmin, tsec[1] * 1e9 / nmin, 
+      tsec[1] > 0 ? tsec[0] / tsec[1] : 0, dmax);
+  }
+  free(cusps);
+  return 0;
+}
+
+static int bench_ecl(long n)
+{
+  int k;
+  int32 iflag = SEFLG_SWIEPH;
+  long l, necl = n / 10000 + 1;
+  double t, tret[10], attr[20], geopos[20], *tmax, dmax = 0, d, t0, tsec[2];
+  char serr[AS_MAXCH];
+  if ((tmax = (double *) malloc((size_t) necl * sizeof(double))) == NULL) {
+    fprintf(stderr, "%s: error in malloc()\n", arg0);
+    return 1;
+  }
+  printf("ecl: %ld eclipses\n", necl);
+  for (k = 0; k < 2; k++) {
+    t0 = cpu_time();
+    for (l = 0, t = J2000; l < necl; l++, t = tret[0]) {
+      if (k == 0) {
+	if (swe_sol_eclipse_when_glob(t, iflag, 0, tret, FALSE, serr) == ERR
+	  || swe_sol_eclipse_where(tret[0], iflag, geopos, attr, serr) == ERR)
+	  break;
+      } else {
+	if (swe_lun_eclipse_when(t, iflag, 0, tret, FALSE, serr) == ERR
+	  || swe_lun_eclipse_how(tret[0], iflag, NULL, attr, serr) == ERR)
+	  break;
+      }
+      tmax[l] = tret[0];
+    }
+    tsec[0] = cpu_time() - t0;
+    if (l < necl) {
+      fprintf(stderr, "%s: ecl: %s\n", arg0, serr);
+      free(tmax);
+      return 1;
+    }
+    t0 = cpu_time();
+    for (l = 0, t = J2000; l < necl; l++, t = tret[0]) {
+      if (k == 0)
+	swe_sol_eclipse_when_glob_cat(t, iflag, 0, tret, attr, geopos, FALSE, serr);
+      else
+	swe_lun_eclipse_when_cat(t, iflag, 0, tret, attr, FALSE, serr);
+      d = fabs(tret[0] - tmax[l]) * 86400;
+      if (d > dmax)
+	dmax = d;
+    }
+    tsec[1] = cpu_time() - t0;
+    printf("  %s: search %8.1f us  catalog %8.1f us  per eclipse, speedup %.0f, max. diff %g sec\n", 
+      k == 0 ? "solar" : "lunar", tsec[0] * 1e6 / necl, tsec[1] * 1e6 / necl, 
+      tsec[1] > 0 ? tsec[0] / tsec[1] : 0, dmax);
+  }
+  free(tmax);
+  return 0;
+}
+
+static struct {
+  char *name;
+  int (*func)(long n);
+} tests[] = {
+  {"cheb", bench_cheb},
+  {"nut", bench_nut},
+  {"prec", bench_prec},
+  {"mosh", bench_mosh},
+  {"moon", bench_moon},
+  {"fit", bench_fit},
+  {"stars", bench_stars},
+  {"ast", bench_ast},
+  {"kep", bench_kep},
+  {"grid", bench_grid},
+  {"multi", bench_multi},
+  {"hpos", bench_hpos},
+  {"series", bench_series},
+  {"ecl", bench_ecl},
+};
+
+int main(int argc, char **argv)
+{
+  int i, k, nerr = 0, ntests = (int) (sizeof(tests) / sizeof(tests[0]));
+  AS_BOOL run_all = TRUE;
+  long n = 1000000;
+  arg0 = argv[0];
+  for (i = 1; i < argc; i++) {
+    if (strncmp(argv[i], "-n", 2) == 0) {
+      n = atol(argv[i] + 2);
+      if (n <= 0) 
+	n = 1;
+    } else if (strncmp(argv[i], "-e", 2) == 0) {
+      swe_set_ephe_path(argv[i] + 2);
+    } else if (*argv[i] != '-') {
+      run_all = FALSE;
+    }
+  }
+  for (k = 0; k < ntests; k++) {
+    if (!run_all) {
+      for (i = 1; i < argc; i++)
+	if (strcmp(argv[i], tests[k].name) == 0)
+	  break;
+      if (i == argc)
+	continue;
+    }
+    nerr += tests[k].func(n);
+  }
+  for (i = 1; i < argc; i++) {
+    if (*argv[i] == '-')
+      continue;
+    for (k = 0; k < ntests; k++)
+      if (strcmp(argv[i], tests[k].name) == 0)
+	break;
+    if (k == ntests) {
+      fprintf(stderr, "%s: unknown test %s\n", arg0, argv[i]);
+      nerr++;
+    }
+  }
+  return nerr > 0 ? 1 : 0;
+}
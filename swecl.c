@@ -84,6 +84,10 @@ static TLS double const_lapse_rate = SE_LAPSE_RATE;  /* for refraction */
 #define RSUN	(DSUN / 2)
 #define RMOON	(DMOON / 2)
 #define REARTH	(DEARTH / 2)
+/* number of the lunation (Meeus) at tjd, as start of the eclipse searches;
+ * 12.3685 lunations per 365.2425 days, as used formerly, drift by one
+ * lunation in 4300 years from J2000, so that eclipses were skipped */
+#define LUNATION_NO(tjd)	((int) (((tjd) - 2451550.09765) / 29.530588853))
 /*#define SEI_OCC_FAST    (16 * 1024L)*/
 static int32 eclipse_where( double tjd_ut, int32 ipl, char *starname, int32 ifl, double *geopos, 
 	double *dcore, char *serr);
@@ -1226,7 +1230,7 @@ int32 CALL_CONV swe_sol_eclipse_when_glob(double tjd_start, int32 ifl, int32 ifl
     ifltype |= SE_ECL_NONCENTRAL;
   if (backward)
     direction = -1;
-  K = (int) ((tjd_start - J2000) / 365.2425 * 12.3685);
+  K = LUNATION_NO(tjd_start);
   K -= direction;
 next_try:
   retflag = 0;
@@ -2115,7 +2119,7 @@ static int32 eclipse_when_loc(double tjd_start, int32 ifl, double *geopos, doubl
   int32 iflag = SEFLG_EQUATORIAL | SEFLG_TOPOCTR | ifl;
   int32 iflagcart = iflag | SEFLG_XYZ;
   swe_set_topo(geopos[0], geopos[1], geopos[2]);
-  K = (int) ((tjd_start - J2000) / 365.2425 * 12.3685);
+  K = LUNATION_NO(tjd_start);
   if (backward)
     K++;
   else
@@ -3414,7 +3418,7 @@ int32 CALL_CONV swe_lun_eclipse_when(double tjd_start, int32 ifl, int32 ifltype,
     ifltype = SE_ECL_TOTAL | SE_ECL_PENUMBRAL | SE_ECL_PARTIAL;
   if (backward)
     direction = -1;
-  K = (int) ((tjd_start - J2000) / 365.2425 * 12.3685);
+  K = LUNATION_NO(tjd_start);
   K -= direction;
 next_try:
   retflag = 0;
@@ -3604,6 +3608,366 @@ next_try:
   return retflag;
 }
 
+/* eclipse types of the solar eclipses wanted with ifltype, normalized as
+ * in swe_sol_eclipse_when_glob(); 0 for combinations that do not exist */
+static int32 sol_ecl_types(int32 ifltype)
+{
+  if (ifltype == (SE_ECL_PARTIAL | SE_ECL_CENTRAL))
+    return 0;
+  if (ifltype == (SE_ECL_ANNULAR_TOTAL | SE_ECL_NONCENTRAL))
+    return 0;
+  if (ifltype == 0)
+    ifltype = SE_ECL_TOTAL | SE_ECL_ANNULAR | SE_ECL_PARTIAL
+           | SE_ECL_ANNULAR_TOTAL | SE_ECL_NONCENTRAL | SE_ECL_CENTRAL;
+  if (ifltype == SE_ECL_TOTAL || ifltype == SE_ECL_ANNULAR || ifltype == SE_ECL_ANNULAR_TOTAL)
+    ifltype |= (SE_ECL_NONCENTRAL | SE_ECL_CENTRAL);
+  if (ifltype == SE_ECL_PARTIAL)
+    ifltype |= SE_ECL_NONCENTRAL;
+  return ifltype;
+}
+
+/* same for lunar eclipses, s. swe_lun_eclipse_when() */
+static int32 lun_ecl_types(int32 ifltype)
+{
+  ifltype &= ~(SE_ECL_CENTRAL|SE_ECL_NONCENTRAL);
+  if (ifltype & (SE_ECL_ANNULAR|SE_ECL_ANNULAR_TOTAL)) {
+    ifltype &= ~(SE_ECL_ANNULAR|SE_ECL_ANNULAR_TOTAL);
+    if (ifltype == 0)
+      return 0;
+  }
+  if (ifltype == 0)
+    ifltype = SE_ECL_TOTAL | SE_ECL_PENUMBRAL | SE_ECL_PARTIAL;
+  return ifltype;
+}
+
+/* the eclipse catalog is only valid with the default delta t, tidal 
+ * acceleration and astronomical models */
+static AS_BOOL eclipse_catalog_settings_ok(void)
+{
+  int i;
+  if (swed.is_tid_acc_manual || swed.delta_t_userdef_is_set)
+    return FALSE;
+  for (i = 0; i < SEI_NMODELS; i++) {
+    if (swed.astro_models[i] != 0)
+      return FALSE;
+  }
+  return TRUE;
+}
+
+void swi_close_eclipse_catalog(void)
+{
+  if (swed.eclcat.mptr != NULL)
+    swi_unmap_file(swed.eclcat.mptr, swed.eclcat.mlen);
+  memset((void *) &swed.eclcat, 0, sizeof(struct ecl_catalog));
+}
+
+/* maps the eclipse catalog, if it is found in the ephemeris path; 
+ * the file is searched only once after swe_set_ephe_path() or 
+ * swe_close(). Returns NULL if there is no usable catalog. */
+static struct efile_header *open_eclipse_catalog(void)
+{
+  FILE *fp;
+  struct ecl_catalog *ecp = &swed.eclcat;
+  struct efile_header *ehp;
+  if (ecp->is_searched)
+    return (struct efile_header *) ecp->mptr;
+  swi_init_swed_if_start();
+  ecp->is_searched = TRUE;
+  if ((fp = swi_fopen(-1, SE_ECLFILE, swed.ephepath, NULL)) == NULL)
+    return NULL;
+  /* the mapping remains valid after the file is closed */
+  ecp->mptr = swi_map_file(fp, &ecp->mlen);
+  fclose(fp);
+  if (ecp->mptr == NULL)
+    return NULL;
+  ehp = (struct efile_header *) ecp->mptr;
+  if (ecp->mlen < sizeof(struct efile_header)
+    || strncmp(ehp->magic, SEI_EFILE_MAGIC, 8) != 0
+    || ehp->test_endian != SEI_FILE_TEST_ENDIAN
+    || ehp->version != SEI_EFILE_VERSION
+    || ehp->recsize != (int32) sizeof(struct ecl_record)
+    || ehp->nsol < 0 || ehp->nlun < 0
+    || ehp->pos_sol % 8 != 0 || ehp->pos_lun % 8 != 0
+    || (size_t) ehp->pos_sol + (size_t) ehp->nsol * ehp->recsize > ecp->mlen
+    || (size_t) ehp->pos_lun + (size_t) ehp->nlun * ehp->recsize > ecp->mlen) {
+    swi_close_eclipse_catalog();
+    ecp->is_searched = TRUE;
+    return NULL;
+  }
+  return ehp;
+}
+
+/* searches the eclipse catalog for the eclipse that the live search 
+ * would find: the first one after tjd_start (the last one before it, 
+ * if backward) with a type in ecltypes.
+ * itypes	eclipse type bits that are checked against ecltypes
+ * Returns NULL if the answer is not in the catalog. */
+static struct ecl_record *search_eclipse_catalog(double tjd_start, int32 ifl, 
+        AS_BOOL is_lunar, int32 itypes, int32 ecltypes, AS_BOOL backward)
+{
+  int32 n, lo, hi, mid;
+  struct efile_header *ehp;
+  struct ecl_record *rec;
+  ifl &= SEFLG_EPHMASK;
+  if (ifl == 0)
+    ifl = SEFLG_SWIEPH;
+  if (ecltypes == 0 || !eclipse_catalog_settings_ok())
+    return NULL;
+  if ((ehp = open_eclipse_catalog()) == NULL || ehp->epheflag != ifl)
+    return NULL;
+  if (is_lunar) {
+    rec = (struct ecl_record *) (swed.eclcat.mptr + ehp->pos_lun);
+    n = ehp->nlun;
+  } else {
+    rec = (struct ecl_record *) (swed.eclcat.mptr + ehp->pos_sol);
+    n = ehp->nsol;
+  }
+  /* the catalog holds all eclipses with tret[0] in tstart + 0.0001 ... tend;
+   * the time tolerance is that of the live search */
+  lo = 0; hi = n;
+  if (!backward) {
+    if (tjd_start < ehp->tstart)
+      return NULL;
+    /* first eclipse with tret[0] > tjd_start + 0.0001 */
+    while (lo < hi) {
+      mid = (lo + hi) / 2;
+      if (rec[mid].tret[0] <= tjd_start + 0.0001)
+	lo = mid + 1;
+      else
+	hi = mid;
+    }
+    for (; lo < n; lo++) {
+      if ((rec[lo].retflag & itypes & ~ecltypes) == 0)
+	return &rec[lo];
+    }
+  } else {
+    if (tjd_start > ehp->tend)
+      return NULL;
+    /* first eclipse with tret[0] >= tjd_start - 0.0001 */
+    while (lo < hi) {
+      mid = (lo + hi) / 2;
+      if (rec[mid].tret[0] < tjd_start - 0.0001)
+	lo = mid + 1;
+      else
+	hi = mid;
+    }
+    for (lo--; lo >= 0; lo--) {
+      if ((rec[lo].retflag & itypes & ~ecltypes) == 0)
+	return &rec[lo];
+    }
+  }
+  return NULL;
+}
+
+/* copies an eclipse from the catalog into the arrays of the caller */
+static int32 eclipse_from_catalog(struct ecl_record *rec, double *tret, double *attr, double *geopos)
+{
+  int i;
+  for (i = 0; i < 10; i++)
+    tret[i] = i < 8 ? rec->tret[i] : 0;
+  if (attr != NULL) {
+    for (i = 0; i < 20; i++)
+      attr[i] = i < 11 ? rec->attr[i] : 0;
+  }
+  if (geopos != NULL) {
+    geopos[0] = rec->geopos[0];
+    geopos[1] = rec->geopos[1];
+  }
+  return rec->retflag;
+}
+
+/* When is the next solar eclipse anywhere on earth? 
+ * Like swe_sol_eclipse_when_glob(), but the eclipse is taken from the 
+ * eclipse catalog SE_ECLFILE, if it exists in the ephemeris path and
+ * covers tjd_start; otherwise the live search is done. The results are
+ * the same; far from the present, the live search itself varies by 
+ * milliseconds with the ephemeris files used before.
+ *
+ * attr		if not NULL, attributes at maximum, as from 
+ *		swe_sol_eclipse_where(); attr[0..10]; declare as attr[20]
+ * geopos	if not NULL, geographic position of maximum, geopos[0..1]
+ */
+int32 CALL_CONV swe_sol_eclipse_when_glob_cat(double tjd_start, int32 ifl, int32 ifltype,
+     double *tret, double *attr, double *geopos, int32 backward, char *serr)
+{
+  int i;
+  int32 retflag;
+  double geo[20], att[20];
+  struct ecl_record *rec;
+  rec = search_eclipse_catalog(tjd_start, ifl, FALSE, 
+          SE_ECL_TOTAL | SE_ECL_ANNULAR | SE_ECL_PARTIAL 
+	  | SE_ECL_ANNULAR_TOTAL | SE_ECL_NONCENTRAL | SE_ECL_CENTRAL,
+	  sol_ecl_types(ifltype), backward);
+  if (rec != NULL)
+    return eclipse_from_catalog(rec, tret, attr, geopos);
+  if ((retflag = swe_sol_eclipse_when_glob(tjd_start, ifl, ifltype, tret, backward, serr)) == ERR)
+    return ERR;
+  if (attr == NULL && geopos == NULL)
+    return retflag;
+  for (i = 0; i < 20; i++)
+    geo[i] = att[i] = 0;
+  if (swe_sol_eclipse_where(tret[0], ifl & SEFLG_EPHMASK, geo, att, serr) == ERR)
+    return ERR;
+  if (attr != NULL) {
+    for (i = 0; i < 20; i++)
+      attr[i] = i < 11 ? att[i] : 0;
+  }
+  if (geopos != NULL) {
+    geopos[0] = geo[0];
+    geopos[1] = geo[1];
+  }
+  return retflag;
+}
+
+/* When is the next lunar eclipse? 
+ * Like swe_lun_eclipse_when(), but the eclipse is taken from the 
+ * eclipse catalog, s. swe_sol_eclipse_when_glob_cat().
+ *
+ * attr		if not NULL, attributes at maximum, as from 
+ *		swe_lun_eclipse_how() without geographic position; 
+ *		attr[0..10]; declare as attr[20]
+ */
+int32 CALL_CONV swe_lun_eclipse_when_cat(double tjd_start, int32 ifl, int32 ifltype,
+     double *tret, double *attr, int32 backward, char *serr)
+{
+  int i;
+  int32 retflag;
+  double att[20];
+  struct ecl_record *rec;
+  rec = search_eclipse_catalog(tjd_start, ifl, TRUE, 
+          SE_ECL_TOTAL | SE_ECL_PENUMBRAL | SE_ECL_PARTIAL,
+	  lun_ecl_types(ifltype), backward);
+  if (rec != NULL)
+    return eclipse_from_catalog(rec, tret, attr, NULL);
+  if ((retflag = swe_lun_eclipse_when(tjd_start, ifl, ifltype, tret, backward, serr)) == ERR)
+    return ERR;
+  if (attr == NULL)
+    return retflag;
+  for (i = 0; i < 20; i++)
+    att[i] = 0;
+  if (swe_lun_eclipse_how(tret[0], ifl & SEFLG_EPHMASK, NULL, att, serr) == ERR)
+    return ERR;
+  for (i = 0; i < 20; i++)
+    attr[i] = i < 11 ? att[i] : 0;
+  return retflag;
+}
+
+/* writes the eclipse catalog SE_ECLFILE into the first directory of 
+ * the ephemeris path, s. swephunp.c and struct efile_header in sweph.h.
+ * tstart, tend	time range, UT
+ * epheflag	ephemeris, SEFLG_SWIEPH etc.
+ * fnout	returns the name of the file written
+ * The ephemeris must cover the whole range. The live searches take a 
+ * few minutes for the range of the Swiss Ephemeris files. */
+int32 swi_write_eclipse_catalog(double tstart, double tend, int32 epheflag, char *fnout, char *serr)
+{
+  int i, np;
+  int32 retc = ERR, retflag, ipass, n[2] = {0, 0};
+  double t, x[6], tret[10], geopos[20], attr[20];
+  char s[AS_MAXCH], *cpos[20];
+  FILE *fpout = NULL;
+  struct efile_header eh;
+  struct ecl_record er;
+  swi_close_eclipse_catalog();
+  epheflag &= SEFLG_EPHMASK;
+  if (epheflag == 0)
+    epheflag = SEFLG_SWIEPH;
+  if (!eclipse_catalog_settings_ok()) {
+    if (serr != NULL)
+      strcpy(serr, "eclipse catalog needs default delta t, tidal acceleration and models");
+    return ERR;
+  }
+  if (tend <= tstart) {
+    if (serr != NULL)
+      sprintf(serr, "invalid range %f - %f", tstart, tend);
+    return ERR;
+  }
+  /* no fallback to another ephemeris at the ends of the range */
+  for (i = 0, t = tstart; i < 2; i++, t = tend) {
+    if ((retflag = swe_calc_ut(t, SE_MOON, epheflag, x, serr)) == ERR)
+      return ERR;
+    if ((retflag & SEFLG_EPHMASK) != epheflag) {
+      if (serr != NULL)
+	sprintf(serr, "ephemeris does not cover jd %f", t);
+      return ERR;
+    }
+  }
+  strcpy(s, swed.ephepath);
+  np = swi_cutstr(s, PATH_SEPARATOR, cpos, 20);
+  *fnout = '\0';
+  if (np > 0 && strcmp(cpos[0], ".") != 0 && *cpos[0] != '\0') {
+    strcpy(fnout, cpos[0]);
+    if (*(fnout + strlen(fnout) - 1) != *DIR_GLUE)
+      strcat(fnout, DIR_GLUE);
+  }
+  strcat(fnout, SE_ECLFILE);
+  if ((fpout = fopen(fnout, BFILE_W_CREATE)) == NULL) {
+    if (serr != NULL)
+      sprintf(serr, "could not create %s", fnout);
+    return ERR;
+  }
+  memset((void *) &eh, 0, sizeof(eh));
+  fwrite((void *) &eh, sizeof(eh), 1, fpout);
+  /* pass 0 solar, pass 1 lunar eclipses */
+  for (ipass = 0; ipass < 2; ipass++) {
+    for (t = tstart; ; t = tret[0]) {
+      for (i = 0; i < 20; i++)
+	geopos[i] = attr[i] = 0;
+      if (ipass == 0) {
+	retflag = swe_sol_eclipse_when_glob(t, epheflag, 0, tret, FALSE, serr);
+	if (retflag == ERR)
+	  goto end_wec;
+	if (tret[0] > tend)
+	  break;
+	if (swe_sol_eclipse_where(tret[0], epheflag, geopos, attr, serr) == ERR)
+	  goto end_wec;
+      } else {
+	retflag = swe_lun_eclipse_when(t, epheflag, 0, tret, FALSE, serr);
+	if (retflag == ERR)
+	  goto end_wec;
+	if (tret[0] > tend)
+	  break;
+	if (swe_lun_eclipse_how(tret[0], epheflag, NULL, attr, serr) == ERR)
+	  goto end_wec;
+      }
+      memset((void *) &er, 0, sizeof(er));
+      for (i = 0; i < 8; i++)
+	er.tret[i] = tret[i];
+      for (i = 0; i < 11; i++)
+	er.attr[i] = attr[i];
+      er.geopos[0] = geopos[0];
+      er.geopos[1] = geopos[1];
+      er.retflag = retflag;
+      fwrite((void *) &er, sizeof(er), 1, fpout);
+      n[ipass]++;
+    }
+  }
+  strcpy(eh.magic, SEI_EFILE_MAGIC);
+  eh.test_endian = SEI_FILE_TEST_ENDIAN;
+  eh.version = SEI_EFILE_VERSION;
+  eh.recsize = (int32) sizeof(struct ecl_record);
+  eh.epheflag = epheflag;
+  eh.nsol = n[0];
+  eh.nlun = n[1];
+  eh.pos_sol = (int32) sizeof(eh);
+  eh.pos_lun = eh.pos_sol + n[0] * eh.recsize;
+  eh.tstart = tstart;
+  eh.tend = tend;
+  rewind(fpout);
+  fwrite((void *) &eh, sizeof(eh), 1, fpout);
+  if (ferror(fpout)) {
+    if (serr != NULL)
+      sprintf(serr, "error writing file %s", fnout);
+  } else {
+    retc = OK;
+  }
+end_wec:
+  fclose(fpout);
+  if (retc != OK)
+    remove(fnout);
+  return retc;
+}
+
 /* When is the next lunar eclipse, observable at a geographic position?
  *
  * retflag	SE_ECL_TOTAL or SE_ECL_PENUMBRAL or SE_ECL_PARTIAL
@@ -115,6 +115,29 @@ DllImport int32 CALL_CONV_IMP swe_calc_ut(
         double *xx,
         char *serr);
 
+DllImport int32 CALL_CONV_IMP swe_calc_batch(
+        int32 ipl, double *tjd, int32 n, int32 iflag, 
+        double *xx, int32 *iflgret,
+        char *serr);
+DllImport int32 CALL_CONV_IMP swe_calc_batch_ut(
+        int32 ipl, double *tjd_ut, int32 n, int32 iflag, 
+        double *xx, int32 *iflgret,
+        char *serr);
+DllImport int32 CALL_CONV_IMP swe_calc_all(
+        double tjd, int32 *ipl, int32 nbody, int32 iflag, 
+        double *xx, int32 *iflgret,
+        char *serr);
+DllImport int32 CALL_CONV_IMP swe_calc_all_ut(
+        double tjd_ut, int32 *ipl, int32 nbody, int32 iflag, 
+        double *xx, int32 *iflgret,
+        char *serr);
+DllImport int32 CALL_CONV_IMP swe_moshier_batch(
+        int32 ipl, double *tjd, int32 n, int32 iflag, 
+        double *xx, char *serr);
+DllImport int32 CALL_CONV_IMP swe_kepler_batch(
+        double tjd, int32 n, const double *elem, int32 iflag, 
+        double *xx, char *serr);
+
 DllImport double CALL_CONV_IMP swe_solcross(
 	double x2cross, double jd_et, int32 flag, char *serr);
 DllImport double CALL_CONV_IMP swe_solcross_ut(
@@ -158,6 +181,18 @@ DllImport int32 CALL_CONV_IMP swe_fixstar2_ut(
 DllImport int32 CALL_CONV_IMP swe_fixstar2_mag(
         char *star, double *xx, char *serr);
 
+DllImport int32 CALL_CONV_IMP swe_fixstar2_catalog(
+        double tjd, int32 iflag, double magmax, 
+        int32 nmax, int32 *istar, double *xx, double *mag,
+        int32 *nstar,
+        char *serr);
+
+DllImport int32 CALL_CONV_IMP swe_fixstar2_catalog_ut(
+        double tjd_ut, int32 iflag, double magmax, 
+        int32 nmax, int32 *istar, double *xx, double *mag,
+        int32 *nstar,
+        char *serr);
+
 DllImport double CALL_CONV_IMP swe_sidtime0(double tjd_ut, double ecl, double nut);
 DllImport double CALL_CONV_IMP swe_sidtime(double tjd_ut);
 
@@ -176,6 +211,23 @@ DllImport int  CALL_CONV_IMP swe_houses_ex2(
         double tjd_ut, int32 iflag, double geolat, double geolon, int hsys, 
         double *hcusps, double *ascmc, double *cusp_speed, double *ascmc_speed, char *serr);
 
+DllImport int  CALL_CONV_IMP swe_houses_multi(
+        double tjd_ut, int32 iflag, double geolat, double geolon, int nhsys, const int *hsys, 
+        double *hcusps, double *ascmc, double *cusp_speed, double *ascmc_speed, int32 *sysret, char *serr);
+
+DllImport int  CALL_CONV_IMP swe_houses_grid(
+        double tjd_ut, int32 iflag, int hsys, 
+        double lat0, double dlat, int32 nlat, double lon0, double dlon, int32 nlon,
+        double *hcusps, double *ascmc, int32 *cellret, char *serr);
+
+DllImport int  CALL_CONV_IMP swe_houses_series(
+        double tjd_ut, double step, int32 n, int32 iflag, double geolat, double geolon, int hsys, 
+        double *hcusps, double *ascmc, int32 *sampret, char *serr);
+
+DllImport int  CALL_CONV_IMP swe_houses_cross(
+        double tjd_start, double tjd_end, int32 iflag, double geolat, double geolon, int hsys, 
+        int32 ipoint, double x2cross, double *tret, int32 nmax, int32 *nret, char *serr);
+
 DllImport int  CALL_CONV_IMP swe_houses_armc(
         double armc, double geolat, double eps, int hsys, 
         double *hcusps, double *ascmc);
@@ -187,6 +239,9 @@ DllImport int  CALL_CONV_IMP swe_houses_armc_ex2(
 DllImport double  CALL_CONV_IMP swe_house_pos(
         double armc, double geolon, double eps, int hsys, double *xpin, char *serr);
 
+DllImport int32  CALL_CONV_IMP swe_house_pos_batch(
+        double armc, double geolat, double eps, int hsys, int32 n, double *xpin, double *hpos, char *serr);
+
 DllImport const char * CALL_CONV_IMP swe_house_name(int hsys);
 
 DllImport int32  CALL_CONV_IMP swe_gauquelin_sector(
@@ -203,6 +258,12 @@ DllImport double  CALL_CONV_IMP swe_get_ayanamsa_ut(double tjd_ut);
 
 DllImport char * CALL_CONV_IMP swe_get_ayanamsa_name(int32 isidmode);
 DllImport char * CALL_CONV_IMP swe_get_current_file_data(int ifno, double *tfstart, double *tfend, int *denum);
+DllImport void CALL_CONV_IMP swe_set_segment_cache(int32 nseg);
+DllImport int32 CALL_CONV_IMP swe_get_segment_cache_stats(int32 ipl, int32 *hits, int32 *misses);
+DllImport int32 CALL_CONV_IMP swe_set_shared_segments(AS_BOOL do_share);
+DllImport void CALL_CONV_IMP swe_set_asteroid_pool(int32 nfiles);
+DllImport int32 CALL_CONV_IMP swe_get_asteroid_pool(void);
+DllImport void CALL_CONV_IMP swe_set_analytical_cache(double precision);
 
 DllImport int  CALL_CONV_IMP swe_date_conversion(
         int y , int m , int d ,         /* year, month, day */
@@ -250,6 +311,8 @@ DllImport int  CALL_CONV_IMP swe_lat_to_lmt(double tjd_lat, double geolon, doubl
 DllImport double  CALL_CONV_IMP swe_get_tid_acc(void);
 DllImport void  CALL_CONV_IMP swe_set_tid_acc(double tidacc);
 DllImport void  CALL_CONV_IMP swe_set_delta_t_userdef(double dt);
+DllImport void  CALL_CONV_IMP swe_set_deltat_table(AS_BOOL use_table);
+DllImport void  CALL_CONV_IMP swe_set_nutation_simd(AS_BOOL use_simd);
 DllImport void  CALL_CONV_IMP swe_set_ephe_path(const char *path);
 DllImport void  CALL_CONV_IMP swe_set_jpl_file(const char *fname);
 DllImport void  CALL_CONV_IMP swe_close(void);
@@ -295,6 +358,9 @@ DllImport int32  CALL_CONV_IMP swe_lun_eclipse_how(
           char *serr);
 DllImport int32  CALL_CONV_IMP swe_lun_eclipse_when(double tjd_start, int32 ifl, int32 ifltype, double *tret, int32 backward, char *serr);
 DllImport int32  CALL_CONV_IMP swe_lun_eclipse_when_loc(double tjd_start, int32 ifl, double *geopos, double *tret, double *attr, int32 backward, char *serr);
+/* next eclipse from the eclipse catalog */
+DllImport int32  CALL_CONV_IMP swe_sol_eclipse_when_glob_cat(double tjd_start, int32 ifl, int32 ifltype, double *tret, double *attr, double *geopos, int32 backward, char *serr);
+DllImport int32  CALL_CONV_IMP swe_lun_eclipse_when_cat(double tjd_start, int32 ifl, int32 ifltype, double *tret, double *attr, int32 backward, char *serr);
 /* planetary phenomena */
 DllImport int32  CALL_CONV_IMP swe_pheno(double tjd, int32 ipl, int32 iflag, double *attr, char *serr);
 
@@ -396,6 +462,14 @@ DllImport char * CALL_CONV_IMP swe_cs2degstr(CSEC t, char *a);
 
 DllImport void CALL_CONV_IMP swe_set_interpolate_nut(AS_BOOL do_interpolate);
 
+DllImport int32 CALL_CONV_IMP swe_nutation_batch(
+	double *tjd, int32 n, int32 iflag, 
+	double *dpsi, double *deps, char *serr);
+DllImport int32 CALL_CONV_IMP swe_set_nutation_table(
+	double tjd_start, double tjd_end, double step, 
+	int32 iflag, char *serr);
+DllImport void CALL_CONV_IMP swe_set_prec_interpolation(double tstep);
+
 
 #endif /* !_SWEDLL_H */
 #ifdef __cplusplus
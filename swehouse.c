@@ -107,6 +107,19 @@ static int sidereal_houses_ssypl(double tjde,
 			   double *cusp_speed,
 			   double *ascmc_speed,
 			   char *serr);
+static void houses_epoch(double tjd_ut, int32 iflag, struct hseries_anchor *an);
+static int sidereal_houses(double tjde, 
+			   int32 iflag,
+                           double armc, 
+                           double eps, 
+                           double *nutlo, 
+                           double lat, 
+			   int hsys, 
+                           double *cusp, 
+                           double *ascmc,
+			   double *cusp_speed,
+			   double *ascmc_speed,
+			   char *serr);
 static int sunshine_solution_makransky(double ramc, double lat, double ecl, struct houses *hsp);
 static int sunshine_solution_treindl(double ramc, double lat, double ecl, struct houses *hsp);
 #if 0
@@ -216,9 +229,8 @@ int CALL_CONV swe_houses_ex2(double tjd_ut,
 				char *serr)
 {
   int i, retc = 0;
-  double armc, eps_mean, nutlo[2];
-  double tjde = tjd_ut + swe_deltat_ex(tjd_ut, iflag, NULL);
-  struct sid_data *sip = &swed.sidd;
+  double armc;
+  struct hseries_anchor he;
   double xp[6];
   int retc_makr = 0;
   int ito;
@@ -226,16 +238,7 @@ int CALL_CONV swe_houses_ex2(double tjd_ut,
     ito = 36;
   else
     ito = 12;
-  if ((iflag & SEFLG_SIDEREAL) && !swed.ayana_is_set)
-    swe_set_sid_mode(SE_SIDM_FAGAN_BRADLEY, 0, 0);
-  eps_mean = swi_epsiln(tjde, 0) * RADTODEG;
-  swi_nutation(tjde, 0, nutlo);
-  for (i = 0; i < 2; i++)
-    nutlo[i] *= RADTODEG;
-  if (iflag & SEFLG_NONUT) {
-    for (i = 0; i < 2; i++)
-      nutlo[i] = 0;
-  }
+  houses_epoch(tjd_ut, iflag, &he);
 #ifdef TRACE
   swi_open_trace(NULL);
   if (swi_trace_count <= TRACE_COUNT_MAX) {
@@ -255,7 +258,7 @@ int CALL_CONV swe_houses_ex2(double tjd_ut,
   }
 #endif
     /*houses_to_sidereal(tjde, geolat, hsys, eps, cusp, ascmc, iflag);*/
-  armc = swe_degnorm(swe_sidtime0(tjd_ut, eps_mean + nutlo[1], nutlo[0]) * 15 + geolon);
+  armc = swe_degnorm(he.sidt + geolon);
 //fprintf(stderr, "armc=%f, iflag=%d\n", armc, iflag);
   if (toupper(hsys) ==  'I') {	// compute sun declination for sunshine houses
     int flags = SEFLG_SPEED| SEFLG_EQUATORIAL;
@@ -267,14 +270,9 @@ int CALL_CONV swe_houses_ex2(double tjd_ut,
     ascmc[9] = xp[1];	// declination in ascmc[9];
   }
   if (iflag & SEFLG_SIDEREAL) { 
-    if (sip->sid_mode & SE_SIDBIT_ECL_T0)
-      retc = sidereal_houses_ecl_t0(tjde, armc, eps_mean + nutlo[1], nutlo, geolat, hsys, cusp, ascmc, cusp_speed, ascmc_speed, serr);
-    else if (sip->sid_mode & SE_SIDBIT_SSY_PLANE)
-      retc = sidereal_houses_ssypl(tjde, armc, eps_mean + nutlo[1], nutlo, geolat, hsys, cusp, ascmc, cusp_speed, ascmc_speed, serr);
-    else
-      retc = sidereal_houses_trad(tjde, iflag, armc, eps_mean + nutlo[1], nutlo[0], geolat, hsys, cusp, ascmc, cusp_speed, ascmc_speed, serr);
+    retc = sidereal_houses(he.tjde, iflag, armc, he.eps, he.nutlo, geolat, hsys, cusp, ascmc, cusp_speed, ascmc_speed, serr);
   } else {
-    retc = swe_houses_armc_ex2(armc, geolat, eps_mean + nutlo[1], hsys, cusp, ascmc, cusp_speed, ascmc_speed, serr);
+    retc = swe_houses_armc_ex2(armc, geolat, he.eps, hsys, cusp, ascmc, cusp_speed, ascmc_speed, serr);
     if (toupper(hsys) ==  'I') 	
       ascmc[9] = xp[1];	// declination in ascmc[9];
   }
@@ -289,6 +287,499 @@ int CALL_CONV swe_houses_ex2(double tjd_ut,
   return retc;
 }
 
+/* 
+ * Houses of several house systems for one chart.
+ * Delta t, obliquity, nutation, sidereal time and the declination of
+ * the Sun for the Sunshine houses are computed once for all systems.
+ * hsys[0 ... nhsys - 1]   house systems
+ * for system i:
+ * cusps[i * 37 + 0 ... 36]       cusps as from swe_houses_ex2() 
+ *                                (1 ... 12, or 1 ... 36 with 'G')
+ * ascmc[i * 10 + 0 ... 9]        additional points
+ * cusp_speed[i * 37 + 0 ... 36]  speeds of the cusps, may be NULL
+ * ascmc_speed[i * 10 + 0 ... 9]  speeds of the additional points, may be NULL
+ * sysret[i]                      OK, or ERR if the system failed and
+ *                                Porphyry houses are given; may be NULL
+ * Function returns OK, or ERR if at least one system failed; serr then 
+ * contains the message of the first one.
+ */
+int CALL_CONV swe_houses_multi(double tjd_ut,
+                                int32 iflag, 
+				double geolat,
+				double geolon,
+				int nhsys,
+				const int *hsys,
+				double *cusps,
+				double *ascmc,
+			        double *cusp_speed,
+				double *ascmc_speed,
+				int32 *sysret,
+				char *serr)
+{
+  int i, j, ito, hs, rc, retc = OK;
+  double armc, xp[6];
+  double *cp, *ap, *csp, *asp;
+  struct hseries_anchor he;
+  int retc_makr = 0;
+  AS_BOOL sun_done = FALSE;
+  char serr_sys[AS_MAXCH];
+  if (serr != NULL)
+    *serr = '\0';
+  houses_epoch(tjd_ut, iflag, &he);
+  armc = swe_degnorm(he.sidt + geolon);
+  for (j = 0; j < nhsys; j++) {
+    hs = hsys[j];
+    cp = cusps + j * 37;
+    ap = ascmc + j * 10;
+    csp = cusp_speed != NULL ? cusp_speed + j * 37 : NULL;
+    asp = ascmc_speed != NULL ? ascmc_speed + j * 10 : NULL;
+    *serr_sys = '\0';
+    if (toupper(hs) ==  'I') {	// compute sun declination for sunshine houses
+      if (!sun_done) {
+	retc_makr = swe_calc_ut(tjd_ut, SE_SUN, SEFLG_SPEED | SEFLG_EQUATORIAL, xp, serr_sys);
+	sun_done = TRUE;
+      }
+      if (retc_makr < 0) 
+	hs = (int) 'O';	// in case of failure, provide Porphyry houses
+      else
+	ap[9] = xp[1];	// declination in ascmc[9];
+    }
+    if (toupper(hs) == 'G')
+      ito = 36;
+    else
+      ito = 12;
+    if (iflag & SEFLG_SIDEREAL) { 
+      rc = sidereal_houses(he.tjde, iflag, armc, he.eps, he.nutlo, geolat, hs, cp, ap, csp, asp, serr_sys);
+    } else {
+      rc = swe_houses_armc_ex2(armc, geolat, he.eps, hs, cp, ap, csp, asp, serr_sys);
+      if (toupper(hs) ==  'I') 	
+	ap[9] = xp[1];	// declination in ascmc[9];
+    }
+    if (iflag & SEFLG_RADIANS) {
+      for (i = 1; i <= ito; i++)
+	cp[i] *= DEGTORAD;
+      for (i = 0; i < SE_NASCMC; i++)
+	ap[i] *= DEGTORAD;
+    }
+    if (toupper(hsys[j]) == 'I' && retc_makr < 0)
+      rc = ERR;
+    if (sysret != NULL)
+      sysret[j] = rc < 0 ? ERR : OK;
+    if (rc < 0 && retc == OK) {
+      retc = ERR;
+      if (serr != NULL)
+	strcpy(serr, serr_sys);
+    }
+  }
+  return retc;
+}
+
+/* 
+ * Houses for all points of a geographic grid at one instant,
+ * e.g. for relocation maps.
+ * Delta t, sidereal time, obliquity and nutation are computed only once;
+ * the points differ only in armc and geographic latitude.
+ * Point k = ilat * nlon + ilon, ilat = 0 ... nlat - 1, ilon = 0 ... nlon - 1,
+ * is at latitude lat0 + ilat * dlat and longitude lon0 + ilon * dlon.
+ * cusps[k * 13 + 0 ... 12]    cusps as from swe_houses_ex(), cusps[k * 13] = 0;
+ *                             with house system 'G' cusps[k * 37 + 0 ... 36].
+ * ascmc[k * 10 + 0 ... 9]     additional points as from swe_houses_ex().
+ * cellret[k]                  OK, or ERR if the house system failed at this
+ *                             point and Porphyry houses are given 
+ *                             (e.g. Placidus within the polar circle);
+ *                             may be NULL.
+ * Function returns OK, or ERR if the houses failed for at least one point;
+ * serr then contains the message of the first one.
+ * iflag: SEFLG_SIDEREAL, SEFLG_NONUT, SEFLG_RADIANS as with swe_houses_ex().
+ * Speeds are not computed.
+ */
+int CALL_CONV swe_houses_grid(double tjd_ut,
+                                int32 iflag,
+				int hsys,
+				double lat0, double dlat, int32 nlat,
+				double lon0, double dlon, int32 nlon,
+				double *cusps,
+				double *ascmc,
+				int32 *cellret,
+				char *serr)
+{
+  int i, ito, ncusp, rc, retc = OK;
+  int32 ilat, ilon, k;
+  double armc, geolat, sundec = 0, xp[6];
+  double *cp, *ap;
+  struct hseries_anchor he;
+  struct houses h;
+  char serr_cell[AS_MAXCH];
+  if (serr != NULL)
+    *serr = '\0';
+  if (nlat <= 0 || nlon <= 0) {
+    if (serr != NULL)
+      sprintf(serr, "invalid grid of %d x %d points", nlat, nlon);
+    return ERR;
+  }
+  if (toupper(hsys) == 'G')
+    ito = 36;
+  else
+    ito = 12;
+  ncusp = ito + 1;
+  houses_epoch(tjd_ut, iflag, &he);
+  if (toupper(hsys) ==  'I') {	// sun declination for sunshine houses
+    if (swe_calc_ut(tjd_ut, SE_SUN, SEFLG_SPEED | SEFLG_EQUATORIAL, xp, serr) < 0) {
+      // in case of failure, provide Porphyry houses
+      hsys = (int) 'O';
+      ito = 12;
+      retc = ERR;
+    } else {
+      sundec = xp[1];
+    }
+  }
+  h.do_speed = FALSE;
+  h.do_hspeed = FALSE;
+  for (ilat = 0; ilat < nlat; ilat++) {
+    geolat = lat0 + ilat * dlat;
+    for (ilon = 0; ilon < nlon; ilon++) {
+      k = ilat * nlon + ilon;
+      cp = cusps + k * ncusp;
+      ap = ascmc + k * 10;
+      armc = swe_degnorm(he.sidt + lon0 + ilon * dlon);
+      *serr_cell = '\0';
+      if (iflag & SEFLG_SIDEREAL) {
+	ap[9] = sundec;
+	rc = sidereal_houses(he.tjde, iflag, armc, he.eps, he.nutlo, geolat, hsys, cp, ap, NULL, NULL, serr_cell);
+      } else {
+	h.sundec = sundec;
+	rc = CalcH(armc, geolat, he.eps, (char) hsys, &h);
+	strcpy(serr_cell, h.serr);
+	cp[0] = 0;
+	// on failure, we only have 12 Porphyry cusps
+	for (i = 1; i <= ito; i++)
+	  cp[i] = (rc < 0 && i > 12) ? 0 : h.cusp[i];
+	ap[0] = h.ac;
+	ap[1] = h.mc;
+	ap[2] = armc;
+	ap[3] = h.vertex;
+	ap[4] = h.equasc;
+	ap[5] = h.coasc1;
+	ap[6] = h.coasc2;
+	ap[7] = h.polasc;
+	for (i = SE_NASCMC; i < 10; i++)
+	  ap[i] = 0;
+	if (toupper(hsys) ==  'I')
+	  ap[9] = h.sundec;
+      }
+      if (iflag & SEFLG_RADIANS) {
+	for (i = 1; i <= ito; i++)
+	  cp[i] *= DEGTORAD;
+	for (i = 0; i < SE_NASCMC; i++)
+	  ap[i] *= DEGTORAD;
+      }
+      if (cellret != NULL)
+	cellret[k] = rc < 0 ? ERR : OK;
+      if (rc < 0 && retc == OK) {
+	retc = ERR;
+	if (serr != NULL)
+	  strcpy(serr, serr_cell);
+      }
+    }
+  }
+  return retc;
+}
+
+/* 
+ * House time series, e.g. for timelines of the angles.
+ * Sidereal time, obliquity and nutation are computed exactly only at
+ * anchors HSERIES_REFRESH days apart. In between, armc advances with 
+ * the mean sidereal rate ARMCS plus the linear correction between the
+ * anchors, and obliquity, nutation and delta t are interpolated linearly.
+ * The curvature of the short-period nutation terms within three hours
+ * is negligible: the cusps deviate from swe_houses_ex() by less than 
+ * 0.001", the Sunshine houses, with the declination of the Sun 
+ * interpolated as well, by less than 0.05".
+ */
+#define HSERIES_REFRESH	0.125
+
+static int hseries_anchor(struct houses_series *hs, double t, struct hseries_anchor *an, char *serr)
+{
+  double xp[6];
+  houses_epoch(t, hs->iflag, an);
+  if (toupper(hs->hsys) ==  'I') {	// sun declination for sunshine houses
+    if (swe_calc_ut(t, SE_SUN, SEFLG_SPEED | SEFLG_EQUATORIAL, xp, serr) < 0)
+      return ERR;
+    an->sundec = xp[1];
+  }
+  return OK;
+}
+
+static void hseries_init(struct houses_series *hs, double t0, int32 iflag, double geolat, double geolon, int hsys)
+{
+  hs->iflag = iflag;
+  hs->hsys = hsys;
+  hs->geolat = geolat;
+  hs->geolon = geolon;
+  hs->t0 = t0;
+  hs->k = 0;
+  hs->has_anchor = FALSE;
+}
+
+/* houses at time t of a series; cusp[37], ascmc[10] as with swe_houses_ex() */
+static int hseries_calc(struct houses_series *hs, double t, double *cusp, double *ascmc, char *serr)
+{
+  int i, ito, retc = OK, hsys = hs->hsys;
+  int32 k = (int32) floor((t - hs->t0) / HSERIES_REFRESH);
+  double f, dsid, armc, eps, nutl[2], tjde;
+  struct hseries_anchor *a = &hs->a, *b = &hs->b;
+  if (serr != NULL)
+    *serr = '\0';
+  /* k < 0 with a negative step of swe_houses_series() */
+  if (!hs->has_anchor || k != hs->k) {
+    if (hs->has_anchor && k == hs->k + 1) {
+      *a = *b;
+      if (hseries_anchor(hs, hs->t0 + (k + 1) * HSERIES_REFRESH, b, serr) == ERR)
+	retc = ERR;
+    } else if (hs->has_anchor && k == hs->k - 1) {
+      *b = *a;
+      if (hseries_anchor(hs, hs->t0 + k * HSERIES_REFRESH, a, serr) == ERR)
+	retc = ERR;
+    } else if (hseries_anchor(hs, hs->t0 + k * HSERIES_REFRESH, a, serr) == ERR
+	|| hseries_anchor(hs, hs->t0 + (k + 1) * HSERIES_REFRESH, b, serr) == ERR) {
+      retc = ERR;
+    }
+    hs->k = k;
+    hs->has_anchor = (retc == OK);
+  }
+  f = (t - a->t) / (b->t - a->t);
+  if (retc == ERR) {
+    // in case of failure of the Sun, provide Porphyry houses
+    hsys = (int) 'O';
+    if (hseries_anchor(hs, t, a, NULL) == ERR) 
+      a->sundec = 0;
+    *b = *a;
+    b->t = a->t + HSERIES_REFRESH;
+    f = 0;
+  }
+  dsid = swe_difdeg2n(b->sidt, a->sidt + ARMCS * (b->t - a->t));
+  armc = swe_degnorm(a->sidt + ARMCS * (t - a->t) + dsid * f + hs->geolon);
+  eps = a->eps + (b->eps - a->eps) * f;
+  tjde = a->tjde + (b->tjde - a->tjde) * f;
+  for (i = 0; i < 2; i++)
+    nutl[i] = a->nutlo[i] + (b->nutlo[i] - a->nutlo[i]) * f;
+  ascmc[9] = a->sundec + (b->sundec - a->sundec) * f;
+  if (toupper(hsys) == 'G')
+    ito = 36;
+  else
+    ito = 12;
+  if (hs->iflag & SEFLG_SIDEREAL) { 
+    i = sidereal_houses(tjde, hs->iflag, armc, eps, nutl, hs->geolat, hsys, cusp, ascmc, NULL, NULL, serr);
+  } else {
+    i = swe_houses_armc_ex2(armc, hs->geolat, eps, hsys, cusp, ascmc, NULL, NULL, serr);
+  }
+  if (i < 0)
+    retc = ERR;
+  if (hs->iflag & SEFLG_RADIANS) {
+    for (i = 1; i <= ito; i++)
+      cusp[i] *= DEGTORAD;
+    for (i = 0; i < SE_NASCMC; i++)
+      ascmc[i] *= DEGTORAD;
+  }
+  return retc;
+}
+
+/* 
+ * Houses at n times tjd_ut + i * step, i = 0 ... n - 1, for one place;
+ * step may be negative.
+ * cusps[i * 13 + 0 ... 12]    cusps as from swe_houses_ex(), cusps[i * 13] = 0;
+ *                             with house system 'G' cusps[i * 37 + 0 ... 36].
+ * ascmc[i * 10 + 0 ... 9]     additional points as from swe_houses_ex().
+ * sampret[i]                  OK, or ERR if the houses failed at time i 
+ *                             and Porphyry houses are given; may be NULL.
+ * Function returns OK, or ERR if the houses failed for at least one time;
+ * serr then contains the message of the first one.
+ * iflag: SEFLG_SIDEREAL, SEFLG_NONUT, SEFLG_RADIANS as with swe_houses_ex().
+ * Sidereal time, obliquity and nutation are interpolated between exact 
+ * values three hours apart, s. HSERIES_REFRESH.
+ */
+int CALL_CONV swe_houses_series(double tjd_ut,
+				double step,
+				int32 n,
+                                int32 iflag,
+				double geolat,
+				double geolon,
+				int hsys,
+				double *cusps,
+				double *ascmc,
+				int32 *sampret,
+				char *serr)
+{
+  int32 i;
+  int rc, ncusp, retc = OK;
+  double cusp[37], asc[10];
+  struct houses_series hs;
+  char serr_samp[AS_MAXCH];
+  if (serr != NULL)
+    *serr = '\0';
+  if (n < 0) {
+    if (serr != NULL)
+      sprintf(serr, "swe_houses_series(): invalid number of times %d", n);
+    return ERR;
+  }
+  if (toupper(hsys) == 'G')
+    ncusp = 37;
+  else
+    ncusp = 13;
+  hseries_init(&hs, tjd_ut, iflag, geolat, geolon, hsys);
+  for (i = 0; i < n; i++) {
+    *serr_samp = '\0';
+    rc = hseries_calc(&hs, tjd_ut + i * step, cusp, asc, serr_samp);
+    memcpy((void *) (cusps + i * ncusp), (void *) cusp, ncusp * sizeof(double));
+    memcpy((void *) (ascmc + i * 10), (void *) asc, 10 * sizeof(double));
+    if (sampret != NULL)
+      sampret[i] = rc;
+    if (rc < 0 && retc == OK) {
+      retc = ERR;
+      if (serr != NULL)
+	strcpy(serr, serr_samp);
+    }
+  }
+  return retc;
+}
+
+/* longitude of a point of the houses in degrees, minus x2cross, 
+ * normalized to -180 ... 180; returns the error code of hseries_calc() */
+static int hseries_point(struct houses_series *hs, double t, int32 ipoint, double x2cross, double *d, char *serr)
+{
+  int retc;
+  double cusp[37], ascmc[10], x;
+  retc = hseries_calc(hs, t, cusp, ascmc, serr);
+  if (ipoint >= SE_HOUSES_ANGLE)
+    x = ascmc[ipoint - SE_HOUSES_ANGLE];
+  else
+    x = cusp[ipoint];
+  if (hs->iflag & SEFLG_RADIANS)
+    x *= RADTODEG;
+  *d = swe_difdeg2n(x, x2cross);
+  return retc;
+}
+
+#define HCROSS_STEP	(10.0 / 1440)	/* search step, 10 minutes */
+#define HCROSS_PREC	(1e-9)		/* precision in days, about 0.1 ms */
+
+/* 
+ * Times when a house cusp or angle crosses the longitude x2cross,
+ * between tjd_start and tjd_end (UT), in increasing order. 
+ * ipoint   house cusp 1 ... 12 (1 ... 36 with 'G'), or 
+ *          SE_HOUSES_ANGLE + SE_ASC, SE_MC, ... SE_POLASC
+ * x2cross  longitude, in radians with SEFLG_RADIANS
+ * tret     up to nmax times of crossing; their number in *nret.
+ * Crossings in direct and in retrograde motion are found, e.g. of the 
+ * cusps in high latitudes. The houses are searched in steps of 10 minutes 
+ * (HCROSS_STEP). Crossings by a jump of the point, e.g. of the ascendant 
+ * within the polar circle, are not counted; two crossings within one step
+ * may be missed.
+ * iflag and the precision of the houses as with swe_houses_series().
+ * Function returns OK, or ERR if the houses failed, e.g. with the Sunshine
+ * houses and no ephemeris of the Sun; tret[] then holds the crossings 
+ * before the failure.
+ */
+int CALL_CONV swe_houses_cross(double tjd_start,
+				double tjd_end,
+                                int32 iflag,
+				double geolat,
+				double geolon,
+				int hsys,
+				int32 ipoint,
+				double x2cross,
+				double *tret,
+				int32 nmax,
+				int32 *nret,
+				char *serr)
+{
+  int32 i, nstep;
+  double t1, t2, tm, d1, d2, dm;
+  struct houses_series hs;
+  *nret = 0;
+  if (serr != NULL)
+    *serr = '\0';
+  if (ipoint < 1 || ipoint > (toupper(hsys) == 'G' ? 36 : 12)) {
+    if (ipoint < SE_HOUSES_ANGLE + SE_ASC || ipoint > SE_HOUSES_ANGLE + SE_POLASC
+	|| ipoint == SE_HOUSES_ANGLE + SE_ARMC) {
+      if (serr != NULL)
+	sprintf(serr, "swe_houses_cross(): invalid point %d", ipoint);
+      return ERR;
+    }
+  }
+  if (iflag & SEFLG_RADIANS)
+    x2cross *= RADTODEG;
+  hseries_init(&hs, tjd_start, iflag, geolat, geolon, hsys);
+  nstep = (int32) ceil((tjd_end - tjd_start) / HCROSS_STEP);
+  t1 = tjd_start;
+  if (hseries_point(&hs, t1, ipoint, x2cross, &d1, serr) == ERR)
+    return ERR;
+  for (i = 1; i <= nstep && *nret < nmax; i++) {
+    t2 = tjd_start + i * HCROSS_STEP;
+    if (t2 > tjd_end)
+      t2 = tjd_end;
+    if (hseries_point(&hs, t2, ipoint, x2cross, &d2, serr) == ERR)
+      return ERR;
+    /* crossing in direct or retrograde motion, not a jump */
+    if ((d1 < 0) != (d2 < 0) && fabs(d2 - d1) < 90) {
+      while (t2 - t1 > HCROSS_PREC) {
+	tm = (t1 + t2) / 2;
+	if (hseries_point(&hs, tm, ipoint, x2cross, &dm, serr) == ERR)
+	  return ERR;
+	if ((dm < 0) == (d1 < 0)) {
+	  t1 = tm;
+	  d1 = dm;
+	} else {
+	  t2 = tm;
+	}
+      }
+      tret[(*nret)++] = t2;
+      t2 = tjd_start + i * HCROSS_STEP;
+      if (t2 > tjd_end)
+	t2 = tjd_end;
+      if (hseries_point(&hs, t2, ipoint, x2cross, &d2, serr) == ERR)
+	return ERR;
+    }
+    t1 = t2;
+    d1 = d2;
+  }
+  return OK;
+}
+
+/* delta t, true obliquity, nutation (0 with SEFLG_NONUT) and 
+ * Greenwich sidereal time in degrees at tjd_ut, as used by all house 
+ * functions with a date; an->sundec is left 0 */
+static void houses_epoch(double tjd_ut, int32 iflag, struct hseries_anchor *an)
+{
+  int i;
+  double eps_mean;
+  if ((iflag & SEFLG_SIDEREAL) && !swed.ayana_is_set)
+    swe_set_sid_mode(SE_SIDM_FAGAN_BRADLEY, 0, 0);
+  an->t = tjd_ut;
+  an->tjde = tjd_ut + swe_deltat_ex(tjd_ut, iflag, NULL);
+  eps_mean = swi_epsiln(an->tjde, 0) * RADTODEG;
+  swi_nutation(an->tjde, 0, an->nutlo);
+  for (i = 0; i < 2; i++)
+    an->nutlo[i] *= RADTODEG;
+  if (iflag & SEFLG_NONUT) {
+    for (i = 0; i < 2; i++)
+      an->nutlo[i] = 0;
+  }
+  an->eps = eps_mean + an->nutlo[1];
+  an->sidt = swe_sidtime0(tjd_ut, an->eps, an->nutlo[0]) * 15;
+  an->sundec = 0;
+}
+
+/* sidereal houses with the method of the current sidereal mode */
+static int sidereal_houses(double tjde, int32 iflag, double armc, double eps, double *nutlo, double lat, int hsys, double *cusp, double *ascmc, double *cusp_speed, double *ascmc_speed, char *serr)
+{
+  if (swed.sidd.sid_mode & SE_SIDBIT_ECL_T0)
+    return sidereal_houses_ecl_t0(tjde, armc, eps, nutlo, lat, hsys, cusp, ascmc, cusp_speed, ascmc_speed, serr);
+  if (swed.sidd.sid_mode & SE_SIDBIT_SSY_PLANE)
+    return sidereal_houses_ssypl(tjde, armc, eps, nutlo, lat, hsys, cusp, ascmc, cusp_speed, ascmc_speed, serr);
+  return sidereal_houses_trad(tjde, iflag, armc, eps, nutlo[0], lat, hsys, cusp, ascmc, cusp_speed, ascmc_speed, serr);
+}
+
 /*
  * houses to sidereal
  * ------------------
@@ -2176,98 +2667,226 @@ static double fix_asc_polar(double asc, double armc, double eps, double geolat)
   return asc;
 }
 
-/* Computes the house position of a planet or another point,
- * in degrees: 0 - 30 = 1st house, 30 - 60 = 2nd house, etc.
- * armc 	sidereal time in degrees
- * geolat	geographic latitude
- * eps		true ecliptic obliquity
- * hsys		house system character
- * xpin		array of 6 doubles:
- * 		only the first two of them are used: ecl. long., lat.
- * serr		error message area
- *
- * House position is returned by function.
- * Currently, geometrically correct house positions are provided 
- * for the following house methods:
- * A/E Equal, V Vehlow, W Whole Signs, D Equal/MC, N Equal/Zodiac,
- * O Porphyry, B Alcabitius, X Meridian, F Carter, M Morinus,
- * P Placidus, K Koch, C Campanus, R Regiomontanus, U Krusinski, 
- * T Topocentric, H Horizon, G Gauquelin.
- *
- * A simplified house position (distance_from_cusp / house_size)
- * is currently provided for the following house methods:
- * Y APC houses, L Pullen SD, Q Pullen SR, I Sunshine, S Sripati.
- *
- * IMPORTANT: This function should NOT be used for sidereal astrology.
- * If you cannot avoid doing so, please note:
- * - The input longitudes (xpin) MUST always be tropical, even if you 
- *   are a siderealist.
- * - Sidereal and tropical house positions are identical for most house
- *   systems, if a traditional definition of the sidereal zodiac is used 
- *   (sid = trop - ayanamsa).
- * - The function does NOT provide correct positions for Whole Sign houses.
- * - The function does NOT provide correct positions, if you use a 
- *   non-traditional sidereal method (where the sidereal plane is not 
- *   identical to the ecliptic of date) with a house system whose definition 
- *   is dependent on the ecliptic, such as: 
- *   equal, Porphyry, Alcabitius, Koch, Krusinski (all others should work).
- * The Swiss Ephemeris currently does not handle these cases.
- */
-double CALL_CONV swe_house_pos(
-	double armc, double geolat, double eps, int hsys, double *xpin, char *serr)
+static void house_frame_init(struct house_frame *hf, double armc, double geolat, double eps, int hsys, char *serr)
 {
-  double xp[6], xeq[6], ra, de, mdd, mdn, sad, san;
-  double hpos, sinad, ad, a, admc, adp, samc, asc, mc, acmc, tant;
-  //double demc;
-  double fh, ra0, tanfi, sinfi, fac, dfac, tanx;
-  double x[3], xasc[3], xs1, xs2, raep, raaz, oblaz, xtemp; /* BK 21.02.2006 */
-  double hcusp[37], ascmc[10];
-  double sine = sind(eps);
-  double cose = cosd(eps);
-  double c1, c2, d, hsize;
-  int i, j, nloop;
-  double dsun = 0, darmc, harmc, y, sinpsi, sa;
-  AS_BOOL is_western_half = FALSE;
+  double x[3], xasc[3], xeq[3], raep, tanx, xtemp, dek, r, sinfi, xs1, xs2;
   hsys = toupper(hsys);
-  if (1) {
-    /* input is a house cusp: no calculation is required */
-    ascmc[9] = 99;// dirty hack. Sunshine house system needs sun declination
+  hf->armc = armc;
+  hf->geolat = geolat;
+  hf->eps = eps;
+  hf->hsys = hsys;
+  hf->sine = sind(eps);
+  hf->cose = cosd(eps);
+  hf->dsun = 0;
+  /* cusps, for input that is a house cusp */
+  hf->ascmc[9] = 99;// dirty hack. Sunshine house system needs sun declination
 		  // which we do not know. If it sees ascmc[9] == 99, it uses
 		  // the one is saved from last call. can lead to bugs, but can 
 		  // also solve many problems.
-    if (swe_houses_armc_ex2(armc, geolat, eps, hsys, hcusp, ascmc, NULL, NULL, serr) == ERR) {
-      if (serr != NULL)
-	sprintf(serr, "swe_house_pos(): failed for system %c", hsys);
-    } else {
-      hpos = 0;
-      for (i = 1; i <= 12; i++) {
-	if (fabs(swe_difdeg2n(xpin[0], hcusp[i])) < MILLIARCSEC && xpin[1] == 0) {
-	  hpos = (double) i;
-	}
+  hf->cusps_ok = (swe_houses_armc_ex2(armc, geolat, eps, hsys, hf->hcusp, hf->ascmc, NULL, NULL, serr) != ERR);
+  if (hf->cusps_ok) {
+    // for Sunshine houses: declination of Sun
+    if (hsys == 'I')
+      hf->dsun = hf->ascmc[9];  
+    // for APC houses: declination of ascendant into dsun
+    if (hsys == 'Y') {
+      xeq[0] = hf->ascmc[0];
+      xeq[1] = 0;
+      xeq[2] = 1;
+      swe_cotrans(xeq, xeq, -eps);
+      hf->dsun = xeq[1]; 
+    }
+  }
+  switch(hsys) {
+    case 'A': case 'E': case 'D': case 'V': case 'W':
+    case 'O': case 'B': case 'S': case 'F':
+      hf->asc = Asc1(swe_degnorm(armc + 90), geolat, hf->sine, hf->cose);
+      hf->mc = armc_to_mc(armc, eps);
+      /* while MC is always south,
+       * Asc must always be in eastern hemisphere */
+      hf->asc = fix_asc_polar(hf->asc, armc, eps, geolat);
+      if (hsys == 'B') {
+	dek = asind(sind(hf->asc) * hf->sine);	/* declination of Ascendant */
+	/* must treat the case fi == 90 or -90 */
+	r = -tand(geolat) * tand(dek);
+	/* must treat the case of abs(r) > 1; probably does not happen
+	 * because dek becomes smaller when fi is large, as ac is close to
+	 * zero Aries/Libra in that case.
+	 */
+	hf->sda = acos(r) * RADTODEG;	/* semidiurnal arc, measured on equator */
+	hf->sna = 180 - hf->sda;	/* complement, seminocturnal arc */
       }
-      for (i = 1; i <= 12; i += 3) {
-	if (fabs(swe_difdeg2n(xpin[0], hcusp[i])) < MILLIARCSEC && xpin[1] == 0) {
-	  xp[0] = (double) i;
-	}
+      if (hsys == 'F') {
+	x[0] = hf->asc;
+	x[1] = 0;
+	x[2] = 1;
+	swe_cotrans(x, x, -eps);
+	hf->raasc = x[0];
+      }
+      break;
+    case 'K':
+      hf->mc_circumpolar = FALSE;
+      hf->admc = tand(eps) * tand(geolat) * sind(armc);
+      /* midheaven is circumpolar */
+      if (fabs(hf->admc) > 1) {
+	if (hf->admc > 1)
+	  hf->admc = 1;
+	else
+	  hf->admc = -1;
+	hf->mc_circumpolar = TRUE;
+      }
+      hf->admc = asind(hf->admc);
+      hf->samc = 90 + hf->admc;
+      break;
+    case 'J':
+      sinfi = sind(geolat);
+      if (fabs(geolat) < VERY_SMALL) {	
+	xs2 = 1 / 3.0;
+	xs1 = 2 / 3.0;
+      } else {
+	xs2 = sind(geolat / 3) / sinfi;	
+	xs1 = sind(2 * geolat / 3) / sinfi;
       }
-      if (hpos > 0)
-	return hpos;
-      // for Sunshine houses: declination of Sun
-      if (hsys == 'I')
-	dsun = ascmc[9];  
-      // for APC houses: declination of ascendant into dsun
-      if (hsys == 'Y') {
-	xeq[0] = ascmc[0];
-	xeq[1] = 0;
-	xeq[2] = 1;
-	swe_cotrans(xeq, xeq, -eps);
-	dsun = xeq[1]; 
+      xs2 = asind(xs2);
+      xs1 = asind(xs1);
+      // xs1 and xs2 always in >= 0 < 90
+      // house borders on prime vertical are, measured from EP downwards
+      // h1 = 0, h4 = 90, h7 = 180, h10 = 270
+      // h2 = xs2, h3 = xs1, h12 = 360 - xs2, h11 = 360 - xs1
+      // h5 = h11 - 180, h6 = h12 - 180, h8 = h2 + 180, h9 = h3 + 180
+      hf->scusp[1] = 0;
+      hf->scusp[2] = xs2;
+      hf->scusp[3] = xs1;
+      hf->scusp[4] = 90;
+      hf->scusp[5] = 180 - xs1;
+      hf->scusp[6] = 180 - xs2;
+      hf->scusp[7] = 180;
+      hf->scusp[8] = 180 + xs2;
+      hf->scusp[9] = 180 + xs1;
+      hf->scusp[10] = 270;
+      hf->scusp[11] = 360 - xs1;
+      hf->scusp[12] = 360 - xs2;
+      break;
+    case 'U': /* Krusinski-Pisa-Goelzer */
+      if (fabs(geolat) < VERY_SMALL) {	/* code below does not like geolat 0 */
+        geolat = (geolat >= 0) ? VERY_SMALL : -VERY_SMALL;
       }
+      /* Purpose: find point where planet's house circle (meridian)
+       *   cuts house plane, giving exact planet's house position.
+       * Input data: ramc, geolat, asc.
+       */
+      hf->asc = Asc1(swe_degnorm(armc + 90), geolat, hf->sine, hf->cose);
+      /* while MC is always south, 
+       * Asc must always be in eastern hemisphere */
+      hf->asc = fix_asc_polar(hf->asc, armc, eps, geolat);
+      /*
+       * Descr: find the house plane 'asc-zenith' - where it intersects 
+       * with equator and at what angle, and then simple find arc 
+       * from asc on that plane to planet's meridian intersection 
+       * with this plane.
+       */
+      /* I. find plane of 'asc-zenith' great circle relative to equator: 
+       *   solve spherical triangle 'EP-asc-intersection of house circle with equator' */
+      /* Ia. Find intersection of house plane with equator: */
+      x[0] = hf->asc; x[1] = 0.0; x[2] = 1.0;      /* 1. Start with ascendent on ecliptic     */
+      swe_cotrans(x, x, -eps);                     /* 2. Transform asc into equatorial coords */
+      raep = swe_degnorm(armc + 90);               /* 3. RA of east point                     */
+      x[0] = swe_degnorm(raep - x[0]);             /* 4. Rotation - found arc raas-raep      */
+      swe_cotrans(x, x, -(90-geolat));             /* 5. Transform into horizontal coords - arc EP-asc on horizon */
+      tanx = tand(x[0]);
+      if (geolat == 0) {
+        xtemp = (tanx >= 0) ? 90 : -90;
+      } else {
+	xtemp = atand(tanx/cosd((90-geolat))); /* 6. Rotation from horizon on circle perpendicular to equator */
+      }
+      if (x[0] > 90 && x[0] <= 270)
+	xtemp = swe_degnorm(xtemp + 180);
+      x[0] = swe_degnorm(xtemp);        
+      hf->raaz = swe_degnorm(raep - x[0]); /* result: RA of intersection 'asc-zenith' great circle with equator */
+      /* Ib. Find obliquity to equator of 'asc-zenith' house plane: */
+      x[0] = hf->raaz; x[1] = 0.0; 
+      x[0] = swe_degnorm(raep - x[0]);  /* 1. Rotate start point relative to EP   */
+      swe_cotrans(x, x, -(90-geolat));  /* 2. Transform into horizontal coords    */
+      x[1] = x[1] + 90;                 /* 3. Add 90 deg do decl - so get the point on house plane most distant from equ. */
+      swe_cotrans(x, x, 90-geolat);     /* 4. Rotate back to equator              */
+      hf->oblaz = x[1];                 /* 5. Obliquity of house plane to equator */
+      /* II. Next find asc and planet position on house plane, 
+       *     so to find relative distance of planet from 
+       *     coords beginning. */
+      /* IIa. Asc on house plane relative to intersection 
+       *      of equator with 'asc-zenith' plane. */
+      xasc[0] = hf->asc; xasc[1] = 0.0; xasc[2] = 1.0;
+      swe_cotrans(xasc, xasc, -eps);
+      xasc[0] = swe_degnorm(xasc[0] - hf->raaz);
+      xtemp = atand(tand(xasc[0])/cosd(hf->oblaz));
+      if (xasc[0] > 90 && xasc[0] <= 270)
+          xtemp = swe_degnorm(xtemp + 180);
+      hf->xasc0 = swe_degnorm(xtemp);
+      break;
+    default:
+      break;
+  }
+}
+
+/* position of a circle in houses with cusps hcusp[1 ... 12] */
+static double house_pos_cusps(double *hcusp, double a)
+{
+  int i, j;
+  double c1, c2, d, hsize;
+  if (swe_difdeg2n(hcusp[6], hcusp[1]) > 0) {
+    d = swe_degnorm(a - hcusp[1]);
+    for (i = 1; i <= 12; i++) {
+      j = i + 1;
+      if (j > 12) 
+	c2 = 360;
+      else 
+	c2 = swe_degnorm(hcusp[j] - hcusp[1]);
+      if (d < c2) break;
+    }
+    c1 = swe_degnorm(hcusp[i] - hcusp[1]);
+  } else {  // houses retrograde
+    d = swe_degnorm(hcusp[1] - a);
+    for (i = 1; i <= 12; i++) {
+      j = i + 1;
+      if (j > 12) 
+	c2 = 360;
+      else 
+	c2 = swe_degnorm(hcusp[1] - hcusp[j]);
+      if (d < c2) break;
     }
+    c1 = swe_degnorm(hcusp[1] - hcusp[i]);
   }
+  hsize = c2 - c1;
+  if (hsize == 0)
+    return i;
+  return i + (d - c1) / hsize;
+}
+
+/* house position of one point in a frame from house_frame_init() */
+static double house_pos_frame(const struct house_frame *hf, double *xpin, char *serr)
+{
+  double xp[6], xeq[6], ra, de, mdd, mdn, sad, san;
+  double hpos, sinad, ad, a, adp, tant;
+  double fh, ra0, tanfi, fac, x[3], xtemp;
+  double armc = hf->armc, geolat = hf->geolat, eps = hf->eps;
+  double cose = hf->cose;
+  int i, nloop, hsys = hf->hsys;
+  double dsun = hf->dsun, darmc, harmc, y, sinpsi, sa, d;
+  AS_BOOL is_western_half = FALSE;
   AS_BOOL is_above_hor = FALSE;
   AS_BOOL is_invalid = FALSE;
   AS_BOOL is_circumpolar = FALSE;
+  /* input is a house cusp: no calculation is required */
+  if (hf->cusps_ok && xpin[1] == 0) {
+    hpos = 0;
+    for (i = 1; i <= 12; i++) {
+      if (fabs(swe_difdeg2n(xpin[0], hf->hcusp[i])) < MILLIARCSEC) {
+	hpos = (double) i;
+      }
+    }
+    if (hpos > 0)
+      return hpos;
+  }
   if (serr != NULL)
     *serr = '\0';
   xeq[0] = xpin[0];
@@ -2293,16 +2912,13 @@ double CALL_CONV swe_house_pos(
     case 'D': // equal (MC)
     case 'V': // Vehlow
     case 'W': // whole signs
-      asc = Asc1(swe_degnorm(armc + 90), geolat, sine, cose);
-      mc = armc_to_mc(armc, eps);
-      asc = fix_asc_polar(asc, armc, eps, geolat);
-      xp[0] = swe_degnorm(xpin[0] - asc);
+      xp[0] = swe_degnorm(xpin[0] - hf->asc);
       if (hsys == 'V')
 	xp[0] = swe_degnorm(xp[0] + 15);
       if (hsys == 'W')
-	xp[0] = swe_degnorm(xp[0] + fmod(asc, 30));
+	xp[0] = swe_degnorm(xp[0] + fmod(hf->asc, 30));
       if (hsys == 'D')
-	xp[0] = swe_degnorm(xpin[0] - mc - 90);
+	xp[0] = swe_degnorm(xpin[0] - hf->mc - 90);
       /* to make sure that a call with a house cusp position returns
        * a value within the house, 0.001" is added */
       xp[0] = swe_degnorm(xp[0] + MILLIARCSEC);
@@ -2311,14 +2927,9 @@ double CALL_CONV swe_house_pos(
     case 'O':  /* Porphyry */
     case 'B':  /* Alcabitius */
     case 'S':  /* Sripati */
-      asc = Asc1(swe_degnorm(armc + 90), geolat, sine, cose);
-      /* mc */
-      mc = armc_to_mc(armc, eps);
-      /* while MC is always south,
-       * Asc must always be in eastern hemisphere */
-      asc = fix_asc_polar(asc, armc, eps, geolat);
       if (hsys ==  'O' || hsys == 'S') {
-	xp[0] = swe_degnorm(xpin[0] - asc);
+	double acmc;
+	xp[0] = swe_degnorm(xpin[0] - hf->asc);
 	/* to make sure that a call with a house cusp position returns
 	 * a value within the house, 0.001" is added */
 	xp[0] = swe_degnorm(xp[0] + MILLIARCSEC);
@@ -2328,7 +2939,7 @@ double CALL_CONV swe_house_pos(
 	  hpos = 7;
 	  xp[0] -= 180;
 	}
-	acmc = swe_difdeg2n(asc, mc);
+	acmc = swe_difdeg2n(hf->asc, hf->mc);
 	if (xp[0] < 180 - acmc)
 	  hpos += xp[0] * 3 / (180 - acmc);
 	else
@@ -2338,17 +2949,7 @@ double CALL_CONV swe_house_pos(
 	  if (hpos > 12) hpos = 1;
 	}
       } else { /* Alcabitius */
-	double dek, r, sna, sda;
-	dek = asind(sind(asc) * sine);	/* declination of Ascendant */
-	/* must treat the case fi == 90 or -90 */
-	tanfi = tand(geolat);
-	r = -tanfi * tand(dek);
-	/* must treat the case of abs(r) > 1; probably does not happen
-	 * because dek becomes smaller when fi is large, as ac is close to
-	 * zero Aries/Libra in that case.
-	 */
-	sda = acos(r) * RADTODEG;	/* semidiurnal arc, measured on equator */
-	sna = 180 - sda;		/* complement, seminocturnal arc */
+	double sda = hf->sda, sna = hf->sna;
 	if (mdd > 0) {
 	  if (mdd < sda) 
 	    hpos = mdd * 90 / sda;
@@ -2368,11 +2969,7 @@ double CALL_CONV swe_house_pos(
       hpos = swe_degnorm(mdd - 90) / 30.0 + 1.0;
       break;
     case 'F': /* Carter poli-equatorial */
-      x[0] = Asc1(swe_degnorm(armc + 90), geolat, sine, cose);
-      x[0] = fix_asc_polar(x[0], armc, eps, geolat);
-      x[1] = 0;
-      swe_cotrans(x, x, -eps);
-      hpos = swe_degnorm(ra - x[0]) / 30.0 + 1;
+      hpos = swe_degnorm(ra - hf->raasc) / 30.0 + 1;
       break;
     case 'M': { /* Morinus */
       double a = xpin[0];
@@ -2395,10 +2992,10 @@ double CALL_CONV swe_house_pos(
     /* version of Koch method: do calculations within circumpolar circle,
      * if possible; make sure house positions 4 - 9 only appear on western
      * hemisphere */
-    case 'K': // Koch
-      //demc = atand(sind(armc) * tand(eps));
+    case 'K': { // Koch
+      double admc = hf->admc, samc = hf->samc, dfac;
       is_invalid = FALSE;
-      is_circumpolar = FALSE;
+      is_circumpolar = hf->mc_circumpolar;
       /* object is within a circumpolar circle */
       if (90 - geolat < de || -90 - geolat > de) {
         adp = 90;
@@ -2413,17 +3010,6 @@ double CALL_CONV swe_house_pos(
       else {
 	adp = asind(tand(geolat) * tand(de));
       }
-      admc = tand(eps) * tand(geolat) * sind(armc);
-      /* midheaven is circumpolar */
-      if (fabs(admc) > 1) {
-	if (admc > 1)
-	  admc = 1;
-	else
-	  admc = -1;
-	is_circumpolar = TRUE;
-      }
-      admc = asind(admc);
-      samc = 90 + admc;
       if (samc == 0)
         is_invalid = TRUE;
       if (fabs(samc) > 0) {
@@ -2457,6 +3043,7 @@ double CALL_CONV swe_house_pos(
       /* to make sure that a call with a house cusp position returns
        * a value within the house, 0.001" is added */
       hpos = xp[0] / 30.0 + 1;
+    }
       break;
     case 'C': // Campanus
       xeq[0] = swe_degnorm(mdd - 90);
@@ -2470,133 +3057,23 @@ double CALL_CONV swe_house_pos(
       hpos = xp[0] / 30.0 + 1;
       break;
     case 'J': // Savard-A
-      sinfi = sind(geolat);
-      if (fabs(geolat) < VERY_SMALL) {	
-	xs2 = 1 / 3.0;
-	xs1 = 2 / 3.0;
-      } else {
-	xs2 = sind(geolat / 3) / sinfi;	
-	xs1 = sind(2 * geolat / 3) / sinfi;
-      }
-      xs2 = asind(xs2);
-      xs1 = asind(xs1);
-      // xs1 and xs2 always in >= 0 < 90
-      // house borders on prime vertical are, measured from EP downwards
-      // h1 = 0, h4 = 90, h7 = 180, h10 = 270
-      // h2 = xs2, h3 = xs1, h12 = 360 - xs2, h11 = 360 - xs1
-      // h5 = h11 - 180, h6 = h12 - 180, h8 = h2 + 180, h9 = h3 + 180
-      hcusp[1] = 0;
-      hcusp[2] = xs2;
-      hcusp[3] = xs1;
-      hcusp[4] = 90;
-      hcusp[5] = 180 - xs1;
-      hcusp[6] = 180 - xs2;
-      hcusp[7] = 180;
-      hcusp[8] = 180 + xs2;
-      hcusp[9] = 180 + xs1;
-      hcusp[10] = 270;
-      hcusp[11] = 360 - xs1;
-      hcusp[12] = 360 - xs2;
       xeq[0] = swe_degnorm(mdd - 90);
       swe_cotrans(xeq, xp, -geolat);
-      a = xp[0];
-      if (swe_difdeg2n(hcusp[6], hcusp[1]) > 0) {
-	d = swe_degnorm(a - hcusp[1]);
-	for (i = 1; i <= 12; i++) {
-	  j = i + 1;
-	  if (j > 12) 
-	    c2 = 360;
-	  else 
-	    c2 = swe_degnorm(hcusp[j] - hcusp[1]);
-	  if (d < c2) break;
-	}
-	c1 = swe_degnorm(hcusp[i] - hcusp[1]);
-      } else {  // houses retrograde
-	d = swe_degnorm(hcusp[1] - a);
-	for (i = 1; i <= 12; i++) {
-	  j = i + 1;
-	  if (j > 12) 
-	    c2 = 360;
-	  else 
-	    c2 = swe_degnorm(hcusp[1] - hcusp[j]);
-	  if (d < c2) break;
-	}
-	c1 = swe_degnorm(hcusp[1] - hcusp[i]);
-      }
-      hsize = c2 - c1;
-      if (hsize == 0) {
-	hpos = i;
-      } else {
-	hpos = i + (d - c1) / hsize;
-      }
+      hpos = house_pos_cusps((double *) hf->scusp, xp[0]);
       break;
     case 'U': /* Krusinski-Pisa-Goelzer */
-      if (fabs(geolat) < VERY_SMALL) {	/* code below does not like geolat 0 */
-        geolat = (geolat >= 0) ? VERY_SMALL : -VERY_SMALL;
-      }
-      /* Purpose: find point where planet's house circle (meridian)
-       *   cuts house plane, giving exact planet's house position.
-       * Input data: ramc, geolat, asc.
-       */
-      asc = Asc1(swe_degnorm(armc + 90), geolat, sine, cose);
-      /* while MC is always south, 
-       * Asc must always be in eastern hemisphere */
-      asc = fix_asc_polar(asc, armc, eps, geolat);
-      /*
-       * Descr: find the house plane 'asc-zenith' - where it intersects 
-       * with equator and at what angle, and then simple find arc 
-       * from asc on that plane to planet's meridian intersection 
-       * with this plane.
-       */
-      /* I. find plane of 'asc-zenith' great circle relative to equator: 
-       *   solve spherical triangle 'EP-asc-intersection of house circle with equator' */
-      /* Ia. Find intersection of house plane with equator: */
-      x[0] = asc; x[1] = 0.0; x[2] = 1.0;          /* 1. Start with ascendent on ecliptic     */
-      swe_cotrans(x, x, -eps);                     /* 2. Transform asc into equatorial coords */
-      raep = swe_degnorm(armc + 90);               /* 3. RA of east point                     */
-      x[0] = swe_degnorm(raep - x[0]);             /* 4. Rotation - found arc raas-raep      */
-      swe_cotrans(x, x, -(90-geolat));             /* 5. Transform into horizontal coords - arc EP-asc on horizon */
-      tanx = tand(x[0]);
-      if (geolat == 0) {
-        xtemp = (tanx >= 0) ? 90 : -90;
-      } else {
-	xtemp = atand(tanx/cosd((90-geolat))); /* 6. Rotation from horizon on circle perpendicular to equator */
-      }
-      if (x[0] > 90 && x[0] <= 270)
-	xtemp = swe_degnorm(xtemp + 180);
-      x[0] = swe_degnorm(xtemp);        
-      raaz = swe_degnorm(raep - x[0]); /* result: RA of intersection 'asc-zenith' great circle with equator */
-      /* Ib. Find obliquity to equator of 'asc-zenith' house plane: */
-      x[0] = raaz; x[1] = 0.0; 
-      x[0] = swe_degnorm(raep - x[0]);  /* 1. Rotate start point relative to EP   */
-      swe_cotrans(x, x, -(90-geolat));  /* 2. Transform into horizontal coords    */
-      x[1] = x[1] + 90;                 /* 3. Add 90 deg do decl - so get the point on house plane most distant from equ. */
-      swe_cotrans(x, x, 90-geolat);     /* 4. Rotate back to equator              */
-      oblaz = x[1];                     /* 5. Obliquity of house plane to equator */
-      /* II. Next find asc and planet position on house plane, 
-       *     so to find relative distance of planet from 
-       *     coords beginning. */
-      /* IIa. Asc on house plane relative to intersection 
-       *      of equator with 'asc-zenith' plane. */
-      xasc[0] = asc; xasc[1] = 0.0; xasc[2] = 1.0;
-      swe_cotrans(xasc, xasc, -eps);
-      xasc[0] = swe_degnorm(xasc[0] - raaz);
-      xtemp = atand(tand(xasc[0])/cosd(oblaz));
-      if (xasc[0] > 90 && xasc[0] <= 270)
-          xtemp = swe_degnorm(xtemp + 180);
-      xasc[0] = swe_degnorm(xtemp);
       /* IIb. Planet on house plane relative to intersection 
        *      of equator with 'asc-zenith' plane */
-      xp[0] = swe_degnorm(xeq[0] - raaz);        /* Rotate on equator  */
-      xtemp = atand(tand(xp[0])/cosd(oblaz));    /* Find arc on house plane from equator */
+      xp[0] = swe_degnorm(xeq[0] - hf->raaz);        /* Rotate on equator  */
+      xtemp = atand(tand(xp[0])/cosd(hf->oblaz));    /* Find arc on house plane from equator */
       if (xp[0] > 90 && xp[0] <= 270)
 	xtemp = swe_degnorm(xtemp + 180);
       xp[0] = swe_degnorm(xtemp);
-      xp[0] = swe_degnorm(xp[0]-xasc[0]); /* find arc between asc and planet, and get planet house position  */
+      xp[0] = swe_degnorm(xp[0] - hf->xasc0); /* find arc between asc and planet, and get planet house position  */
       /* IIc. Distance from planet to house plane on declination circle: */
       x[0] = xeq[0];
       x[1] = xeq[1];
-      swe_cotrans(x, x, oblaz);
+      swe_cotrans(x, x, hf->oblaz);
       xp[1] = xeq[1] - x[1]; /* How many degrees is the point on declination circle from house circle */
       /* to make sure that a call with a house cusp position returns
        * a value within the house, 0.001" is added */
@@ -2833,41 +3310,13 @@ double CALL_CONV swe_house_pos(
       }
     break;
   default:
-    hpos = 0;
-    if (swe_houses_armc_ex2(armc, geolat, eps, hsys, hcusp, ascmc, NULL, NULL, serr) == ERR) {
+    if (!hf->cusps_ok) {
+      hpos = 0;
       if (serr != NULL)
 	sprintf(serr, "swe_house_pos(): failed for system %c", hsys);
       break;
     }
-    if (swe_difdeg2n(hcusp[6], hcusp[1]) > 0) {
-      d = swe_degnorm(xpin[0] - hcusp[1]);
-      for (i = 1; i <= 12; i++) {
-	j = i + 1;
-	if (j > 12) 
-	  c2 = 360;
-	else 
-	  c2 = swe_degnorm(hcusp[j] - hcusp[1]);
-	if (d < c2) break;
-      }
-      c1 = swe_degnorm(hcusp[i] - hcusp[1]);
-    } else {  // houses retrograde
-      d = swe_degnorm(hcusp[1] - xpin[0]);
-      for (i = 1; i <= 12; i++) {
-	j = i + 1;
-	if (j > 12) 
-	  c2 = 360;
-	else 
-	  c2 = swe_degnorm(hcusp[1] - hcusp[j]);
-	if (d < c2) break;
-      }
-      c1 = swe_degnorm(hcusp[1] - hcusp[i]);
-    }
-    hsize = c2 - c1;
-    if (hsize == 0) {
-      hpos = i;
-    } else {
-      hpos = i + (d - c1) / hsize;
-    }
+    hpos = house_pos_cusps((double *) hf->hcusp, xpin[0]);
     if (serr != NULL)
       sprintf(serr, "swe_house_pos(): using simplified algorithm for system %c\n", hsys);
     break;
@@ -2875,6 +3324,85 @@ double CALL_CONV swe_house_pos(
   return hpos;
 }
 
+/* Computes the house position of a planet or another point,
+ * in degrees: 0 - 30 = 1st house, 30 - 60 = 2nd house, etc.
+ * armc 	sidereal time in degrees
+ * geolat	geographic latitude
+ * eps		true ecliptic obliquity
+ * hsys		house system character
+ * xpin		array of 6 doubles:
+ * 		only the first two of them are used: ecl. long., lat.
+ * serr		error message area
+ *
+ * House position is returned by function.
+ * Currently, geometrically correct house positions are provided 
+ * for the following house methods:
+ * A/E Equal, V Vehlow, W Whole Signs, D Equal/MC, N Equal/Zodiac,
+ * O Porphyry, B Alcabitius, X Meridian, F Carter, M Morinus,
+ * P Placidus, K Koch, C Campanus, R Regiomontanus, U Krusinski, 
+ * T Topocentric, H Horizon, G Gauquelin.
+ *
+ * A simplified house position (distance_from_cusp / house_size)
+ * is currently provided for the following house methods:
+ * Y APC houses, L Pullen SD, Q Pullen SR, I Sunshine, S Sripati.
+ *
+ * IMPORTANT: This function should NOT be used for sidereal astrology.
+ * If you cannot avoid doing so, please note:
+ * - The input longitudes (xpin) MUST always be tropical, even if you 
+ *   are a siderealist.
+ * - Sidereal and tropical house positions are identical for most house
+ *   systems, if a traditional definition of the sidereal zodiac is used 
+ *   (sid = trop - ayanamsa).
+ * - The function does NOT provide correct positions for Whole Sign houses.
+ * - The function does NOT provide correct positions, if you use a 
+ *   non-traditional sidereal method (where the sidereal plane is not 
+ *   identical to the ecliptic of date) with a house system whose definition 
+ *   is dependent on the ecliptic, such as: 
+ *   equal, Porphyry, Alcabitius, Koch, Krusinski (all others should work).
+ * The Swiss Ephemeris currently does not handle these cases.
+ */
+double CALL_CONV swe_house_pos(
+	double armc, double geolat, double eps, int hsys, double *xpin, char *serr)
+{
+  struct house_frame hf;
+  house_frame_init(&hf, armc, geolat, eps, hsys, serr);
+  return house_pos_frame(&hf, xpin, serr);
+}
+
+/* House positions of many points in one house frame, e.g. all bodies
+ * of a chart. The quantities that depend only on armc, geolat, eps and
+ * hsys, i.e. the cusps, the ascendant, the MC and the house planes, are
+ * computed once.
+ * n		number of points
+ * xpin		ecliptic longitude and latitude of point i in
+ *		xpin[2 * i] and xpin[2 * i + 1]
+ * hpos		house positions hpos[0 ... n - 1], as from swe_house_pos()
+ * serr		the first message of swe_house_pos() for any point
+ * Function returns OK, or ERR if n < 0.
+ */
+int32 CALL_CONV swe_house_pos_batch(
+	double armc, double geolat, double eps, int hsys, int32 n, double *xpin, double *hpos, char *serr)
+{
+  int32 i;
+  struct house_frame hf;
+  char serr1[AS_MAXCH];
+  if (serr != NULL)
+    *serr = '\0';
+  if (n < 0) {
+    if (serr != NULL)
+      sprintf(serr, "swe_house_pos_batch(): invalid number of points %d", n);
+    return ERR;
+  }
+  house_frame_init(&hf, armc, geolat, eps, hsys, NULL);
+  for (i = 0; i < n; i++) {
+    *serr1 = '\0';
+    hpos[i] = house_pos_frame(&hf, xpin + 2 * i, serr1);
+    if (serr != NULL && *serr == '\0' && *serr1 != '\0')
+      strcpy(serr, serr1);
+  }
+  return OK;
+}
+
 static int sunshine_init(double lat, double dec, double xh[])
 {
   double ad, nsa, dsa, arg;
@@ -83,6 +83,44 @@ struct houses {
 	  char serr[AS_MAXCH];
 	};
 
+/* quantities of swe_house_pos() that depend only on the house frame */
+struct house_frame {
+	  double armc, geolat, eps, sine, cose;
+	  int hsys;
+	  AS_BOOL cusps_ok;
+	  double hcusp[37], ascmc[10];
+	  double dsun;		/* declination of Sun (I) or of ascendant (Y) */
+	  double asc, mc;	/* ascendant, eastern hemisphere, and MC */
+	  double raasc;		/* right ascension of ascendant, Carter */
+	  double sda, sna;	/* diurnal/nocturnal semi-arc of ascendant, Alcabitius */
+	  double admc, samc;	/* Koch */
+	  AS_BOOL mc_circumpolar;
+	  double raaz, oblaz, xasc0;	/* Krusinski house plane */
+	  double scusp[13];	/* Savard-A cusps on prime vertical */
+	};
+
+/* exact sidereal time, obliquity and nutation at an anchor 
+ * of a house time series */
+struct hseries_anchor {
+	  double t;		/* UT */
+	  double tjde;
+	  double sidt;		/* Greenwich sidereal time in degrees */
+	  double eps;		/* true obliquity */
+	  double nutlo[2];
+	  double sundec;	/* declination of Sun for Sunshine houses */
+	};
+
+/* state of a house time series, s. swe_houses_series() */
+struct houses_series {
+	  int32 iflag;
+	  int hsys;
+	  double geolat, geolon;
+	  double t0;		/* start of first anchor interval */
+	  int32 k;		/* current anchor interval, if has_anchor */
+	  AS_BOOL has_anchor;	/* a and b are valid for interval k */
+	  struct hseries_anchor a, b;
+	};
+
 #define HOUSES 	struct houses
 #define VERY_SMALL	1E-10
 
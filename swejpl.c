@@ -71,7 +71,14 @@
 #include <string.h>
 #include "swephexp.h"
 #include "sweph.h"
+#include "swephlib.h"
 #include "swejpl.h"
+#if SWI_USE_AVX2
+# include <immintrin.h>
+#endif
+#if SWI_USE_NEON
+# include <arm_neon.h>
+#endif
 
 #if MSDOS
   typedef __int64 off_t64;
@@ -98,6 +105,8 @@ struct jpl_save {
   char *jplfname;
   char *jplfpath;
   FILE *jplfptr;
+  unsigned char *mptr;	/* read-only mapping of the file, s. SWI_USE_MMAP */
+  size_t mlen;
   short do_reorder;
   double eh_cval[400]; 
   double eh_ss[3], eh_au, eh_emrat;
@@ -106,7 +115,10 @@ struct jpl_save {
   double pv[78];
   double pvsun[6];
   double buf[1500];
+  double *bufp;		/* current record, buf[] or inside the mapping */
   double pc[18], vc[18], ac[18], jc[18];
+  int np, nv, nac, njk;	/* numbers of polynomials in pc[], vc[] etc. */
+  double twot;
   short do_km;
 };
 
@@ -448,6 +460,94 @@ int swi_pleph(double et, int ntarg, int ncent, double *rrd, char *serr)
   return OK;
 } 
 
+#if SWI_USE_AVX2
+/* position (and velocity if ifl == 2) of three components, whose 
+ * coefficients follow each other at b, with AVX2. The sums are formed
+ * in the same order as in interp(), the results are bit-identical. */
+__attribute__((target("avx2")))
+static void interp_pv3_avx2(double *b, double *pc, double *vc, int ncf, 
+		  int ifl, double bma, double *pv)
+{
+  int j;
+  double *b1 = b + ncf, *b2 = b + 2 * ncf;
+  double v[4];
+  __m256d c, p = _mm256_setzero_pd(), d = _mm256_setzero_pd();
+  if (ifl == 2) {
+    for (j = ncf - 1; j >= 1; --j) {
+      c = _mm256_set_pd(0, b2[j], b1[j], b[j]);
+      p = _mm256_add_pd(p, _mm256_mul_pd(_mm256_set1_pd(pc[j]), c));
+      d = _mm256_add_pd(d, _mm256_mul_pd(_mm256_set1_pd(vc[j]), c));
+    }
+  } else {
+    for (j = ncf - 1; j >= 1; --j) {
+      c = _mm256_set_pd(0, b2[j], b1[j], b[j]);
+      p = _mm256_add_pd(p, _mm256_mul_pd(_mm256_set1_pd(pc[j]), c));
+    }
+  }
+  c = _mm256_set_pd(0, b2[0], b1[0], b[0]);
+  p = _mm256_add_pd(p, _mm256_mul_pd(_mm256_set1_pd(pc[0]), c));
+  _mm256_storeu_pd(v, p);
+  pv[0] = v[0]; pv[1] = v[1]; pv[2] = v[2];
+  if (ifl == 2) {
+    _mm256_storeu_pd(v, _mm256_mul_pd(d, _mm256_set1_pd(bma)));
+    pv[3] = v[0]; pv[4] = v[1]; pv[5] = v[2];
+  }
+}
+#endif /* SWI_USE_AVX2 */
+
+#if SWI_USE_NEON
+/* the same with NEON; x and y in one vector, z in the other */
+static void interp_pv3_neon(double *b, double *pc, double *vc, int ncf, 
+		  int ifl, double bma, double *pv)
+{
+  int j;
+  double *b1 = b + ncf, *b2 = b + 2 * ncf;
+  float64x2_t c01, c2, pj, vj;
+  float64x2_t p01 = vdupq_n_f64(0), p2 = vdupq_n_f64(0);
+  float64x2_t d01 = vdupq_n_f64(0), d2 = vdupq_n_f64(0);
+  for (j = ncf - 1; j >= 0; --j) {
+    c01 = vsetq_lane_f64(b1[j], vdupq_n_f64(b[j]), 1);
+    c2 = vdupq_n_f64(b2[j]);
+    pj = vdupq_n_f64(pc[j]);
+    p01 = vaddq_f64(p01, vmulq_f64(pj, c01));
+    p2 = vaddq_f64(p2, vmulq_f64(pj, c2));
+    if (ifl == 2 && j >= 1) {
+      vj = vdupq_n_f64(vc[j]);
+      d01 = vaddq_f64(d01, vmulq_f64(vj, c01));
+      d2 = vaddq_f64(d2, vmulq_f64(vj, c2));
+    }
+  }
+  pv[0] = vgetq_lane_f64(p01, 0);
+  pv[1] = vgetq_lane_f64(p01, 1);
+  pv[2] = vgetq_lane_f64(p2, 0);
+  if (ifl == 2) {
+    pv[3] = vgetq_lane_f64(d01, 0) * bma;
+    pv[4] = vgetq_lane_f64(d01, 1) * bma;
+    pv[5] = vgetq_lane_f64(d2, 0) * bma;
+  }
+}
+#endif /* SWI_USE_NEON */
+
+/* position and velocity of three components with the SIMD kernel
+ * selected by swi_simd_level(); interp() does it with scalar code */
+static void interp_pv3(double *b, int ncf, int ifl, double bma, double *pv)
+{
+  switch (swi_simd_level()) {
+#if SWI_USE_AVX2
+    case SWI_SIMD_AVX2:
+      interp_pv3_avx2(b, js->pc, js->vc, ncf, ifl, bma, pv);
+      break;
+#endif
+#if SWI_USE_NEON
+    case SWI_SIMD_NEON:
+      interp_pv3_neon(b, js->pc, js->vc, ncf, ifl, bma, pv);
+      break;
+#endif
+    default:
+      break;
+  }
+}
+
 /*
  *  This subroutine differentiates and interpolates a 
  *  set of chebyshev coefficients to give pos, vel, acc, and jerk 
@@ -472,11 +572,6 @@ int swi_pleph(double et, int ntarg, int ncent, double *rrd, char *serr)
 static int interp(double *buf, double t, double intv, int32 ncfin, 
 		  int32 ncmin, int32 nain, int32 ifl, double *pv)
 {
-  /* Initialized data */
-  static TLS int np, nv;
-  static TLS int nac;
-  static TLS int njk;
-  static TLS double twot = 0.;
   double *pc = js->pc;
   double *vc = js->vc;
   double *ac = js->ac;
@@ -488,7 +583,7 @@ static int interp(double *buf, double t, double intv, int32 ncfin,
   double temp;
   int i, j, ni;
   double tc;
-  double dt1, bma;
+  double dt1, bma, twot;
   double bma2, bma3;
   /*
    | get correct sub-interval number for this set of coefficients and then
@@ -509,21 +604,38 @@ static int interp(double *buf, double t, double intv, int32 ncfin,
    *  contains the value of tc on the previous call.) 
    */
   if (tc != pc[1]) {
-    np = 2;
-    nv = 3;
-    nac = 4;
-    njk = 5;
+    js->np = 2;
+    js->nv = 3;
+    js->nac = 4;
+    js->njk = 5;
     pc[1] = tc;
-    twot = tc + tc;
+    js->twot = tc + tc;
   }
+  twot = js->twot;
   /*
    *  be sure that at least 'ncf' polynomials have been evaluated 
    *  and are stored in the array 'pc'. 
    */
-  if (np < ncf) {
-    for (i = np; i < ncf; ++i) 
+  if (js->np < ncf) {
+    for (i = js->np; i < ncf; ++i) 
       pc[i] = twot * pc[i - 1] - pc[i - 2];
-    np = ncf;
+    js->np = ncf;
+  }
+  /*  position and velocity of all three components at once, 
+   *  with SIMD instructions */
+  if (ncm == 3 && ifl <= 2 && swi_simd_level() != SWI_SIMD_SCALAR) {
+    bma = 0;
+    if (ifl == 2) {
+      bma = (na + na) / intv;
+      vc[2] = twot + twot;
+      if (js->nv < ncf) {
+	for (i = js->nv; i < ncf; ++i) 
+	  vc[i] = twot * vc[i - 1] + pc[i - 1] + pc[i - 1] - vc[i - 2];
+	js->nv = ncf;
+      }
+    }
+    interp_pv3(&buf[ni * ncm * ncf], ncf, ifl, bma, pv);
+    return 0;
   }
   /*  interpolate to get position for each component */
   for (i = 0; i < ncm; ++i) {
@@ -539,10 +651,10 @@ static int interp(double *buf, double t, double intv, int32 ncfin,
    */
   bma = (na + na) / intv;
   vc[2] = twot + twot;
-  if (nv < ncf) {
-    for (i = nv; i < ncf; ++i) 
+  if (js->nv < ncf) {
+    for (i = js->nv; i < ncf; ++i) 
       vc[i] = twot * vc[i - 1] + pc[i - 1] + pc[i - 1] - vc[i - 2];
-    nv = ncf;
+    js->nv = ncf;
   }
   /*       interpolate to get velocity for each component */
   for (i = 0; i < ncm; ++i) {
@@ -557,9 +669,9 @@ static int interp(double *buf, double t, double intv, int32 ncfin,
   /*       re-do if necessary */
   bma2 = bma * bma;
   ac[3] = pc[1] * 24.;
-  if (nac < ncf) {
-    nac = ncf;
-    for (i = nac; i < ncf; ++i) 
+  if (js->nac < ncf) {
+    js->nac = ncf;
+    for (i = js->nac; i < ncf; ++i) 
       ac[i] = twot * ac[i - 1] + vc[i - 1] * 4. - ac[i - 2];
   }
   /*       get acceleration for each component */
@@ -575,9 +687,9 @@ static int interp(double *buf, double t, double intv, int32 ncfin,
   /*       re-do if necessary */
   bma3 = bma * bma2;
   jc[4] = pc[1] * 192.;
-  if (njk < ncf) {
-    njk = ncf;
-    for (i = njk; i < ncf; ++i) 
+  if (js->njk < ncf) {
+    js->njk = ncf;
+    for (i = js->njk; i < ncf; ++i) 
       jc[i] = twot * jc[i - 1] + ac[i - 1] * 6. - jc[i - 2];
   }
   /*       get jerk for each component */
@@ -777,6 +889,10 @@ static int state(double et, int32 *list, int do_bary,
 	sprintf(serr, "JPL ephemeris file is corrupt; start/end date check failed. %.1f != %.1f || %.1f != %.1f", ts[0],js->eh_ss[0],ts[3],js->eh_ss[1]);
       return NOT_AVAILABLE;
     }
+#if SWI_USE_MMAP
+    /* records are then taken directly from the mapping */
+    js->mptr = swi_map_file(js->jplfptr, &js->mlen);
+#endif
   }
   if (list == NULL) 
     return 0;
@@ -798,21 +914,41 @@ static int state(double et, int32 *list, int do_bary,
   /* read correct record if not in core */
   if (nr != nrl) {
     nrl = nr;
-    if (FSEEK(js->jplfptr, (off_t64) (nr * ((off_t64) irecsz)), 0) != 0) {
-      if (serr != NULL) 
-	sprintf(serr, "Read error in JPL eph. at %f\n", et);
-      return NOT_AVAILABLE;
-    }
-    for (k = 1; k <= ncoeffs; ++k) {
-      if ( fread((void *) &buf[k - 1], sizeof(double), 1, js->jplfptr) != 1) {
+    if (js->mptr != NULL) {
+      /* record from the mapping; it is used in place, if its byte 
+       * order is native */
+      if ((off_t64) (nr + 1) * irecsz > (off_t64) js->mlen) {
+	nrl = 0;
+	if (serr != NULL) 
+	  sprintf(serr, "Read error in JPL eph. at %f\n", et);
+	return NOT_AVAILABLE;
+      }
+      if (js->do_reorder) {
+	memcpy((void *) buf, (void *) (js->mptr + (size_t) nr * irecsz), (size_t) ncoeffs * sizeof(double));
+	reorder((char *) buf, sizeof(double), ncoeffs);
+	js->bufp = buf;
+      } else {
+	js->bufp = (double *) (js->mptr + (size_t) nr * irecsz);
+      }
+    } else {
+      if (FSEEK(js->jplfptr, (off_t64) (nr * ((off_t64) irecsz)), 0) != 0) {
 	if (serr != NULL) 
 	  sprintf(serr, "Read error in JPL eph. at %f\n", et);
 	return NOT_AVAILABLE;
       }
-      if (js->do_reorder)
-	reorder((char *) &buf[k-1], sizeof(double), 1);
+      for (k = 1; k <= ncoeffs; ++k) {
+	if ( fread((void *) &buf[k - 1], sizeof(double), 1, js->jplfptr) != 1) {
+	  if (serr != NULL) 
+	    sprintf(serr, "Read error in JPL eph. at %f\n", et);
+	  return NOT_AVAILABLE;
+	}
+	if (js->do_reorder)
+	  reorder((char *) &buf[k-1], sizeof(double), 1);
+      }
+      js->bufp = buf;
     }
   }
+  buf = js->bufp;
   if (js->do_km) {
     intv = js->eh_ss[2] * 86400.;
     aufac = 1.;
@@ -910,6 +1046,10 @@ static void reorder(char *x, int size, int number)
 void swi_close_jpl_file(void)
 {
   if (js != NULL) {
+#if SWI_USE_MMAP
+    if (js->mptr != NULL)
+      swi_unmap_file(js->mptr, js->mlen);
+#endif
     if (js->jplfptr != NULL)
       fclose(js->jplfptr);
     if (js->jplfname != NULL) 
@@ -947,6 +1087,7 @@ int swi_open_jpl_file(double *ss, char *fname, char *fpath, char *serr)
     js->vc[1] = 1;
     js->ac[2] = 4;
     js->jc[3] = 24;
+    js->bufp = js->buf;
   }
   return retc;
 }
@@ -70,6 +70,9 @@
 #include "swephexp.h"
 #include "sweph.h"
 #include "swephlib.h"
+#if SWI_USE_AVX2
+# include <immintrin.h>
+#endif
 
 #ifdef _MSC_VER
 #define CMP_CALL_CONV __cdecl
@@ -123,6 +126,15 @@ TLS struct swe_data swed = {FALSE,	/* ephe_path_is_set = FALSE */
 			    {0,0,0,0,0,0,0,0,}, /* astro_models */
 			    };
 
+#if SWI_USE_SHARED_SEGS
+/* shared segment store, s. swe_set_shared_segments(); not thread local */
+static struct seg_store *segstore_global = NULL;
+static char segstore_lock = 0;
+/* star index shared by all threads, s. open_star_index(); not thread local */
+static struct star_index *starindex_global = NULL;
+static char starindex_lock = 0;
+#endif
+
 /*************
  * constants *
  *************/
@@ -223,6 +235,19 @@ static int app_pos_rest(struct plan_data *pdp, int32 iflag,
     double *xx, double *x2000, struct epsilon *oe, char *serr);
 static int open_jpl_file(double *ss, char *fname, char *fpath, char *serr);
 static void free_planets(void);
+static void close_ephe_file(struct file_data *fdp);
+static AS_BOOL segcache_fetch(struct plan_data *pdp, double tjd);
+static void segcache_store(struct plan_data *pdp, double tjd);
+static void segcache_free(struct plan_data *pdp);
+static AS_BOOL segcache_alloc(struct plan_data *pdp, int n);
+static void free_fits(void);
+static AS_BOOL segstore_fetch(struct plan_data *pdp, struct file_data *fdp, double tjd);
+static void segstore_publish(struct plan_data *pdp, struct file_data *fdp, double tjd);
+static void open_unpacked_file(int ifno);
+static AS_BOOL ufile_fetch(struct plan_data *pdp, struct file_data *fdp, double tjd);
+static void free_fixed_stars(void);
+static void free_fixstar_cat(void);
+static int32 load_fixed_stars_text(char *serr);
 
 #ifdef TRACE
 static void trace_swe_calc(int param, double tjd, int ipl, int32 iflag, double *xx, char *serr);
@@ -293,6 +318,169 @@ char *CALL_CONV swe_get_library_path(char *s)
 }
 #endif	// NO_SWE_GLP
 
+/* Maps the body number ipl and the flags given to swe_calc() to the 
+ * body that is actually computed: Pluto as asteroid 134340 becomes
+ * SE_PLUTO, and planetary centers of body and planetary moons are
+ * split into planet number ipl and moon number iplmoon (0 if none). */
+static void calc_resolve_body(int *ipl, int32 *iplmoon, int32 *iflag)
+{
+  /* function calls for Pluto with asteroid number 134340
+   * are treated as calls for Pluto as main body SE_PLUTO.
+   * Reason: Our numerical integrator takes into account Pluto
+   * perturbation and therefore crashes with body 134340 Pluto. */
+  if (*ipl == SE_AST_OFFSET + 134340)
+    *ipl = SE_PLUTO;
+  /* planetary center of body or planetary moon: either planet is called
+   * with SEFLG_CENTER_BODY or center of body with ipl = 9n99 is called.
+   * we want to handle both cases the same way. */
+  // planet is called with SE_PLUTO etc. and SEFLG_CENTER_BODY:
+  // get number of center of body 
+  if ((*iflag & SEFLG_CENTER_BODY) && *ipl <= SE_PLUTO && (*iflag & SEFLG_TEST_PLMOON) != SEFLG_TEST_PLMOON) {
+    *iplmoon = *ipl * 100 + 9099; // planetary center of body
+  }
+  // planet center of body or planetary moon is called using 9... number:
+  // moon number and planet number
+  if (*ipl >= SE_PLMOON_OFFSET && *ipl < SE_AST_OFFSET && (*iflag & SEFLG_TEST_PLMOON) != SEFLG_TEST_PLMOON) {
+    *iplmoon = *ipl; // planetary center of body or planetary moon
+    *ipl = (int) ((*ipl - 9000) / 100);
+    *iflag |= SEFLG_CENTER_BODY;
+  }
+  // with Mercury to Mars, we do not have center of body different from barycenter
+  if ((*iflag & SEFLG_CENTER_BODY) && *ipl <= SE_MARS && (*iplmoon % 100) == 99) {
+    *iplmoon = 0;
+    *iflag &= ~SEFLG_CENTER_BODY;
+  }
+}
+
+/* Preparations of swe_calc() that depend on the body and the flags 
+ * but not on the epoch: change of ephemeris, speed and coordinate flags,
+ * body mapping. Returns the save area of the body. */
+static struct save_positions *calc_prepare(int *ipl, int32 *iplmoon, 
+	int32 *iflag, AS_BOOL *use_speed3, char *serr)
+{
+  int i;
+  int32 epheflag;
+  struct save_positions *sd;
+  *use_speed3 = FALSE;
+  /* if ephemeris flag != ephemeris flag of last call,
+   * we clear the save area, to prevent swecalc() using
+   * previously computed data for current calculation.
+   * except with ipl = SE_ECL_NUT which is not dependent 
+   * on ephemeris, and except if change is from 
+   * ephemeris = 0 to ephemeris = SEFLG_DEFAULTEPH
+   * or vice-versa.
+   */
+  epheflag = *iflag & SEFLG_EPHMASK;
+  if (epheflag & SEFLG_MOSEPH) {
+    epheflag = SEFLG_MOSEPH;
+  } else if (epheflag & SEFLG_JPLEPH) {
+    epheflag = SEFLG_JPLEPH;
+  } else  {
+    epheflag = SEFLG_SWIEPH;
+  }
+  if (swi_init_swed_if_start() == 1 && !(epheflag & SEFLG_MOSEPH) && serr != NULL) {
+    strcpy(serr, "Please call swe_set_ephe_path() or swe_set_jplfile() before calling swe_calc() or swe_calc_ut()");
+  }
+  if (swed.last_epheflag != epheflag) {
+    free_planets();
+    /* close and free ephemeris files */
+    if (*ipl != SE_ECL_NUT) {  /* because file will not be reopened with this ipl */
+      if (swed.jpl_file_is_open) {
+	swi_close_jpl_file();
+	swed.jpl_file_is_open = FALSE;
+      }
+      for (i = 0; i < SEI_NEPHFILES; i ++) {
+	close_ephe_file(&swed.fidat[i]);
+	memset((void *) &swed.fidat[i], 0, sizeof(struct file_data));
+      }
+      swed.last_epheflag = epheflag;
+    }
+  }
+  /* high precision speed prevails fast speed */
+  if ((*iflag & SEFLG_SPEED3) && (*iflag & SEFLG_SPEED))
+    *iflag = *iflag & ~SEFLG_SPEED3;
+  if (*iflag & SEFLG_SPEED3) 
+    *use_speed3 = TRUE;
+  /* topocentric with SEFLG_SPEED is not good if aberration is included. 
+   * in such cases we calculate speed from three positions */
+  if ((*iflag & SEFLG_SPEED) && (*iflag & SEFLG_TOPOCTR) && !(*iflag & SEFLG_NOABERR)) 
+    *use_speed3 = TRUE;
+  /* cartesian flag excludes radians flag */
+  if ((*iflag & SEFLG_XYZ) && (*iflag & SEFLG_RADIANS))
+    *iflag = *iflag & ~SEFLG_RADIANS;
+/*  if (*iflag & SEFLG_ICRS)
+    *iflag |= SEFLG_J2000;*/
+  calc_resolve_body(ipl, iplmoon, iflag);
+  if ((*iflag & SEFLG_CENTER_BODY) || *iplmoon > 0)
+    swi_force_app_pos_etc();
+  /* pointer to save area */
+  if (*ipl < SE_NPLANETS && *ipl >= SE_SUN) {
+    sd = &swed.savedat[*ipl];
+//    if (*iflag & SEFLG_CENTER_BODY)
+//      sd = &swed.savedat[SE_NPLANETS];
+  } else {
+    /* other bodies, e.g. asteroids called with ipl = SE_AST_OFFSET + MPC# */
+    sd = &swed.savedat[SE_NPLANETS];
+  }
+  return sd;
+}
+
+/* Copies the position saved in sd to xx[0..5] in the coordinates
+ * requested by iflag; iflgsave are the flags given by the caller.
+ * Returns the flags of the position. */
+static int32 calc_output(struct save_positions *sd, int ipl, int32 iflag, 
+	int32 iflgsave, double *xx)
+{
+  int i, j;
+  double x[6], *xs;
+  if (iflag & SEFLG_EQUATORIAL) {
+    xs = sd->xsaves+12;	/* equatorial coordinates */
+  } else {
+    xs = sd->xsaves;	/* ecliptic coordinates */
+  }
+  if (iflag & SEFLG_XYZ)
+    xs = xs+6;		/* cartesian coordinates */
+  if (ipl == SE_ECL_NUT) {
+    i = 4;
+  } else {
+    i = 3;
+  }
+  for (j = 0; j < i; j++)
+    x[j] = *(xs + j);
+  for (j = i; j < 6; j++)
+    x[j] = 0;
+  if (iflag & (SEFLG_SPEED3 | SEFLG_SPEED)) {
+    for (j = 3; j < 6; j++)
+      x[j] = *(xs + j);
+  }
+#if 1
+  if (iflag & SEFLG_RADIANS) {
+    if (ipl == SE_ECL_NUT) {
+      for (j = 0; j < 4; j++)
+        x[j] *= DEGTORAD;
+    } else {
+      for (j = 0; j < 2; j++)
+        x[j] *= DEGTORAD;
+      if (iflag & (SEFLG_SPEED3 | SEFLG_SPEED)) {
+        for (j = 3; j < 5; j++) 
+	  x[j] *= DEGTORAD;
+      }
+    }
+  }
+#endif
+  for (i = 0; i <= 5; i++)
+    xx[i] = x[i];
+  //iflag = sd->iflgsave | (iflag & SEFLG_COORDSYS);
+  // iflag from previous call of swe_calc(), without coordinate system flags
+  iflag = sd->iflgsave & ~SEFLG_COORDSYS; 
+  // add correct coordinate system flags
+  iflag |= (iflgsave & SEFLG_COORDSYS); 
+  /* if no ephemeris has been specified, do not return chosen ephemeris */
+  if ((iflgsave & SEFLG_EPHMASK) == 0)
+    iflag = iflag & ~SEFLG_DEFAULTEPH;
+  return iflag;
+}
+
 /* The routine called by the user.
  * It checks whether a position for the same planet, the same t, and the
  * same flag bits has already been computed. 
@@ -309,12 +497,11 @@ char *CALL_CONV swe_get_library_path(char *s)
 int32 CALL_CONV swe_calc(double tjd, int ipl, int32 iflag, 
 	double *xx, char *serr) 
 {
-  int i, j;
+  int i;
   int32 iplmoon = 0, iflgsave = iflag;
-  int32 epheflag;
-  AS_BOOL use_speed3 = FALSE;
+  AS_BOOL use_speed3;
   struct save_positions *sd;
-  double x[6], *xs, x0[24], x2[24];
+  double x0[24], x2[24];
   double dt;
   if (serr != NULL) 
     *serr = '\0';
@@ -339,7 +526,6 @@ int32 CALL_CONV swe_calc(double tjd, int ipl, int32 iflag,
   static TLS int force_flag_checked = 0;
   FILE *fp;
   char s[AS_MAXCH], *sp;
-  memset(x, 0, sizeof(double) * 6);
   /* if the following file exists, flag is read from it and or'ed into iflag */
   if (!force_flag_checked) {
     if ((fp = fopen(fname_force_flg, BFILE_R_ACCESS)) != NULL) {
@@ -358,92 +544,7 @@ int32 CALL_CONV swe_calc(double tjd, int ipl, int32 iflag,
   swi_open_trace(serr);
   trace_swe_calc(1, tjd, ipl, iflag, xx, NULL);
 #endif /* TRACE */
-  /* function calls for Pluto with asteroid number 134340
-   * are treated as calls for Pluto as main body SE_PLUTO.
-   * Reason: Our numerical integrator takes into account Pluto
-   * perturbation and therefore crashes with body 134340 Pluto. */
-  if (ipl == SE_AST_OFFSET + 134340)
-    ipl = SE_PLUTO;
-  /* if ephemeris flag != ephemeris flag of last call,
-   * we clear the save area, to prevent swecalc() using
-   * previously computed data for current calculation.
-   * except with ipl = SE_ECL_NUT which is not dependent 
-   * on ephemeris, and except if change is from 
-   * ephemeris = 0 to ephemeris = SEFLG_DEFAULTEPH
-   * or vice-versa.
-   */
-  epheflag = iflag & SEFLG_EPHMASK;
-  if (epheflag & SEFLG_MOSEPH) {
-    epheflag = SEFLG_MOSEPH;
-  } else if (epheflag & SEFLG_JPLEPH) {
-    epheflag = SEFLG_JPLEPH;
-  } else  {
-    epheflag = SEFLG_SWIEPH;
-  }
-  if (swi_init_swed_if_start() == 1 && !(epheflag & SEFLG_MOSEPH) && serr != NULL) {
-    strcpy(serr, "Please call swe_set_ephe_path() or swe_set_jplfile() before calling swe_calc() or swe_calc_ut()");
-  }
-  if (swed.last_epheflag != epheflag) {
-    free_planets();
-    /* close and free ephemeris files */
-    if (ipl != SE_ECL_NUT) {  /* because file will not be reopened with this ipl */
-      if (swed.jpl_file_is_open) {
-	swi_close_jpl_file();
-	swed.jpl_file_is_open = FALSE;
-      }
-      for (i = 0; i < SEI_NEPHFILES; i ++) {
-	if (swed.fidat[i].fptr != NULL) 
-	  fclose(swed.fidat[i].fptr);
-	memset((void *) &swed.fidat[i], 0, sizeof(struct file_data));
-      }
-      swed.last_epheflag = epheflag;
-    }
-  }
-  /* high precision speed prevails fast speed */
-  if ((iflag & SEFLG_SPEED3) && (iflag & SEFLG_SPEED))
-    iflag = iflag & ~SEFLG_SPEED3;
-  if (iflag & SEFLG_SPEED3) 
-    use_speed3 = TRUE;
-  /* topocentric with SEFLG_SPEED is not good if aberration is included. 
-   * in such cases we calculate speed from three positions */
-  if ((iflag & SEFLG_SPEED) && (iflag & SEFLG_TOPOCTR) && !(iflag & SEFLG_NOABERR)) 
-    use_speed3 = TRUE;
-  /* cartesian flag excludes radians flag */
-  if ((iflag & SEFLG_XYZ) && (iflag & SEFLG_RADIANS))
-    iflag = iflag & ~SEFLG_RADIANS;
-/*  if (iflag & SEFLG_ICRS)
-    iflag |= SEFLG_J2000;*/
-  /* planetary center of body or planetary moon: either planet is called
-   * with SEFLG_CENTER_BODY or center of body with ipl = 9n99 is called.
-   * we want to handle both cases the same way. */
-  // planet is called with SE_PLUTO etc. and SEFLG_CENTER_BODY:
-  // get number of center of body 
-  if ((iflag & SEFLG_CENTER_BODY) && ipl <= SE_PLUTO && (iflag & SEFLG_TEST_PLMOON) != SEFLG_TEST_PLMOON) {
-    iplmoon = ipl * 100 + 9099; // planetary center of body
-  }
-  // planet center of body or planetary moon is called using 9... number:
-  // moon number and planet number
-  if (ipl >= SE_PLMOON_OFFSET && ipl < SE_AST_OFFSET && (iflag & SEFLG_TEST_PLMOON) != SEFLG_TEST_PLMOON) {
-    iplmoon = ipl; // planetary center of body or planetary moon
-    ipl = (int) ((ipl - 9000) / 100);
-    iflag |= SEFLG_CENTER_BODY;
-  }
-  // with Mercury to Mars, we do not have center of body different from barycenter
-  if ((iflag & SEFLG_CENTER_BODY) && ipl <= SE_MARS && (iplmoon % 100) == 99) {
-    iplmoon = 0;
-    iflag &= ~SEFLG_CENTER_BODY;
-  }
-  if ((iflag & SEFLG_CENTER_BODY) || iplmoon > 0)
-    swi_force_app_pos_etc();
-  /* pointer to save area */
-  if (ipl < SE_NPLANETS && ipl >= SE_SUN) {
-    sd = &swed.savedat[ipl];
-//    if (iflag & SEFLG_CENTER_BODY)
-//      sd = &swed.savedat[SE_NPLANETS];
-  } else {
-    /* other bodies, e.g. asteroids called with ipl = SE_AST_OFFSET + MPC# */
-    sd = &swed.savedat[SE_NPLANETS];
-  }
+  sd = calc_prepare(&ipl, &iplmoon, &iflag, &use_speed3, serr);
   /* 
    * if position is available in save area, it is returned.
    * this is the case, if tjd = tsave and iflag = iflgsave.
@@ -504,51 +605,7 @@ int32 CALL_CONV swe_calc(double tjd, int ipl, int32 iflag,
     calc_speed(x0, sd->xsaves, x2, dt);
   }
   end_swe_calc:
-  if (iflag & SEFLG_EQUATORIAL) {
-    xs = sd->xsaves+12;	/* equatorial coordinates */
-  } else {
-    xs = sd->xsaves;	/* ecliptic coordinates */
-  }
-  if (iflag & SEFLG_XYZ)
-    xs = xs+6;		/* cartesian coordinates */
-  if (ipl == SE_ECL_NUT) {
-    i = 4;
-  } else {
-    i = 3;
-  }
-  for (j = 0; j < i; j++)
-    x[j] = *(xs + j);
-  for (j = i; j < 6; j++)
-    x[j] = 0;
-  if (iflag & (SEFLG_SPEED3 | SEFLG_SPEED)) {
-    for (j = 3; j < 6; j++)
-      x[j] = *(xs + j);
-  }
-#if 1
-  if (iflag & SEFLG_RADIANS) {
-    if (ipl == SE_ECL_NUT) {
-      for (j = 0; j < 4; j++)
-        x[j] *= DEGTORAD;
-    } else {
-      for (j = 0; j < 2; j++)
-        x[j] *= DEGTORAD;
-      if (iflag & (SEFLG_SPEED3 | SEFLG_SPEED)) {
-        for (j = 3; j < 5; j++) 
-	  x[j] *= DEGTORAD;
-      }
-    }
-  }
-#endif
-  for (i = 0; i <= 5; i++)
-    xx[i] = x[i];
-  //iflag = sd->iflgsave | (iflag & SEFLG_COORDSYS);
-  // iflag from previous call of swe_calc(), without coordinate system flags
-  iflag = sd->iflgsave & ~SEFLG_COORDSYS; 
-  // add correct coordinate system flags
-  iflag |= (iflgsave & SEFLG_COORDSYS); 
-  /* if no ephemeris has been specified, do not return chosen ephemeris */
-  if ((iflgsave & SEFLG_EPHMASK) == 0)
-    iflag = iflag & ~SEFLG_DEFAULTEPH;
+  iflag = calc_output(sd, ipl, iflag, iflgsave, xx);
 #ifdef TRACE
   trace_swe_calc(2, tjd, ipl, iflag, xx, serr);
 #endif
@@ -584,6 +641,247 @@ int32 CALL_CONV swe_calc_ut(double tjd_ut, int32 ipl, int32 iflag,
   return retval;
 }
 
+/* epoch with its position in the caller's array, s. calc_batch() */
+struct batch_epoch {
+  double tjd;
+  int32 i;
+};
+
+static int CMP_CALL_CONV batch_epoch_compare(const void *e1, const void *e2)
+{
+  const struct batch_epoch *b1 = (const struct batch_epoch *) e1;
+  const struct batch_epoch *b2 = (const struct batch_epoch *) e2;
+  if (b1->tjd < b2->tjd) return -1;
+  if (b1->tjd > b2->tjd) return 1;
+  return (b1->i < b2->i) ? -1 : (b1->i > b2->i);
+}
+
+/* Computes body ipl for n epochs tjd[0..n-1] (ET, or UT if is_ut).
+ * The preparations of swe_calc() that depend only on the body and the 
+ * flags (plausibility of flags, change of ephemeris, body mapping, save
+ * area) are done once for the whole batch; then swecalc() is called 
+ * directly for each epoch. The epochs are computed in chronological 
+ * order, so that all epochs that fall into the same ephemeris segment
+ * are computed one after the other and the segment is read and unpacked
+ * only once; obliquity and nutation are computed once for each epoch,
+ * and equal epochs are computed only once. 
+ * Bodies that need three positions for the speed (SEFLG_SPEED3, 
+ * topocentric speed with aberration) and centers of body or planetary
+ * moons, which force a recomputation of all positions, are computed by
+ * swe_calc() for each epoch, in the same order.
+ * Results are the same as with swe_calc() or swe_calc_ut().
+ * xx		returns 6 x n doubles, in the order of tjd[]
+ * iflgret	NULL or array of n flags returned for each epoch
+ * Return value is ERR, if the computation failed for any epoch (its 
+ * position is set to 0), otherwise the flags returned for the last 
+ * epoch. serr contains the first error or warning message.
+ */
+static int32 calc_batch(int32 ipl, double *tjd, int32 n, int32 iflag, 
+	double *xx, int32 *iflgret, AS_BOOL is_ut, char *serr)
+{
+  int i, j, k, iplc = (int) ipl;
+  int32 retflag, retval = 0, iplmoon = 0, iflgc, iflgsave, epheflag = 0;
+  AS_BOOL use_speed3, per_epoch;
+  struct save_positions *sd;
+  struct batch_epoch *bep;
+  double t, deltat;
+  char serr1[AS_MAXCH];
+  if (serr != NULL)
+    *serr = '\0';
+  if (n <= 0)
+    return 0;
+  bep = (struct batch_epoch *) malloc((size_t) n * sizeof(struct batch_epoch));
+  if (bep == NULL) {
+    if (serr != NULL)
+      strcpy(serr, "error in malloc() in swe_calc_batch()");
+    return ERR;
+  }
+  for (i = 0; i < n; i++) {
+    bep[i].tjd = tjd[i];
+    bep[i].i = i;
+  }
+  qsort((void *) bep, (size_t) n, sizeof(struct batch_epoch), 
+                    (int (CMP_CALL_CONV *)(const void *,const void *))(batch_epoch_compare));
+  if (is_ut) {
+    /* as swe_calc_ut() */
+    iflag = plaus_iflag(iflag, ipl, bep[0].tjd, serr);
+    epheflag = iflag & SEFLG_EPHMASK;
+    if (epheflag == 0) {
+      epheflag = SEFLG_SWIEPH;
+      iflag |= SEFLG_SWIEPH;
+    }
+  }
+  iflgsave = iflgc = iflag;
+  *serr1 = '\0';
+  sd = calc_prepare(&iplc, &iplmoon, &iflgc, &use_speed3, serr1);
+  if (*serr1 != '\0' && serr != NULL && *serr == '\0')
+    strcpy(serr, serr1);
+  per_epoch = (use_speed3 || iplmoon > 0 || (iflgc & SEFLG_CENTER_BODY));
+  for (k = 0; k < n; k++) {
+    i = bep[k].i;
+    *serr1 = '\0';
+    if (k > 0 && bep[k].tjd == bep[k-1].tjd) {
+      /* same epoch as before */
+      memcpy((void *) (xx + 6 * i), (void *) (xx + 6 * bep[k-1].i), 6 * sizeof(double));
+      if (iflgret != NULL) 
+	iflgret[i] = iflgret[bep[k-1].i];
+      continue;
+    }
+    if (per_epoch) {
+      if (is_ut)
+	retflag = swe_calc_ut(bep[k].tjd, ipl, iflag, xx + 6 * i, serr1);
+      else
+	retflag = swe_calc(bep[k].tjd, ipl, iflag, xx + 6 * i, serr1);
+    } else {
+      t = bep[k].tjd;
+      deltat = 0;
+      if (is_ut) {
+	deltat = swe_deltat_ex(t, iflag, serr1);
+	t += deltat;
+      }
+      sd->tsave = t;
+      sd->ipl = iplc;
+      retflag = sd->iflgsave = swecalc(t, iplc, iplmoon, iflgc, sd->xsaves, serr1);
+      /* if ephe required is not ephe returned, adjust delta t,
+       * as swe_calc_ut() does */
+      if (is_ut && retflag != ERR && (retflag & SEFLG_EPHMASK) != epheflag) {
+	t = bep[k].tjd + swe_deltat_ex(bep[k].tjd, retflag, NULL);
+	sd->tsave = t;
+	retflag = sd->iflgsave = swecalc(t, iplc, iplmoon, iflgc, sd->xsaves, NULL);
+      }
+      if (retflag == ERR) {
+	sd->tsave = 0;
+	for (j = 0; j <= 5; j++)
+	  xx[6 * i + j] = 0;
+      } else {
+	retflag = calc_output(sd, iplc, iflgc, iflgsave, xx + 6 * i);
+      }
+    }
+    if (iflgret != NULL) 
+      iflgret[i] = retflag;
+    if (*serr1 != '\0' && serr != NULL && *serr == '\0')
+      strcpy(serr, serr1);
+    if (retflag == ERR)
+      retval = ERR;
+    else if (retval != ERR)
+      retval = retflag;
+  }
+  free((void *) bep);
+  return retval;
+}
+
+int32 CALL_CONV swe_calc_batch(int32 ipl, double *tjd, int32 n, int32 iflag, 
+	double *xx, int32 *iflgret, char *serr)
+{
+  return calc_batch(ipl, tjd, n, iflag, xx, iflgret, FALSE, serr);
+}
+
+int32 CALL_CONV swe_calc_batch_ut(int32 ipl, double *tjd_ut, int32 n, int32 iflag, 
+	double *xx, int32 *iflgret, char *serr)
+{
+  return calc_batch(ipl, tjd_ut, n, iflag, xx, iflgret, TRUE, serr);
+}
+
+/* TRUE, if swe_calc() calls swi_force_app_pos_etc() for this body,
+ * which invalidates all positions saved for the current date. */
+static AS_BOOL calc_all_forces_recalc(int32 ipl, int32 iflag)
+{
+  int ipli = (int) ipl;
+  int32 iplmoon = 0;
+  calc_resolve_body(&ipli, &iplmoon, &iflag);
+  return ((iflag & SEFLG_CENTER_BODY) || iplmoon > 0);
+}
+
+/* Computes the bodies ipl[0..nbody-1] for one epoch tjd (ET, or UT if
+ * is_ut). The work that does not depend on the body is done only once
+ * for the epoch: delta t, obliquity and nutation, the barycentric earth,
+ * sun and moon and the topocentric observer. The bodies are computed
+ * in an order that keeps these data valid, i.e. bodies with
+ * SEFLG_CENTER_BODY and planetary moons (which force a recomputation
+ * of all apparent positions) come last. Results are the same as with
+ * swe_calc() or swe_calc_ut().
+ * xx		returns 6 x nbody doubles, in the order of ipl[]
+ * iflgret	NULL or array of nbody flags returned for each body
+ * Return value is ERR, if the computation failed for any body (its
+ * position is set to 0), otherwise the flags returned for the last
+ * body computed. serr contains the first error or warning message.
+ */
+static int32 calc_all(double tjd, int32 *ipl, int32 nbody, int32 iflag,
+	double *xx, int32 *iflgret, AS_BOOL is_ut, char *serr)
+{
+  int32 i, k, pass, retflag, retval = 0;
+  int32 iflgb, epheflag, epheret;
+  int32 dt_epheflag[2] = {0, 0};
+  double dt_val[2] = {0, 0};
+  double deltat;
+  char serr1[AS_MAXCH];
+  if (serr != NULL)
+    *serr = '\0';
+  if (nbody <= 0)
+    return 0;
+  for (pass = 0; pass <= 1; pass++) {
+    for (k = 0; k < nbody; k++) {
+      if (calc_all_forces_recalc(ipl[k], iflag) != (pass == 1))
+	continue;
+      *serr1 = '\0';
+      if (!is_ut) {
+	retflag = swe_calc(tjd, ipl[k], iflag, xx + 6 * k, serr1);
+      } else {
+	/* as swe_calc_ut(), but delta t is computed only once
+	 * for each ephemeris */
+	iflgb = plaus_iflag(iflag, ipl[k], tjd, serr1);
+	epheflag = iflgb & SEFLG_EPHMASK;
+	if (epheflag == 0) {
+	  epheflag = SEFLG_SWIEPH;
+	  iflgb |= SEFLG_SWIEPH;
+	}
+	for (i = 0; i < 2 && dt_epheflag[i] != epheflag; i++)
+	  ;
+	if (i == 2) {
+	  i = (dt_epheflag[0] == 0) ? 0 : 1;
+	  dt_val[i] = swe_deltat_ex(tjd, iflgb, serr1);
+	  dt_epheflag[i] = epheflag;
+	}
+	deltat = dt_val[i];
+	retflag = swe_calc(tjd + deltat, ipl[k], iflgb, xx + 6 * k, serr1);
+	/* if ephe required is not ephe returned, adjust delta t */
+	epheret = retflag & SEFLG_EPHMASK;
+	if (retflag != ERR && epheret != epheflag) {
+	  for (i = 0; i < 2 && dt_epheflag[i] != epheret; i++)
+	    ;
+	  if (i == 2) {
+	    i = 1;
+	    dt_val[i] = swe_deltat_ex(tjd, retflag, NULL);
+	    dt_epheflag[i] = epheret;
+	  }
+	  retflag = swe_calc(tjd + dt_val[i], ipl[k], iflgb, xx + 6 * k, NULL);
+	}
+      }
+      if (iflgret != NULL)
+	iflgret[k] = retflag;
+      if (*serr1 != '\0' && serr != NULL && *serr == '\0')
+	strcpy(serr, serr1);
+      if (retflag == ERR)
+	retval = ERR;
+      else if (retval != ERR)
+	retval = retflag;
+    }
+  }
+  return retval;
+}
+
+int32 CALL_CONV swe_calc_all(double tjd, int32 *ipl, int32 nbody, int32 iflag,
+	double *xx, int32 *iflgret, char *serr)
+{
+  return calc_all(tjd, ipl, nbody, iflag, xx, iflgret, FALSE, serr);
+}
+
+int32 CALL_CONV swe_calc_all_ut(double tjd_ut, int32 *ipl, int32 nbody, int32 iflag,
+	double *xx, int32 *iflgret, char *serr)
+{
+  return calc_all(tjd_ut, ipl, nbody, iflag, xx, iflgret, TRUE, serr);
+}
+
 static int32 swecalc(double tjd, int ipl, int32 iplmoon, int32 iflag, double *x, char *serr) 
 {
   int i;
@@ -1160,6 +1458,7 @@ static void free_planets(void)
   int i;
   /* free planets data space */
   for (i = 0; i < SEI_NPLANETS; i++) {
+    segcache_free(&swed.pldat[i]);
     if (swed.pldat[i].segp != NULL) {
       free((void *) swed.pldat[i].segp);
     }
@@ -1168,6 +1467,7 @@ static void free_planets(void)
     }
     memset((void *) &swed.pldat[i], 0, sizeof(struct plan_data));
   }
+  free_fits();
   for (i = 0; i <= SE_NPLANETS; i++) /* "<=" is correct! see decl. */
     memset((void *) &swed.savedat[i], 0, sizeof(struct save_positions));
   /* clear node data space */
@@ -1176,6 +1476,128 @@ static void free_planets(void)
   }
 }
 
+/* closes a SWISSEPH file and releases its memory mapping, if any */
+static void close_ephe_file(struct file_data *fdp)
+{
+  if (fdp->mptr != NULL)
+    swi_unmap_file(fdp->mptr, fdp->mlen);
+  fdp->mptr = NULL;
+  fdp->mlen = 0;
+  fdp->mpos = 0;
+  if (fdp->uptr != NULL)
+    swi_unmap_file(fdp->uptr, fdp->ulen);
+  fdp->uptr = NULL;
+  fdp->ulen = 0;
+  if (fdp->fptr != NULL) 
+    fclose(fdp->fptr);
+  // free(fdp->fptr);  is not from malloc(), must not be freed by us
+  fdp->fptr = NULL;
+}
+
+/* closes the file of a pool entry and frees the data of its body */
+static void astpool_close(struct ast_file *afp)
+{
+  close_ephe_file(&afp->fd);
+  segcache_free(&afp->pd);
+  if (afp->pd.refep != NULL)
+    free((void *) afp->pd.refep);
+  if (afp->pd.segp != NULL)
+    free((void *) afp->pd.segp);
+  afp->pd.refep = NULL;
+  afp->pd.segp = NULL;
+}
+
+/* moves the file in swed.fidat[SEI_FILE_ANY_AST], together with the 
+ * constants and segments of its body in swed.pldat[SEI_ANYBODY], into the 
+ * asteroid pool; if the pool is full, the least recently used file in it
+ * is closed. Returns FALSE, if the pool is off. */
+static AS_BOOL astpool_put(void)
+{
+  int i;
+  struct ast_file *afp;
+  struct file_data *fdp = &swed.fidat[SEI_FILE_ANY_AST];
+  struct plan_data *pdp = &swed.pldat[SEI_ANYBODY];
+  if (swed.astpool_size <= 0)
+    return FALSE;
+  if (swed.astpool == NULL) {
+    swed.astpool = (struct ast_file *) calloc((size_t) swed.astpool_size, sizeof(struct ast_file));
+    if (swed.astpool == NULL)
+      return FALSE;
+    swed.nastpool = 0;
+  }
+  if (swed.nastpool < swed.astpool_size) {
+    afp = &swed.astpool[swed.nastpool++];
+  } else {
+    afp = swed.astpool;
+    for (i = 1; i < swed.nastpool; i++) {
+      if (swed.astpool[i].tused < afp->tused)
+	afp = &swed.astpool[i];
+    }
+    astpool_close(afp);
+  }
+  afp->fd = *fdp;
+  afp->pd = *pdp;
+  afp->ast_G = swed.ast_G;
+  afp->ast_H = swed.ast_H;
+  afp->ast_diam = swed.ast_diam;
+  strcpy(afp->astelem, swed.astelem);
+  afp->tused = ++swed.astpool_clock;
+  /* the slot is now free, as if the file had been closed */
+  fdp->fptr = NULL;
+  fdp->mptr = NULL;
+  fdp->mlen = 0;
+  fdp->uptr = NULL;
+  fdp->ulen = 0;
+  pdp->refep = NULL;
+  pdp->segp = NULL;
+  pdp->ucoef = NULL;
+  pdp->uneval = NULL;
+  pdp->segcache = NULL;
+  pdp->nsegcache = 0;
+  return TRUE;
+}
+
+/* if the file of body ipli is in the asteroid pool and covers tjd, 
+ * moves it back into the free slot swed.fidat[SEI_FILE_ANY_AST] and 
+ * swed.pldat[SEI_ANYBODY], without reading its constants again. 
+ * Returns FALSE, if the file must be opened. */
+static AS_BOOL astpool_get(int ipli, double tjd)
+{
+  int i;
+  struct ast_file *afp;
+  for (i = 0, afp = swed.astpool; i < swed.nastpool; i++, afp++) {
+    if (afp->pd.ibdy == ipli)
+      break;
+  }
+  if (i == swed.nastpool)
+    return FALSE;
+  if (tjd < afp->fd.tfstart || tjd > afp->fd.tfend) {
+    astpool_close(afp);
+  } else {
+    swed.fidat[SEI_FILE_ANY_AST] = afp->fd;
+    swed.pldat[SEI_ANYBODY] = afp->pd;
+    swed.ast_G = afp->ast_G;
+    swed.ast_H = afp->ast_H;
+    swed.ast_diam = afp->ast_diam;
+    strcpy(swed.astelem, afp->astelem);
+  }
+  /* fill the gap with the last entry */
+  if (i < --swed.nastpool)
+    swed.astpool[i] = swed.astpool[swed.nastpool];
+  return swed.fidat[SEI_FILE_ANY_AST].fptr != NULL;
+}
+
+static void free_astpool(void)
+{
+  int i;
+  for (i = 0; i < swed.nastpool; i++)
+    astpool_close(&swed.astpool[i]);
+  if (swed.astpool != NULL)
+    free((void *) swed.astpool);
+  swed.astpool = NULL;
+  swed.nastpool = 0;
+}
+
 /* Function initialises swed structure. 
  * Returns 1 if initialisation is done, otherwise 0 */
 int32 swi_init_swed_if_start(void)
@@ -1200,10 +1622,10 @@ static void swi_close_keep_topo_etc(void)
   int i;
   /* close SWISSEPH files */
   for (i = 0; i < SEI_NEPHFILES; i ++) {
-    if (swed.fidat[i].fptr != NULL) 
-      fclose(swed.fidat[i].fptr);
+    close_ephe_file(&swed.fidat[i]);
     memset((void *) &swed.fidat[i], 0, sizeof(struct file_data));
   }
+  free_astpool();
   free_planets();
   memset((void *) &swed.oec, 0, sizeof(struct epsilon));
   memset((void *) &swed.oec2000, 0, sizeof(struct epsilon));
@@ -1220,6 +1642,7 @@ static void swi_close_keep_topo_etc(void)
     fclose(swed.fixfp);
     swed.fixfp = NULL;
   }
+  swi_close_eclipse_catalog();
   swe_set_tid_acc(SE_TIDAL_AUTOMATIC);
   swed.is_old_starfile = FALSE;
   swed.i_saved_planet_name = 0;
@@ -1235,10 +1658,10 @@ void CALL_CONV swe_close(void)
   int i;
   /* close SWISSEPH files */
   for (i = 0; i < SEI_NEPHFILES; i ++) {
-    if (swed.fidat[i].fptr != NULL) 
-      fclose(swed.fidat[i].fptr);
+    close_ephe_file(&swed.fidat[i]);
     memset((void *) &swed.fidat[i], 0, sizeof(struct file_data));
   }
+  free_astpool();
   free_planets();
   memset((void *) &swed.oec, 0, sizeof(struct epsilon));
   memset((void *) &swed.oec2000, 0, sizeof(struct epsilon));
@@ -1273,13 +1696,15 @@ void CALL_CONV swe_close(void)
     free(swed.deps);
     swed.deps = NULL;
   }
-  if (swed.n_fixstars_records > 0) {
-    free(swed.fixed_stars);
-    swed.fixed_stars = NULL;
-    swed.n_fixstars_real = 0;
-    swed.n_fixstars_named = 0;
-    swed.n_fixstars_records = 0;
+  if (swed.nuttab.tab != NULL) {
+    free(swed.nuttab.tab);
+    memset((void *) &swed.nuttab, 0, sizeof(struct nut_table));
   }
+  swi_free_deltat_tables();
+  free_fixed_stars();
+  swi_close_eclipse_catalog();
+  /* this thread's reference to the shared segment store */
+  swe_set_shared_segments(FALSE);
 /*  swed.ephe_path_is_set = FALSE;
   *swed.ephepath = '\0'; */
 #ifdef TRACE
@@ -2165,8 +2590,10 @@ static int sweph(double tjd, int ipli, int ifno, int32 iflag, double *xsunb, AS_
      * if new asteroid, close old file. */
     if (tjd < fdp->tfstart || tjd > fdp->tfend
       || (ipl == SEI_ANYBODY && ipli != pdp->ibdy)) { 	
-      fclose(fdp->fptr);
-      fdp->fptr = NULL;
+      /* another asteroid: keep the old file open in the pool, if any */
+      if (ipl == SEI_ANYBODY && ipli != pdp->ibdy && astpool_put())
+	goto file_closed;
+      close_ephe_file(fdp);
       if (pdp->refep != NULL) 
 	free((void *) pdp->refep);
       pdp->refep = NULL;
@@ -2175,6 +2602,10 @@ static int sweph(double tjd, int ipli, int ifno, int32 iflag, double *xsunb, AS_
       pdp->segp = NULL;
     }
   }
+file_closed:
+  /* asteroid file that is still open in the pool */
+  if (fdp->fptr == NULL && ipl == SEI_ANYBODY && swed.nastpool > 0)
+    astpool_get(ipli, tjd);
   /* if sweph file not open, find and open it */
   if (fdp->fptr == NULL) {
     swi_gen_filename(tjd, ipli, fname); 
@@ -2227,6 +2658,11 @@ again:
     retc = read_const(ifno, serr);
     if (retc != OK)
       return(retc);
+    /* from now on, segments are read from the mapped image, if possible */
+    fdp->mptr = swi_map_file(fdp->fptr, &fdp->mlen);
+    fdp->mpos = 0;
+    /* unpacked companion file, if present */
+    open_unpacked_file(ifno);
   }
   /* if first ephemeris file (J-3000), it might start a mars period
    * after -3000. if last ephemeris file (J3000), it might end a
@@ -2268,18 +2704,27 @@ again:
   /******************************
    * get planet's position      
    ******************************/
-  /* get new segment, if necessary */
-  if (pdp->segp == NULL || tjd < pdp->tseg0 || tjd > pdp->tseg1) {
-    retc = get_new_segment(tjd, ipl, ifno, serr);
-    if (retc != OK)
-      return(retc);
-    /* rotate cheby coeffs back to equatorial system.
-     * if necessary, add reference orbit. */
-    if (pdp->iflg & SEI_FLG_ROTATE) {
-      rot_back(ipl); /**/
-    } else {
-      pdp->neval = pdp->ncoe;
+  /* get new segment, if necessary; take it from the unpacked file 
+   * or from the segment cache, if possible */
+  if ((pdp->segp == NULL || tjd < pdp->tseg0 || tjd > pdp->tseg1)
+    && !ufile_fetch(pdp, fdp, tjd)
+    && !segcache_fetch(pdp, tjd)) {
+    /* then into the store shared with other threads */
+    if (!segstore_fetch(pdp, fdp, tjd)) {
+      retc = get_new_segment(tjd, ipl, ifno, serr);
+      if (retc != OK)
+	return(retc);
+      /* rotate cheby coeffs back to equatorial system.
+       * if necessary, add reference orbit. */
+      if (pdp->iflg & SEI_FLG_ROTATE) {
+	rot_back(ipl); /**/
+      } else {
+	pdp->neval = pdp->ncoe;
+      }
+      pdp->segmisses++;
+      segstore_publish(pdp, fdp, tjd);
     }
+    segcache_store(pdp, tjd);
   }
   /* evaluate chebyshew polynomial for tjd */
   t = (tjd - pdp->tseg0) / pdp->dseg;
@@ -2291,13 +2736,14 @@ again:
    * 2. the speed flag has been specified.
    */
   need_speed = (do_save || (iflag & SEFLG_SPEED));
-  for (i = 0; i <= 2; i++) {
-    xp[i]  = swi_echeb (t, pdp->segp+(i*pdp->ncoe), pdp->neval);
-    if (need_speed) {
-      xp[i+3] = swi_edcheb(t, pdp->segp+(i*pdp->ncoe), pdp->neval) / pdp->dseg * 2;
-    } else {
-      xp[i+3] = 0;	/* von Alois als billiger fix, evtl. illegal */
-    }
+  if (need_speed) {
+    swi_echeb_xyz(t, pdp->segp, pdp->neval, pdp->ncoe, xp, xp + 3);
+    for (i = 3; i <= 5; i++)
+      xp[i] = xp[i] / pdp->dseg * 2;
+  } else {
+    swi_echeb_xyz(t, pdp->segp, pdp->neval, pdp->ncoe, xp, NULL);
+    for (i = 3; i <= 5; i++)
+      xp[i] = 0;	/* von Alois als billiger fix, evtl. illegal */
   }
   /* if planet wanted is barycentric sun:
    * current sepl* files have do not have barycentric sun,
@@ -3572,9 +4018,13 @@ void swi_precess_speed(double *xx, double t, int32 iflag, int direction)
   swi_cartpol_sp(xx, xx);
 if (1) {
   if (prec_model == SEMOD_PREC_VONDRAK_2011) {
-    swi_ldp_peps(t, &dpre, NULL);
-    swi_ldp_peps(t + 1, &dpre2, NULL);
-    xx[3] += (dpre2 - dpre) * fac;
+    if (t != swed.prec.tspeed || t == 0) {
+      swi_ldp_peps(t, &dpre, NULL);
+      swi_ldp_peps(t + 1, &dpre2, NULL);
+      swed.prec.dpre_speed = dpre2 - dpre;
+      swed.prec.tspeed = t;
+    }
+    xx[3] += swed.prec.dpre_speed * fac;
   } else {
     xx[3] += (50.290966 + 0.0222226 * tprec) / 3600 / 365.25 * DEGTORAD * fac;
 			/* formula from Montenbruck, German 1994, p. 18 */
@@ -4291,70 +4741,633 @@ static int app_pos_etc_sbar(int32 iflag, char *serr)
   return app_pos_rest(psdp, iflag, xx, xxsv, oe, serr);
 }
 
-/* transforms position of mean lunar node or apogee:
- * input is polar coordinates in mean ecliptic of date.
- * output is, according to iflag:
- * position accounted for light-time
- * position referred to J2000 (i.e. precession subtracted)
- * position with nutation 
- * equatorial coordinates
- * cartesian coordinates
- * heliocentric position is not allowed ??????????????
- *         DAS WAERE ZIEMLICH AUFWENDIG. SONNE UND ERDE MUESSTEN
- *         SCHON VORHANDEN SEIN!
- * ipl		bodynumber (SE_MEAN_NODE or SE_MEAN_APOG)
- * iflag	flags
- * serr         error string
+/* transforms position of mean lunar node or apogee:
+ * input is polar coordinates in mean ecliptic of date.
+ * output is, according to iflag:
+ * position accounted for light-time
+ * position referred to J2000 (i.e. precession subtracted)
+ * position with nutation 
+ * equatorial coordinates
+ * cartesian coordinates
+ * heliocentric position is not allowed ??????????????
+ *         DAS WAERE ZIEMLICH AUFWENDIG. SONNE UND ERDE MUESSTEN
+ *         SCHON VORHANDEN SEIN!
+ * ipl		bodynumber (SE_MEAN_NODE or SE_MEAN_APOG)
+ * iflag	flags
+ * serr         error string
+ */
+static int app_pos_etc_mean(int ipl, int32 iflag, char *serr) 
+{
+  int i;
+  int32 flg1, flg2;
+  double xx[6], xxsv[6];
+  struct plan_data *pdp = &swed.nddat[ipl];
+  struct epsilon *oe;
+  /* if the same conversions have already been done for the same 
+   * date, then return */
+  flg1 = iflag & ~SEFLG_EQUATORIAL & ~SEFLG_XYZ;
+  flg2 = pdp->xflgs & ~SEFLG_EQUATORIAL & ~SEFLG_XYZ;
+  if (flg1 == flg2) {
+    pdp->xflgs = iflag;
+    pdp->iephe = iflag & SEFLG_EPHMASK;
+    return OK;
+  }
+  for (i = 0; i <= 5; i++)
+    xx[i] = pdp->x[i];
+  /* cartesian equatorial coordinates */
+  swi_polcart_sp(xx, xx);
+  swi_coortrf2(xx, xx, -swed.oec.seps, swed.oec.ceps);
+  swi_coortrf2(xx+3, xx+3, -swed.oec.seps, swed.oec.ceps);
+  if (!(iflag & SEFLG_SPEED))
+    for (i = 3; i <= 5; i++)
+      xx[i] = 0;
+  /* J2000 coordinates; required for sidereal positions */
+  if (((iflag & SEFLG_SIDEREAL) 
+    && (swed.sidd.sid_mode & SE_SIDBIT_ECL_T0))
+      || (swed.sidd.sid_mode & SE_SIDBIT_SSY_PLANE)) {
+    for (i = 0; i <= 5; i++)
+      xxsv[i] = xx[i];
+    /* xxsv is not J2000 yet! */
+    if (pdp->teval != J2000) {
+      swi_precess(xxsv, pdp->teval, iflag, J_TO_J2000);
+      if (iflag & SEFLG_SPEED)
+        swi_precess_speed(xxsv, pdp->teval, iflag, J_TO_J2000); 
+    }
+  }
+  /*****************************************************
+   * if no precession, equator of date -> equator 2000 *
+   *****************************************************/
+  if (iflag & SEFLG_J2000) {
+    swi_precess(xx, pdp->teval, iflag, J_TO_J2000); 
+    if (iflag & SEFLG_SPEED)
+      swi_precess_speed(xx, pdp->teval, iflag, J_TO_J2000); 
+    oe = &swed.oec2000;
+  } else
+    oe = &swed.oec;
+  return app_pos_rest(pdp, iflag, xx, xxsv, oe, serr);
+}
+
+
+/* SWISSEPH
+ * maps the unpacked companion file (*.su1) of the open ephemeris file,
+ * if it exists, s. swephunp.c. It is used only if it was created from
+ * this very file (same header CRC) on a machine with the same byte order;
+ * otherwise it is ignored and segments are unpacked from the .se1 file.
+ */
+static void open_unpacked_file(int ifno)
+{
+  int kpl, ipli;
+  char fnu[AS_MAXCH], *sp;
+  FILE *fp;
+  struct file_data *fdp = &swed.fidat[ifno];
+  struct ufile_header *uhp;
+  struct ufile_body *ubp;
+  struct plan_data *pdp;
+  strcpy(fnu, fdp->fnam);
+  sp = strrchr(fnu, '.');
+  if (sp == NULL || strlen(fnu) + strlen(SE_UFILE_SUFFIX) >= AS_MAXCH)
+    return;
+  strcpy(sp + 1, SE_UFILE_SUFFIX);
+  if ((fp = fopen(fnu, BFILE_R_ACCESS)) == NULL)
+    return;
+  /* the mapping remains valid after the file is closed */
+  fdp->uptr = swi_map_file(fp, &fdp->ulen);
+  fclose(fp);
+  if (fdp->uptr == NULL)
+    return;
+  uhp = (struct ufile_header *) fdp->uptr;
+  if (fdp->ulen < sizeof(struct ufile_header) + fdp->npl * sizeof(struct ufile_body)
+    || strncmp(uhp->magic, SEI_UFILE_MAGIC, 8) != 0
+    || uhp->test_endian != SEI_FILE_TEST_ENDIAN
+    || uhp->version != SEI_UFILE_VERSION
+    || uhp->fcrc != fdp->fcrc
+    || uhp->npl != fdp->npl)
+    goto not_usable;
+  ubp = (struct ufile_body *) (fdp->uptr + sizeof(struct ufile_header));
+  for (kpl = 0; kpl < fdp->npl; kpl++) {
+    ipli = fdp->ipl[kpl];
+    if (ipli >= SE_PLMOON_OFFSET) 
+      pdp = &swed.pldat[SEI_ANYBODY];
+    else
+      pdp = &swed.pldat[ipli];
+    if (ubp[kpl].ibdy != ipli || ubp[kpl].ncoe != pdp->ncoe
+      || ubp[kpl].tfstart != pdp->tfstart || ubp[kpl].dseg != pdp->dseg
+      || ubp[kpl].stride < 3 * pdp->ncoe || ubp[kpl].nndx < 0
+      || ubp[kpl].pos_coef % SEI_UFILE_ALIGN != 0
+      || (size_t) ubp[kpl].pos_coef + (size_t) ubp[kpl].nndx * ubp[kpl].stride * 8 > fdp->ulen
+      || (size_t) ubp[kpl].pos_neval + (size_t) ubp[kpl].nndx * 4 > fdp->ulen)
+      goto not_usable;
+  }
+  for (kpl = 0; kpl < fdp->npl; kpl++) {
+    ipli = fdp->ipl[kpl];
+    if (ipli >= SE_PLMOON_OFFSET) 
+      pdp = &swed.pldat[SEI_ANYBODY];
+    else
+      pdp = &swed.pldat[ipli];
+    pdp->ucoef = (double *) (fdp->uptr + ubp[kpl].pos_coef);
+    pdp->uneval = (int32 *) (fdp->uptr + ubp[kpl].pos_neval);
+    pdp->unndx = ubp[kpl].nndx;
+    pdp->ustride = ubp[kpl].stride;
+  }
+  return;
+not_usable:
+  swi_unmap_file(fdp->uptr, fdp->ulen);
+  fdp->uptr = NULL;
+  fdp->ulen = 0;
+}
+
+/* takes the segment containing tjd from the unpacked file, if present */
+static AS_BOOL ufile_fetch(struct plan_data *pdp, struct file_data *fdp, double tjd)
+{
+  int32 iseg;
+  if (pdp->ucoef == NULL || fdp->uptr == NULL)
+    return FALSE;
+  /* segment number as in get_new_segment() */
+  iseg = (int32) ((tjd - pdp->tfstart) / pdp->dseg);
+  if (iseg < 0 || iseg >= pdp->unndx)
+    return FALSE;
+  if (pdp->segp == NULL) {
+    pdp->segp = (double *) malloc((size_t) pdp->ncoe * 3 * 8);
+    if (pdp->segp == NULL)
+      return FALSE;
+  }
+  memcpy((void *) pdp->segp, (void *) (pdp->ucoef + iseg * pdp->ustride), (size_t) pdp->ncoe * 3 * 8);
+  pdp->tseg0 = pdp->tfstart + iseg * pdp->dseg;
+  pdp->tseg1 = pdp->tseg0 + pdp->dseg;
+  pdp->neval = pdp->uneval[iseg];
+  return TRUE;
+}
+
+/* SWISSEPH
+ * writes the unpacked companion file of a SWISSEPH file, s. swephunp.c.
+ * fname	name of .se1 file, searched in the ephemeris path
+ * fnout	returns the name of the file written
+ * All ephemeris files are closed before and after.
+ */
+int32 swi_write_unpacked_file(char *fname, char *fnout, char *serr)
+{
+  int ifno, kpl, ipli, ipl, i;
+  int32 iseg, pos, retc = OK;
+  int32 *neval = NULL;
+  double *dbuf = NULL;
+  char *sp;
+  FILE *fpout = NULL;
+  struct file_data *fdp;
+  struct plan_data *pdp;
+  struct ufile_header uh;
+  struct ufile_body ub[SEI_FILE_NMAXPLAN];
+  sp = strrchr(fname, (int) *DIR_GLUE);
+  sp = (sp == NULL) ? fname : sp + 1;
+  if (strncmp(sp, "sepl", 4) == 0)
+    ifno = SEI_FILE_PLANET;
+  else if (strncmp(sp, "semo", 4) == 0)
+    ifno = SEI_FILE_MOON;
+  else if (strncmp(sp, "seas", 4) == 0)
+    ifno = SEI_FILE_MAIN_AST;
+  else
+    ifno = SEI_FILE_ANY_AST;
+  swi_close_keep_topo_etc();
+  fdp = &swed.fidat[ifno];
+  fdp->fptr = swi_fopen(ifno, fname, swed.ephepath, serr);
+  if (fdp->fptr == NULL)
+    return ERR;
+  if (read_const(ifno, serr) != OK)
+    return ERR;
+  strcpy(fnout, fdp->fnam);
+  sp = strrchr(fnout, '.');
+  if (sp == NULL) {
+    if (serr != NULL)
+      sprintf(serr, "file name %s has no suffix", fnout);
+    retc = ERR;
+    goto end_wuf;
+  }
+  strcpy(sp + 1, SE_UFILE_SUFFIX);
+  /* layout of file */
+  memset((void *) &uh, 0, sizeof(struct ufile_header));
+  memset((void *) ub, 0, sizeof(ub));
+  strncpy(uh.magic, SEI_UFILE_MAGIC, 8);
+  uh.test_endian = SEI_FILE_TEST_ENDIAN;
+  uh.version = SEI_UFILE_VERSION;
+  uh.fcrc = fdp->fcrc;
+  uh.npl = fdp->npl;
+  uh.tfstart = fdp->tfstart;
+  uh.tfend = fdp->tfend;
+  pos = (int32) (sizeof(struct ufile_header) + fdp->npl * sizeof(struct ufile_body));
+  for (kpl = 0; kpl < fdp->npl; kpl++) {
+    ipli = fdp->ipl[kpl];
+    pdp = &swed.pldat[ipli >= SE_PLMOON_OFFSET ? SEI_ANYBODY : ipli];
+    ub[kpl].ibdy = ipli;
+    ub[kpl].ncoe = pdp->ncoe;
+    ub[kpl].nndx = pdp->nndx;
+    ub[kpl].stride = (3 * pdp->ncoe + 7) / 8 * 8;
+    ub[kpl].tfstart = pdp->tfstart;
+    ub[kpl].dseg = pdp->dseg;
+    pos = (pos + SEI_UFILE_ALIGN - 1) / SEI_UFILE_ALIGN * SEI_UFILE_ALIGN;
+    ub[kpl].pos_coef = pos;
+    pos += pdp->nndx * ub[kpl].stride * 8;
+    ub[kpl].pos_neval = pos;
+    pos += pdp->nndx * 4;
+  }
+  if ((fpout = fopen(fnout, BFILE_W_CREATE)) == NULL) {
+    if (serr != NULL)
+      sprintf(serr, "could not create file %s", fnout);
+    retc = ERR;
+    goto end_wuf;
+  }
+  fwrite((void *) &uh, sizeof(struct ufile_header), 1, fpout);
+  fwrite((void *) ub, sizeof(struct ufile_body), (size_t) fdp->npl, fpout);
+  pos = (int32) (sizeof(struct ufile_header) + fdp->npl * sizeof(struct ufile_body));
+  for (kpl = 0; kpl < fdp->npl; kpl++) {
+    ipli = fdp->ipl[kpl];
+    ipl = ipli >= SE_PLMOON_OFFSET ? SEI_ANYBODY : ipli;
+    pdp = &swed.pldat[ipl];
+    neval = (int32 *) calloc((size_t) pdp->nndx + 1, sizeof(int32));
+    dbuf = (double *) calloc((size_t) ub[kpl].stride, sizeof(double));
+    if (neval == NULL || dbuf == NULL) {
+      if (serr != NULL)
+	strcpy(serr, "error in malloc()");
+      retc = ERR;
+      goto end_wuf;
+    }
+    for (; pos < ub[kpl].pos_coef; pos++)
+      fputc(0, fpout);
+    for (iseg = 0; iseg < pdp->nndx; iseg++) {
+      if (get_new_segment(pdp->tfstart + (iseg + 0.5) * pdp->dseg, ipl, ifno, serr) != OK) {
+	retc = ERR;
+	goto end_wuf;
+      }
+      if (pdp->iflg & SEI_FLG_ROTATE) 
+	rot_back(ipl);
+      else
+	pdp->neval = pdp->ncoe;
+      neval[iseg] = pdp->neval;
+      for (i = 0; i < 3 * pdp->ncoe; i++)
+	dbuf[i] = pdp->segp[i];
+      fwrite((void *) dbuf, sizeof(double), (size_t) ub[kpl].stride, fpout);
+    }
+    fwrite((void *) neval, sizeof(int32), (size_t) pdp->nndx, fpout);
+    pos = ub[kpl].pos_neval + pdp->nndx * 4;
+    free(neval);
+    free(dbuf);
+    neval = NULL;
+    dbuf = NULL;
+  }
+  if (ferror(fpout)) {
+    if (serr != NULL)
+      sprintf(serr, "error writing file %s", fnout);
+    retc = ERR;
+  }
+end_wuf:
+  if (fpout != NULL) 
+    fclose(fpout);
+  if (neval != NULL)
+    free(neval);
+  if (dbuf != NULL)
+    free(dbuf);
+  swi_close_keep_topo_etc();
+  return retc;
+}
+
+/* segment number of tjd, as in get_new_segment() and fit_segment(); 
+ * negative before the start of the segments (fitted theories only) */
+static int32 segcache_key(struct plan_data *pdp, double tjd)
+{
+  return (int32) floor((tjd - pdp->tfstart) / pdp->dseg);
+}
+
+/* SWISSEPH
+ * cache of recently decoded segments of a body, s. swe_set_segment_cache().
+ * The cached coefficients are those after rot_back(), so a cache hit
+ * replaces both get_new_segment() and rot_back().
+ * segcache_fetch() makes the segment containing tjd the current segment
+ * of the body and returns TRUE, or returns FALSE if it is not in the cache.
+ */
+static AS_BOOL segcache_fetch(struct plan_data *pdp, double tjd)
+{
+  int i;
+  int32 iseg;
+  struct seg_cache *scp;
+  if (pdp->segcache == NULL)
+    return FALSE;
+  iseg = segcache_key(pdp, tjd);
+  for (i = 0, scp = pdp->segcache; i < pdp->nsegcache; i++, scp++) {
+    if (!scp->is_used || scp->iseg != iseg)
+      continue;
+    if (pdp->segp == NULL) {
+      pdp->segp = (double *) malloc((size_t) pdp->ncoe * 3 * 8);
+      if (pdp->segp == NULL)
+	return FALSE;
+    }
+    memcpy((void *) pdp->segp, (void *) scp->segp, (size_t) pdp->ncoe * 3 * 8);
+    pdp->tseg0 = scp->tseg0;
+    pdp->tseg1 = scp->tseg1;
+    pdp->neval = scp->neval;
+    scp->tused = ++pdp->segclock;
+    pdp->seghits++;
+    return TRUE;
+  }
+  return FALSE;
+}
+
+/* allocates n empty cache slots for a body */
+static AS_BOOL segcache_alloc(struct plan_data *pdp, int n)
+{
+  int i;
+  double *dp;
+  pdp->segcache = (struct seg_cache *) calloc((size_t) n, sizeof(struct seg_cache));
+  if (pdp->segcache == NULL)
+    return FALSE;
+  dp = (double *) malloc((size_t) n * pdp->ncoe * 3 * 8);
+  if (dp == NULL) {
+    free((void *) pdp->segcache);
+    pdp->segcache = NULL;
+    return FALSE;
+  }
+  for (i = 0; i < n; i++) 
+    pdp->segcache[i].segp = dp + i * pdp->ncoe * 3;
+  pdp->nsegcache = n;
+  return TRUE;
+}
+
+/* saves the current segment of a body in the least recently used slot */
+static void segcache_store(struct plan_data *pdp, double tjd)
+{
+  int i;
+  struct seg_cache *scp, *slot;
+  if (pdp->segp == NULL)
+    return;
+  if (pdp->segcache == NULL) {
+    if (swed.segcache_size <= 0 || !segcache_alloc(pdp, swed.segcache_size))
+      return;
+  }
+  slot = pdp->segcache;
+  for (i = 0, scp = pdp->segcache; i < pdp->nsegcache; i++, scp++) {
+    if (!scp->is_used) {
+      slot = scp;
+      break;
+    }
+    if (scp->tused < slot->tused)
+      slot = scp;
+  }
+  slot->is_used = TRUE;
+  slot->iseg = segcache_key(pdp, tjd);
+  slot->tseg0 = pdp->tseg0;
+  slot->tseg1 = pdp->tseg1;
+  slot->neval = pdp->neval;
+  slot->tused = ++pdp->segclock;
+  memcpy((void *) slot->segp, (void *) pdp->segp, (size_t) pdp->ncoe * 3 * 8);
+}
+
+static void segcache_free(struct plan_data *pdp)
+{
+  if (pdp->segcache != NULL) {
+    free((void *) pdp->segcache[0].segp);
+    free((void *) pdp->segcache);
+  }
+  pdp->segcache = NULL;
+  pdp->nsegcache = 0;
+}
+
+/* analytical theories fitted by Chebyshev segments, 
+ * s. swe_set_analytical_cache().
+ * The time axis is divided into cells of fit_dseg0[ifit] days, starting
+ * at SEI_FIT_T0. A segment covers its cell plus a margin of 1/16 of the 
+ * cell on each side. The current segment is used as long as t is not
+ * in the outer half of its margin, so that the positions at t +- the 
+ * speed interval, from which the callers compute speeds, are taken from
+ * the same polynomial. The polynomials approximate the cartesian coordinates of 
+ * the polar coordinates returned by the theory. If a fit does not reach 
+ * the required precision, the cell size of the theory is halved. 
+ * The recently used segments are kept in the segment cache of the
+ * struct plan_data, with at least SEI_FIT_NCACHE slots. */
+#define SEI_FIT_NCACHE	4
+static const double fit_dseg0[SEI_NFIT] = {
+  32, 64, 64, 128, 512, 512, 1024, 1024, 1024,	/* Moshier planets */
+  8, 16, 16,		/* Moon, interpolated apogee and perigee */
+};
+
+/* fits the segment of the theory containing tjd; returns OK, or
+ * ERR if the precision cannot be reached */
+static int fit_segment(struct plan_data *pdp, double tjd, int ibody, swi_theory_fn theory)
+{
+  int i, j, k, n = SEI_FIT_NCOE;
+  int32 icell;
+  double tseg0, tseg1, tmid, h, u, r, d, dmax, tol;
+  double tj[SEI_FIT_NCOE], f[SEI_FIT_NCOE][3], coef[3 * SEI_FIT_NCOE], x[3];
+  /* precision in radians */
+  double prec = swed.fit_prec / 3600.0 * DEGTORAD;
+  while (pdp->dseg >= SEI_FIT_DSEG_MIN) {
+    icell = (int32) floor((tjd - pdp->tfstart) / pdp->dseg);
+    tseg0 = pdp->tfstart + icell * pdp->dseg - pdp->dseg / 16;
+    tseg1 = tseg0 + pdp->dseg * 18 / 16;
+    tmid = (tseg0 + tseg1) / 2;
+    h = (tseg1 - tseg0) / 2;
+    /* theory at the Chebyshev nodes */
+    for (k = 0; k < n; k++) {
+      u = cos(PI * (k + 0.5) / n);
+      if (theory(tmid + u * h, ibody, x) < 0)
+	return ERR;
+      swi_polcart(x, f[k]);
+    }
+    for (j = 0; j < n; j++) {
+      coef[j] = coef[j + n] = coef[j + 2 * n] = 0;
+    }
+    for (k = 0; k < n; k++) {
+      /* T_j(u_k) = cos(j * acos(u_k)) by the recurrence */
+      u = cos(PI * (k + 0.5) / n);
+      tj[0] = 1;
+      tj[1] = u;
+      for (j = 2; j < n; j++)
+	tj[j] = 2 * u * tj[j - 1] - tj[j - 2];
+      for (j = 0; j < n; j++)
+	for (i = 0; i < 3; i++)
+	  coef[j + i * n] += f[k][i] * tj[j];
+    }
+    for (j = 0; j < 3 * n; j++)
+      coef[j] *= 2.0 / n;
+    /* drop the highest coefficients, as long as their sum is well 
+     * below the precision */
+    r = sqrt(square_sum(f[0]));
+    tol = prec * r / 10;
+    for (pdp->neval = n, d = 0; pdp->neval > 2; pdp->neval--) {
+      j = pdp->neval - 1;
+      d += fabs(coef[j]) + fabs(coef[j + n]) + fabs(coef[j + 2 * n]);
+      if (d > tol)
+	break;
+    }
+    /* check between the nodes and at the ends of the segment */
+    for (k = 0, dmax = 0; k <= n; k++) {
+      u = cos(PI * k / n);
+      if (theory(tmid + u * h, ibody, x) < 0)
+	return ERR;
+      swi_polcart(x, x);
+      swi_echeb_xyz(u, coef, pdp->neval, n, f[0], NULL);
+      for (i = 0, d = 0; i < 3; i++)
+	d += (f[0][i] - x[i]) * (f[0][i] - x[i]);
+      d = sqrt(d / square_sum(x));
+      if (d > dmax)
+	dmax = d;
+    }
+    if (dmax <= prec) {
+      memcpy((void *) pdp->segp, (void *) coef, sizeof(coef));
+      pdp->tseg0 = tseg0;
+      pdp->tseg1 = tseg1;
+      return OK;
+    }
+    /* cells of the old size are no longer valid */
+    pdp->dseg /= 2;
+    segcache_free(pdp);
+    pdp->tseg0 = pdp->tseg1 = 0;
+  }
+  return ERR;
+}
+
+static void free_fits(void)
+{
+  int i;
+  for (i = 0; i < SEI_NFIT; i++) {
+    segcache_free(&swed.fitdat[i]);
+    if (swed.fitdat[i].segp != NULL) 
+      free((void *) swed.fitdat[i].segp);
+    memset((void *) &swed.fitdat[i], 0, sizeof(struct plan_data));
+  }
+}
+
+/* polar coordinates pol of the theory for time tjd, from the fitted
+ * segments of the theory ifit (SEI_FIT_...); ibody is passed to the theory. 
+ * Returns ERR if the theory cannot be fitted with the precision set
+ * by swe_set_analytical_cache(); the caller then uses the theory itself. */
+int swi_fit_theory(int ifit, double tjd, int ibody, swi_theory_fn theory, double *pol)
+{
+  double t, dm, x[3];
+  struct plan_data *pdp = &swed.fitdat[ifit];
+  if (pdp->segp == NULL) {
+    pdp->ncoe = SEI_FIT_NCOE;
+    pdp->tfstart = SEI_FIT_T0;
+    pdp->dseg = fit_dseg0[ifit];
+    pdp->segp = (double *) malloc((size_t) pdp->ncoe * 3 * 8);
+    if (pdp->segp == NULL)
+      return ERR;
+    pdp->tseg0 = pdp->tseg1 = 0;
+  }
+  if (pdp->dseg < SEI_FIT_DSEG_MIN)	/* fit has failed before */
+    return ERR;
+  /* the current segment, unless tjd is in the outer half of its margin */
+  dm = (pdp->tseg1 - pdp->tseg0) / 36;
+  if (tjd < pdp->tseg0 + dm || tjd > pdp->tseg1 - dm) {
+    if (!segcache_fetch(pdp, tjd)) {
+      if (fit_segment(pdp, tjd, ibody, theory) != OK) 
+	return ERR;
+      pdp->segmisses++;
+      if (pdp->segcache == NULL) 
+	segcache_alloc(pdp, swed.segcache_size > SEI_FIT_NCACHE ? swed.segcache_size : SEI_FIT_NCACHE);
+      segcache_store(pdp, tjd);
+    }
+  }
+  t = (tjd - pdp->tseg0) / (pdp->tseg1 - pdp->tseg0) * 2 - 1;
+  swi_echeb_xyz(t, pdp->segp, pdp->neval, pdp->ncoe, x, NULL);
+  swi_cartpol(x, pol);
+  return OK;
+}
+
+/* SWISSEPH
+ * store of decoded segments shared by all threads, s. swe_set_shared_segments().
+ * A segment is identified by the CRC of its file header, the body number and
+ * the segment number. Nodes are pushed onto the bucket lists with atomic
+ * compare-and-swap and are never changed or removed while the store is in
+ * use, so lookups do not lock.
  */
-static int app_pos_etc_mean(int ipl, int32 iflag, char *serr) 
+#if SWI_USE_SHARED_SEGS
+static uint32 segstore_hash(uint32 fcrc, int32 ibdy, int32 iseg)
 {
-  int i;
-  int32 flg1, flg2;
-  double xx[6], xxsv[6];
-  struct plan_data *pdp = &swed.nddat[ipl];
-  struct epsilon *oe;
-  /* if the same conversions have already been done for the same 
-   * date, then return */
-  flg1 = iflag & ~SEFLG_EQUATORIAL & ~SEFLG_XYZ;
-  flg2 = pdp->xflgs & ~SEFLG_EQUATORIAL & ~SEFLG_XYZ;
-  if (flg1 == flg2) {
-    pdp->xflgs = iflag;
-    pdp->iephe = iflag & SEFLG_EPHMASK;
-    return OK;
+  uint32 h = fcrc ^ ((uint32) ibdy * 2654435761U) ^ ((uint32) iseg * 40503U);
+  h ^= h >> 16;
+  return h % SEI_SEGSTORE_NBUCKETS;
+}
+
+static struct seg_store_node *segstore_find(struct seg_store_node *np, struct seg_store_node *nend, uint32 fcrc, int32 ibdy, int32 iseg) 
+{
+  for (; np != NULL && np != nend; np = np->next) {
+    if (np->iseg == iseg && np->ibdy == ibdy && np->fcrc == fcrc)
+      return np;
   }
-  for (i = 0; i <= 5; i++)
-    xx[i] = pdp->x[i];
-  /* cartesian equatorial coordinates */
-  swi_polcart_sp(xx, xx);
-  swi_coortrf2(xx, xx, -swed.oec.seps, swed.oec.ceps);
-  swi_coortrf2(xx+3, xx+3, -swed.oec.seps, swed.oec.ceps);
-  if (!(iflag & SEFLG_SPEED))
-    for (i = 3; i <= 5; i++)
-      xx[i] = 0;
-  /* J2000 coordinates; required for sidereal positions */
-  if (((iflag & SEFLG_SIDEREAL) 
-    && (swed.sidd.sid_mode & SE_SIDBIT_ECL_T0))
-      || (swed.sidd.sid_mode & SE_SIDBIT_SSY_PLANE)) {
-    for (i = 0; i <= 5; i++)
-      xxsv[i] = xx[i];
-    /* xxsv is not J2000 yet! */
-    if (pdp->teval != J2000) {
-      swi_precess(xxsv, pdp->teval, iflag, J_TO_J2000);
-      if (iflag & SEFLG_SPEED)
-        swi_precess_speed(xxsv, pdp->teval, iflag, J_TO_J2000); 
+  return NULL;
+}
+#endif
+
+static AS_BOOL segstore_fetch(struct plan_data *pdp, struct file_data *fdp, double tjd)
+{
+#if SWI_USE_SHARED_SEGS
+  int32 iseg;
+  struct seg_store *st = swed.segstore;
+  struct seg_store_node *np;
+  if (st == NULL)
+    return FALSE;
+  iseg = (int32) ((tjd - pdp->tfstart) / pdp->dseg);
+  np = __atomic_load_n(&st->bucket[segstore_hash(fdp->fcrc, pdp->ibdy, iseg)], __ATOMIC_ACQUIRE);
+  np = segstore_find(np, NULL, fdp->fcrc, pdp->ibdy, iseg);
+  if (np == NULL || np->ncoe != pdp->ncoe)
+    return FALSE;
+  if (pdp->segp == NULL) {
+    pdp->segp = (double *) malloc((size_t) pdp->ncoe * 3 * 8);
+    if (pdp->segp == NULL)
+      return FALSE;
+  }
+  memcpy((void *) pdp->segp, (void *) np->segp, (size_t) pdp->ncoe * 3 * 8);
+  pdp->tseg0 = np->tseg0;
+  pdp->tseg1 = np->tseg1;
+  pdp->neval = np->neval;
+  pdp->seghits++;
+  return TRUE;
+#else
+  return FALSE;
+#endif
+}
+
+static void segstore_publish(struct plan_data *pdp, struct file_data *fdp, double tjd)
+{
+#if SWI_USE_SHARED_SEGS
+  int32 iseg;
+  long nbytes;
+  struct seg_store *st = swed.segstore;
+  struct seg_store_node *np, *head, **bp;
+  if (st == NULL || pdp->segp == NULL)
+    return;
+  nbytes = (long) (sizeof(struct seg_store_node) + (pdp->ncoe * 3 - 1) * sizeof(double));
+  if (__atomic_add_fetch(&st->nbytes, nbytes, __ATOMIC_RELAXED) > SEI_SEGSTORE_MAXBYTES) {
+    /* store is full; segments already in it remain available */
+    __atomic_sub_fetch(&st->nbytes, nbytes, __ATOMIC_RELAXED);
+    return;
+  }
+  np = (struct seg_store_node *) malloc((size_t) nbytes);
+  if (np == NULL) {
+    __atomic_sub_fetch(&st->nbytes, nbytes, __ATOMIC_RELAXED);
+    return;
+  }
+  iseg = (int32) ((tjd - pdp->tfstart) / pdp->dseg);
+  np->fcrc = fdp->fcrc;
+  np->ibdy = pdp->ibdy;
+  np->iseg = iseg;
+  np->ncoe = pdp->ncoe;
+  np->neval = pdp->neval;
+  np->tseg0 = pdp->tseg0;
+  np->tseg1 = pdp->tseg1;
+  memcpy((void *) np->segp, (void *) pdp->segp, (size_t) pdp->ncoe * 3 * 8);
+  bp = &st->bucket[segstore_hash(np->fcrc, np->ibdy, iseg)];
+  head = __atomic_load_n(bp, __ATOMIC_ACQUIRE);
+  for (;;) {
+    np->next = head;
+    if (__atomic_compare_exchange_n(bp, &head, np, FALSE, __ATOMIC_RELEASE, __ATOMIC_ACQUIRE))
+      return;
+    /* another thread has inserted in the meantime; it may have been
+     * the same segment. head now is the new list head. */
+    if (segstore_find(head, np->next, np->fcrc, np->ibdy, iseg) != NULL) {
+      free((void *) np);
+      __atomic_sub_fetch(&st->nbytes, nbytes, __ATOMIC_RELAXED);
+      return;
     }
   }
-  /*****************************************************
-   * if no precession, equator of date -> equator 2000 *
-   *****************************************************/
-  if (iflag & SEFLG_J2000) {
-    swi_precess(xx, pdp->teval, iflag, J_TO_J2000); 
-    if (iflag & SEFLG_SPEED)
-      swi_precess_speed(xx, pdp->teval, iflag, J_TO_J2000); 
-    oe = &swed.oec2000;
-  } else
-    oe = &swed.oec;
-  return app_pos_rest(pdp, iflag, xx, xxsv, oe, serr);
+#endif
 }
 
 /* fetch chebyshew coefficients from sweph file for
@@ -4389,7 +5402,10 @@ static int get_new_segment(double tjd, int ipli, int ifno, char *serr)
   retc = do_fread((void *) &fpos, 3, 1, 4, fp, fpos, freord, fendian, ifno, serr);
   if (retc != OK)
     goto return_error_gns;
-  fseek(fp, fpos, SEEK_SET);
+  if (fdp->mptr != NULL)
+    fdp->mpos = fpos;
+  else
+    fseek(fp, fpos, SEEK_SET);
   /* clear space of chebyshew coefficients */
   if (pdp->segp == NULL)
     pdp->segp = (double *) malloc((size_t) pdp->ncoe * 3 * 8);
@@ -4494,9 +5510,7 @@ static int get_new_segment(double tjd, int ipli, int ifno, char *serr)
   }
   return(OK);
 return_error_gns:
-  fclose(fdp->fptr);
-  // free(fdp->fptr);  is not from malloc(), must not be freed by us
-  fdp->fptr = NULL;
+  close_ephe_file(fdp);
   free_planets();
   return ERR;
 }
@@ -4776,6 +5790,7 @@ fendian, ifno, serr);
     goto file_damage;
   }
 #endif
+  fdp->fcrc = ulng;
   fseek(fp, fpos+4, SEEK_SET);
   /************************************* 
    * read general constants            * 
@@ -4805,6 +5820,9 @@ fendian, ifno, serr);
       pdp = &swed.pldat[ipli];
     }
     pdp->ibdy = ipli;
+    /* cached segments belong to the previous file */
+    segcache_free(pdp);
+    pdp->ucoef = NULL;
     /* file position of planet's index */
     retc = do_fread((void *) &pdp->lndx0, 4, 1, 4, fp, SEI_CURR_FPOS,
 freord, fendian, ifno, serr);
@@ -4879,9 +5897,7 @@ file_damage:
     }
   }
 return_error:
-  fclose(fdp->fptr);
-  // free(fdp->fptr);  is not from malloc(), must not be freed by us
-  fdp->fptr = NULL;
+  close_ephe_file(fdp);
   free_planets();
   return(ERR);
 }
@@ -4895,6 +5911,8 @@ return_error:
  *		(e.g. 3 byte int -> 4 byte int)
  * fp		file pointer
  * fpos		file position: if (fpos >= 0) then fseek
+ *		if the file is memory mapped (fdp->mptr), the data are 
+ *		taken from the mapped image and fp is not used.
  * freord	reorder bytes or no
  * fendian	little/bigendian
  * ifno		file number
@@ -4906,7 +5924,30 @@ static int do_fread(void *trg, int size, int count, int corrsize, FILE *fp, int3
   int totsize;
   unsigned char space[1000];
   unsigned char *targ = (unsigned char *) trg;
+  unsigned char *src = space;
+  struct file_data *fdp = &swed.fidat[ifno];
   totsize = size * count;
+  /* memory mapped file: read directly from the mapped image */
+  if (fdp->mptr != NULL) {
+    if (fpos >= 0) 
+      fdp->mpos = fpos;
+    if (fdp->mpos < 0 || (size_t) fdp->mpos + totsize > fdp->mlen) {
+      if (serr != NULL) {
+	strcpy(serr, "Ephemeris file is damaged (5). ");
+	if (strlen(serr) + strlen(fdp->fnam) < AS_MAXCH - 1) {
+	  sprintf(serr, "Ephemeris file %s is damaged (6).", fdp->fnam);
+	}
+      }
+      return(ERR);
+    }
+    src = fdp->mptr + fdp->mpos;
+    fdp->mpos += totsize;
+    if (!freord && size == corrsize) {
+      memcpy((void *) targ, (void *) src, (size_t) totsize);
+      return(OK);
+    }
+    goto reorder;
+  }
   if (fpos >= 0) 
     fseek(fp, fpos, SEEK_SET);
   /* if no byte reorder has to be done, and read size == return size */
@@ -4931,6 +5972,7 @@ static int do_fread(void *trg, int size, int count, int corrsize, FILE *fp, int3
       }
       return(ERR);
     }
+reorder:
     if (size != corrsize) {
       memset((void *) targ, 0, (size_t) count * corrsize);
     }
@@ -4946,7 +5988,7 @@ static int do_fread(void *trg, int size, int count, int corrsize, FILE *fp, int3
               (fendian == SEI_FILE_LITENDIAN &&  freord))
 	    k += corrsize - size;
 	}
-        targ[i*corrsize+k] = space[i*size+j];
+        targ[i*corrsize+k] = src[i*size+j];
       }
     }
   }
@@ -6304,6 +7346,249 @@ int32 fixstar_cut_string(char *srecord, char *star, struct fixed_star *stardata,
   return OK;
 }
 
+/* hash of a search key of a fixed star, FNV-1a */
+static uint32 fixstar_key_hash(const char *key)
+{
+  uint32 h = 2166136261u;
+  for (; *key != '\0'; key++) 
+    h = (h ^ (unsigned char) *key) * 16777619u;
+  return h;
+}
+
+/* builds the hash table of the search keys of the sorted array fs.
+ * Bayer designations are in fs[0 .. nreal-1], traditional names in
+ * fs[nreal .. nrecs-1]. A key that occurs more than once points to the 
+ * record that bsearch() finds, so that the hash table gives the same
+ * results as the binary search. Returns a table of *pnhash entries,
+ * record index or -1, or NULL if there is not enough memory. */
+static int32 *fixstar_make_hash(struct fixed_star *fs, int nrecs, int nreal, int32 *pnhash)
+{
+  int i, nhash;
+  uint32 k;
+  int32 *hash;
+  struct fixed_star *fsp, *fsbeg;
+  for (nhash = 16; nhash < 2 * nrecs; nhash *= 2)
+    ;
+  if ((hash = (int32 *) malloc((size_t) nhash * sizeof(int32))) == NULL)
+    return NULL;
+  for (i = 0; i < nhash; i++)
+    hash[i] = -1;
+  for (i = 0; i < nrecs; i++) {
+    for (k = fixstar_key_hash(fs[i].skey) & (nhash - 1); hash[k] >= 0; k = (k + 1) & (nhash - 1)) 
+      if (strcmp(fs[hash[k]].skey, fs[i].skey) == 0)
+	break;
+    if (hash[k] >= 0)	/* key already there */
+      continue;
+    fsbeg = (i < nreal) ? fs : fs + nreal;
+    fsp = (struct fixed_star *) bsearch((void *) fs[i].skey, (void *) fsbeg, 
+	       (size_t) ((i < nreal) ? nreal : nrecs - nreal), 
+	       sizeof(struct fixed_star), fstar_node_compare);
+    hash[k] = (int32) (fsp - fs);
+  }
+  *pnhash = nhash;
+  return hash;
+}
+
+/* finds a search key with the hash table; returns NULL if it is not in
+ * the ndata records beginning at fsbeg */
+static struct fixed_star *fixstar_hash_find(char *key, struct fixed_star *fsbeg, int ndata)
+{
+  uint32 k, mask = (uint32) swed.fixstar_nhash - 1;
+  int32 i;
+  for (k = fixstar_key_hash(key) & mask; (i = swed.fixstar_hash[k]) >= 0; k = (k + 1) & mask) {
+    if (strcmp(swed.fixed_stars[i].skey, key) == 0) {
+      if (swed.fixed_stars + i < fsbeg || swed.fixed_stars + i >= fsbeg + ndata)
+	return NULL;
+      return swed.fixed_stars + i;
+    }
+  }
+  return NULL;
+}
+
+/* CRC and length of the open fixed stars file */
+static int32 fixstar_file_crc(FILE *fp, uint32 *pcrc, int32 *plen)
+{
+  long len;
+  unsigned char *buf;
+  if (fseek(fp, 0, SEEK_END) != 0 || (len = ftell(fp)) <= 0 || len > 0x7fffffffL)
+    return ERR;
+  if ((buf = (unsigned char *) malloc((size_t) len)) == NULL)
+    return ERR;
+  rewind(fp);
+  if (fread((void *) buf, 1, (size_t) len, fp) != (size_t) len) {
+    free(buf);
+    return ERR;
+  }
+  *pcrc = swi_crc32(buf, (int) len);
+  *plen = (int32) len;
+  free(buf);
+  return OK;
+}
+
+/* name of the star index of the open fixed stars file */
+static int32 star_index_name(char *fnout)
+{
+  char *sp;
+  strcpy(fnout, swed.fidat[SEI_FILE_FIXSTAR].fnam);
+  sp = strrchr(fnout, '.');
+  if (sp == NULL || strlen(fnout) + strlen(SE_SFILE_SUFFIX) >= AS_MAXCH)
+    return ERR;
+  strcpy(sp + 1, SE_SFILE_SUFFIX);
+  return OK;
+}
+
+static void lock_star_index(void)
+{
+#if SWI_USE_SHARED_SEGS
+  while (__atomic_test_and_set(&starindex_lock, __ATOMIC_ACQUIRE))
+    ;
+#endif
+}
+
+static void unlock_star_index(void)
+{
+#if SWI_USE_SHARED_SEGS
+  __atomic_clear(&starindex_lock, __ATOMIC_RELEASE);
+#endif
+}
+
+/* makes swed.fixed_stars and swed.fixstar_hash point into a star index */
+static void attach_star_index(struct star_index *sip)
+{
+  struct sfile_header *shp = (struct sfile_header *) sip->mptr;
+  swed.starindex = sip;
+  swed.fixed_stars = (struct fixed_star *) (sip->mptr + shp->pos_recs);
+  swed.fixstar_hash = (int32 *) (sip->mptr + shp->pos_hash);
+  swed.fixstar_nhash = shp->nhash;
+  swed.n_fixstars_real = shp->nreal;
+  swed.n_fixstars_named = shp->nnamed;
+  swed.n_fixstars_records = shp->nrecs;
+}
+
+/* uses the binary star index (*.sbi) of the open fixed stars file, if it 
+ * exists and was made from this very file, s. swephunp.c. 
+ * The index is mapped into memory; with SWI_USE_SHARED_SEGS, the first
+ * mapping is shared by all threads and kept until the end of the process;
+ * later loads reuse it if the length and CRC of the text file still 
+ * match. Returns ERR if there is no usable index; the stars are then 
+ * read from the text file. */
+static int32 open_star_index(void)
+{
+  char fnsbi[AS_MAXCH];
+  uint32 tcrc;
+  int32 tlen;
+  FILE *fp;
+  struct star_index *sip = NULL;
+  struct sfile_header *shp;
+  if (star_index_name(fnsbi) != OK)
+    return ERR;
+  /* the index is valid only for the text file with this CRC */
+  if (fixstar_file_crc(swed.fixfp, &tcrc, &tlen) != OK)
+    return ERR;
+#if SWI_USE_SHARED_SEGS
+  lock_star_index();
+  if (starindex_global != NULL && strcmp(starindex_global->fnam, fnsbi) == 0 
+    && starindex_global->tlen == tlen && starindex_global->tcrc == tcrc) {
+    sip = starindex_global;
+    sip->nrefs++;
+  }
+  unlock_star_index();
+  if (sip != NULL) {
+    attach_star_index(sip);
+    return OK;
+  }
+#endif
+  if ((fp = fopen(fnsbi, BFILE_R_ACCESS)) == NULL)
+    return ERR;
+  if ((sip = (struct star_index *) calloc(1, sizeof(struct star_index))) == NULL) {
+    fclose(fp);
+    return ERR;
+  }
+  /* the mapping remains valid after the file is closed */
+  sip->mptr = swi_map_file(fp, &sip->mlen);
+  fclose(fp);
+  if (sip->mptr == NULL)
+    goto not_usable;
+  shp = (struct sfile_header *) sip->mptr;
+  if (sip->mlen < sizeof(struct sfile_header)
+    || strncmp(shp->magic, SEI_SFILE_MAGIC, 8) != 0
+    || shp->test_endian != SEI_FILE_TEST_ENDIAN
+    || shp->version != SEI_SFILE_VERSION
+    || shp->recsize != (int32) sizeof(struct fixed_star)
+    || shp->tlen != tlen || shp->tcrc != tcrc
+    || shp->nrecs <= 0 || shp->nreal < 0 || shp->nnamed < 0
+    || shp->nreal + shp->nnamed != shp->nrecs
+    || shp->nhash < shp->nrecs || (shp->nhash & (shp->nhash - 1)) != 0
+    || shp->pos_recs % 8 != 0 || shp->pos_hash % 4 != 0
+    || (size_t) shp->pos_recs + (size_t) shp->nrecs * shp->recsize > sip->mlen
+    || (size_t) shp->pos_hash + (size_t) shp->nhash * 4 > sip->mlen)
+    goto not_usable;
+  strcpy(sip->fnam, fnsbi);
+  sip->tlen = tlen;
+  sip->tcrc = tcrc;
+  sip->nrefs = 1;
+#if SWI_USE_SHARED_SEGS
+  /* the shared index keeps a reference of its own, so that it remains
+   * mapped after swe_close() until the end of the process */
+  lock_star_index();
+  if (starindex_global == NULL) {
+    starindex_global = sip;
+    sip->nrefs++;
+  }
+  unlock_star_index();
+#endif
+  attach_star_index(sip);
+  return OK;
+not_usable:
+  if (sip->mptr != NULL)
+    swi_unmap_file(sip->mptr, sip->mlen);
+  free((void *) sip);
+  return ERR;
+}
+
+/* frees the fixed stars data of this thread */
+static void free_fixed_stars(void)
+{
+  struct star_index *sip = swed.starindex;
+  if (sip != NULL) {
+    lock_star_index();
+    if (--sip->nrefs == 0) {
+      swi_unmap_file(sip->mptr, sip->mlen);
+      free((void *) sip);
+    }
+    unlock_star_index();
+  } else {
+    if (swed.fixed_stars != NULL)
+      free(swed.fixed_stars);
+    if (swed.fixstar_hash != NULL)
+      free(swed.fixstar_hash);
+  }
+  free_fixstar_cat();
+  swed.starindex = NULL;
+  swed.fixed_stars = NULL;
+  swed.fixstar_hash = NULL;
+  swed.fixstar_nhash = 0;
+  swed.n_fixstars_real = 0;
+  swed.n_fixstars_named = 0;
+  swed.n_fixstars_records = 0;
+}
+
+/* opens the fixed stars file, sefstars.txt or else fixstars.cat */
+static int32 open_fixstar_file(char *serr)
+{
+  if (swed.fixfp == NULL) {
+    if ((swed.fixfp = swi_fopen(SEI_FILE_FIXSTAR, SE_STARFILE, swed.ephepath, serr)) == NULL) {
+      swed.is_old_starfile = TRUE;
+      if ((swed.fixfp = swi_fopen(SEI_FILE_FIXSTAR, SE_STARFILE_OLD, swed.ephepath, NULL)) == NULL) {
+	swed.is_old_starfile = FALSE;
+	/* no fixed star file available, error message is already in serr. */
+	return ERR;
+      }
+    }
+  }
+  return OK;
+}
+
 /* function loads all fixed stars from file sefstars.txt,
  * into swed.fixed_stars, which is a pointer to an array
  * of struct fixed_stars.
@@ -6315,12 +7600,29 @@ int32 fixstar_cut_string(char *srecord, char *star, struct fixed_star *stardata,
  * this name as its search key.
  * The array is sorted in ascending order by search key. 
  *
+ * A hash table of the search keys is built, s. fixstar_make_hash().
+ * If a binary index of sefstars.txt exists (s. open_star_index()), 
+ * the array and the hash table are taken from it instead.
+ *
  * If an error occurs, the function returns value ERR.
  * If the stars were loaded at an earlier time the function returns
  * value -2, without doing anything and without error string.
  * On success, the function returns value OK.
  * */
 static int32 load_all_fixed_stars(char *serr) 
+{
+  if (swed.n_fixstars_records > 0) {
+    return -2;
+  }
+  if (open_fixstar_file(serr) != OK)
+    return ERR;
+  if (!swed.is_old_starfile && open_star_index() == OK)
+    return OK;
+  return load_fixed_stars_text(serr);
+}
+
+/* reads all fixed stars from the open text file, s. load_all_fixed_stars() */
+static int32 load_fixed_stars_text(char *serr) 
 {
   int32 retc = OK;
   int nstars = 0, nrecs = 0, nnamed = 0;
@@ -6329,19 +7631,6 @@ static int32 load_all_fixed_stars(char *serr)
   struct fixed_star fstdata;
   char last_starbayer[SWI_STAR_LENGTH + 1];
   *last_starbayer = '\0';
-  if (swed.n_fixstars_records > 0) {
-    return -2;
-  }
-  if (swed.fixfp == NULL) {
-    if ((swed.fixfp = swi_fopen(SEI_FILE_FIXSTAR, SE_STARFILE, swed.ephepath, serr)) == NULL) {
-      swed.is_old_starfile = TRUE;
-      if ((swed.fixfp = swi_fopen(SEI_FILE_FIXSTAR, SE_STARFILE_OLD, swed.ephepath, NULL)) == NULL) {
-	swed.is_old_starfile = FALSE;
-	/* no fixed star file available, error message is already in serr. */
-	return ERR;
-      }
-    }
-  }
   rewind(swed.fixfp);
   swed.fixed_stars = NULL;
   while (fgets(s, AS_MAXCH, swed.fixfp) != NULL) {
@@ -6390,32 +7679,86 @@ static int32 load_all_fixed_stars(char *serr)
   // fprintf(stderr, "nstars=%d, nrecords=%d\n", nstars, nrecs);	
   (void) qsort ((void *) swed.fixed_stars, (size_t) nrecs, sizeof (struct fixed_star),
                     (int (CMP_CALL_CONV *)(const void *,const void *))(fixedstar_name_compare));
+  /* without hash table, search_star_in_list() uses binary search */
+  swed.fixstar_hash = fixstar_make_hash(swed.fixed_stars, nrecs, nstars, &swed.fixstar_nhash);
   return retc;
 }
 
-/* function calculates a fixstar from a star data struct 
- * input:
- * struct fixed_star stardata      fixed star data struct
- * double tjd        julian daynumber 
- * int32 iflag       SEFLG_ specifications
- * output:
- * char *star        star name, Bayer designation
- * double xx[6]      position and speed
- * char *serr        error return string
- */
-static int32 fixstar_calc_from_struct(struct fixed_star *stardata, double tjd, int32 iflag, char *star, double *xx, char *serr)
+/* writes the binary index of the fixed stars file, s. swephunp.c.
+ * fnout	returns the name of the file written
+ * The stars are read from the text file, which is searched in the 
+ * ephemeris path. */
+int32 swi_write_star_index(char *fnout, char *serr)
+{
+  int32 retc = ERR;
+  FILE *fpout = NULL;
+  struct sfile_header sh;
+  static const char zeros[8] = {0};
+  free_fixed_stars();
+  if (swed.fixfp != NULL) {
+    fclose(swed.fixfp);
+    swed.fixfp = NULL;
+  }
+  if (open_fixstar_file(serr) != OK)
+    return ERR;
+  if (swed.is_old_starfile) {
+    if (serr != NULL)
+      sprintf(serr, "no index for old star file %s", SE_STARFILE_OLD);
+    goto end_wsi;
+  }
+  if (load_fixed_stars_text(serr) != OK) 
+    goto end_wsi;
+  if (swed.fixstar_hash == NULL) {
+    if (serr != NULL)
+      strcpy(serr, "error in malloc()");
+    goto end_wsi;
+  }
+  memset((void *) &sh, 0, sizeof(sh));
+  strcpy(sh.magic, SEI_SFILE_MAGIC);
+  sh.test_endian = SEI_FILE_TEST_ENDIAN;
+  sh.version = SEI_SFILE_VERSION;
+  if (fixstar_file_crc(swed.fixfp, &sh.tcrc, &sh.tlen) != OK) {
+    if (serr != NULL)
+      sprintf(serr, "error reading file %s", swed.fidat[SEI_FILE_FIXSTAR].fnam);
+    goto end_wsi;
+  }
+  sh.recsize = (int32) sizeof(struct fixed_star);
+  sh.nrecs = swed.n_fixstars_records;
+  sh.nreal = swed.n_fixstars_real;
+  sh.nnamed = swed.n_fixstars_named;
+  sh.nhash = swed.fixstar_nhash;
+  sh.pos_recs = (int32) sizeof(sh);
+  sh.pos_hash = sh.pos_recs + sh.nrecs * sh.recsize;
+  sh.pos_hash = (sh.pos_hash + 7) / 8 * 8;
+  if (star_index_name(fnout) != OK || (fpout = fopen(fnout, BFILE_W_CREATE)) == NULL) {
+    if (serr != NULL)
+      sprintf(serr, "could not create index of %s", swed.fidat[SEI_FILE_FIXSTAR].fnam);
+    goto end_wsi;
+  }
+  fwrite((void *) &sh, sizeof(sh), 1, fpout);
+  fwrite((void *) swed.fixed_stars, (size_t) sh.recsize, (size_t) sh.nrecs, fpout);
+  fwrite((void *) zeros, 1, (size_t) (sh.pos_hash - sh.pos_recs - sh.nrecs * sh.recsize), fpout);
+  fwrite((void *) swed.fixstar_hash, sizeof(int32), (size_t) sh.nhash, fpout);
+  if (ferror(fpout)) {
+    if (serr != NULL)
+      sprintf(serr, "error writing file %s", fnout);
+  } else {
+    retc = OK;
+  }
+end_wsi:
+  if (fpout != NULL) 
+    fclose(fpout);
+  free_fixed_stars();
+  return retc;
+}
+
+/* prepares the computation of fixed stars at tjd: checks the flags,
+ * the ephemeris, obliquity and nutation.
+ * returns the corrected iflag, which always includes SEFLG_SPEED */
+static int32 fixstar_prepare(double tjd, int32 iflag, char *serr)
 {
   int i;
-  int32 retc = OK;
-  double epoch, radv, parall;
-  double ra_pm, de_pm, ra, de, t;
-  double daya[2], rdist;
-  double x[6], xxsv[6], xobs[6], xobs_dt[6], *xpo = NULL, *xpo_dt = NULL;
-  static TLS double xearth[6], xearth_dt[6], xsun[6], xsun_dt[6];
-  double dt = PLAN_SPEED_INTV * 0.1;
-  int32 epheflag, iflgsave;
-  struct epsilon *oe = &swed.oec2000;
-  iflgsave = iflag;
+  int32 epheflag;
   iflag |= SEFLG_SPEED; /* we need this in order to work correctly */
   if (serr != NULL)
     *serr = '\0';
@@ -6432,8 +7775,7 @@ static int32 fixstar_calc_from_struct(struct fixed_star *stardata, double tjd, i
       swed.jpl_file_is_open = FALSE;
     }
     for (i = 0; i < SEI_NEPHFILES; i ++) {
-      if (swed.fidat[i].fptr != NULL) 
-	fclose(swed.fidat[i].fptr);
+      close_ephe_file(&swed.fidat[i]);
       memset((void *) &swed.fidat[i], 0, sizeof(struct file_data));
     }
     swed.last_epheflag = epheflag;
@@ -6450,15 +7792,25 @@ static int32 fixstar_calc_from_struct(struct fixed_star *stardata, double tjd, i
    * nutation                               * 
    ******************************************/
   swi_check_nutation(tjd, iflag);
-  sprintf(star, "%s,%s", stardata->starname, stardata->starbayer);
+  return iflag;
+}
+
+/* cartesian position and space motion (per day) of a star, 
+ * referred to ICRF or J2000 as required by the ephemeris.
+ * *tref returns the date, from which the proper motion is counted */
+static void fixstar_cartesian(struct fixed_star *stardata, int32 iflag, double *x, double *tref)
+{
+  double epoch, radv, parall;
+  double ra_pm, de_pm, ra, de;
+  double rdist;
   epoch = stardata->epoch;
   ra_pm = stardata->ramot; de_pm = stardata->demot;
   radv = stardata->radvel; parall = stardata->parall; 
   ra = stardata->ra; de = stardata->de;
   if (epoch == 1950) {
-    t= (tjd - B1950);	/* days since 1950.0 */
+    *tref = B1950;
   } else { /* epoch == 2000 */
-    t= (tjd - J2000);	/* days since 2000.0 */
+    *tref = J2000;
   }
   x[0] = ra;
   x[1] = de;
@@ -6493,6 +7845,18 @@ static int32 fixstar_calc_from_struct(struct fixed_star *stardata, double tjd, i
       swi_bias(x, J2000, SEFLG_SPEED, FALSE);
     }
   }
+}
+
+/* barycentric earth, sun and observer at tjd and tjd - dt.
+ * *pxpo and *pxpo_dt return the origin for parallax and aberration
+ * (xobs, xobs_dt or the sun), or NULL if there is none */
+static int32 fixstar_observer(double tjd, int32 iflag, double dt, double *xobs, double *xobs_dt, double **pxpo, double **pxpo_dt, char *serr)
+{
+  int i;
+  int32 retc;
+  int32 epheflag = iflag & SEFLG_EPHMASK;
+  double *xpo = NULL, *xpo_dt = NULL;
+  static TLS double xearth[6], xearth_dt[6], xsun[6], xsun_dt[6];
   /**************************************************** 
    * earth/sun 
    * for parallax, light deflection, and aberration,
@@ -6543,6 +7907,37 @@ static int32 fixstar_calc_from_struct(struct fixed_star *stardata, double tjd, i
     xpo = xobs;
     xpo_dt = xobs_dt;
   }
+  *pxpo = xpo;
+  *pxpo_dt = xpo_dt;
+  return OK;
+}
+
+/* function calculates a fixstar from a star data struct 
+ * input:
+ * struct fixed_star stardata      fixed star data struct
+ * double tjd        julian daynumber 
+ * int32 iflag       SEFLG_ specifications
+ * output:
+ * char *star        star name, Bayer designation
+ * double xx[6]      position and speed
+ * char *serr        error return string
+ */
+static int32 fixstar_calc_from_struct(struct fixed_star *stardata, double tjd, int32 iflag, char *star, double *xx, char *serr)
+{
+  int i;
+  double t, tref;
+  double daya[2];
+  double x[6], xxsv[6], xobs[6], xobs_dt[6], *xpo = NULL, *xpo_dt = NULL;
+  double dt = PLAN_SPEED_INTV * 0.1;
+  int32 iflgsave;
+  struct epsilon *oe = &swed.oec2000;
+  iflgsave = iflag;
+  iflag = fixstar_prepare(tjd, iflag, serr);
+  sprintf(star, "%s,%s", stardata->starname, stardata->starbayer);
+  fixstar_cartesian(stardata, iflag, x, &tref);
+  t = tjd - tref;	/* days since 1950.0 or 2000.0 */
+  if (fixstar_observer(tjd, iflag, dt, xobs, xobs_dt, &xpo, &xpo_dt, serr) != OK)
+    return ERR;
   if (xpo == NULL) {
     for (i = 0; i <= 2; i++) {
       x[i] += t * x[i+3];	
@@ -6667,6 +8062,382 @@ if ((0)) {
   return iflag;
 }
 
+/* constants of one epoch for swe_fixstar2_catalog(): deflection of light,
+ * aberration, and the linear transformation from ICRF to the output 
+ * frame (bias, precession, nutation, ecliptic) as matrices */
+struct fixstar_epoch {
+  AS_BOOL do_defl, do_aberr;
+  double *xpo, *xpo_dt;		/* origin for parallax, NULL if none */
+  double dt;			/* interval of aberration speed */
+  /* deflection: unit vector sun -> earth at tjd (e0) and 
+   * tjd - dtsp (e1), earth - sun for q at tjd (qo0) and tjd - dtsp (qo1) */
+  double dtsp, e0[3], e1[3], qo0[3], qo1[3];
+  double g0, g1, sunr0, sunr1;
+  /* aberration: velocities of observer at tjd (v0) and tjd - dt (v1) */
+  double v0[3], v1[3], b0, b1;
+  /* x' = A x, v' = A v + C x */
+  double A[3][3], C[3][3];
+};
+
+/* the frame bias and the model that fixstar_cartesian() used;
+ * the catalog must be rebuilt, if it changes */
+static int32 fixstar_cat_key(int32 iflag)
+{
+  int32 key = swed.astro_models[SE_MODEL_BIAS] + 1;
+  if (swi_get_denum(SEI_SUN, iflag) >= 403)
+    key += 1000;
+  return key;
+}
+
+static int fixstar_cat_cmp(const void *p1, const void *p2)
+{
+  const struct fixed_star *s1 = &swed.fixed_stars[*(const int32 *) p1];
+  const struct fixed_star *s2 = &swed.fixed_stars[*(const int32 *) p2];
+  if (s1->mag != s2->mag)
+    return s1->mag < s2->mag ? -1 : 1;
+  return *(const int32 *) p1 - *(const int32 *) p2;
+}
+
+static void free_fixstar_cat(void)
+{
+  if (swed.fixstar_cat.buf != NULL)
+    free((void *) swed.fixstar_cat.buf);
+  memset((void *) &swed.fixstar_cat, 0, sizeof(struct fixstar_cat));
+}
+
+/* builds swed.fixstar_cat from the real stars of swed.fixed_stars,
+ * sorted by magnitude */
+static int32 fixstar_cat_build(int32 iflag, char *serr)
+{
+  int i, k, n = swed.n_fixstars_real;
+  int32 key = fixstar_cat_key(iflag);
+  double x[6], *buf;
+  struct fixstar_cat *fc = &swed.fixstar_cat;
+  if (fc->n == n && fc->key == key)
+    return OK;
+  free_fixstar_cat();
+  if (n == 0) 
+    return OK;
+  /* 8 arrays of doubles and 1 of int32; 
+   * the arrays of doubles aligned to 32 bytes for SIMD */
+  n = (n + 3) & ~3;
+  if ((buf = (double *) malloc((size_t) n * 9 * sizeof(double) + 32)) == NULL) {
+    if (serr != NULL)
+      strcpy(serr, "error in malloc() for fixed stars catalog");
+    return ERR;
+  }
+  fc->buf = buf;
+  buf = (double *) (((size_t) buf + 31) & ~(size_t) 31);
+  for (i = 0; i < 6; i++)
+    fc->x[i] = buf + i * n;
+  fc->tref = buf + 6 * n;
+  fc->mag = buf + 7 * n;
+  fc->istar = (int32 *) (buf + 8 * n);
+  n = swed.n_fixstars_real;
+  for (k = 0; k < n; k++)
+    fc->istar[k] = k;
+  qsort((void *) fc->istar, (size_t) n, sizeof(int32), fixstar_cat_cmp);
+  for (k = 0; k < n; k++) {
+    fixstar_cartesian(&swed.fixed_stars[fc->istar[k]], iflag, x, &fc->tref[k]);
+    for (i = 0; i < 6; i++)
+      fc->x[i][k] = x[i];
+    fc->mag[k] = swed.fixed_stars[fc->istar[k]].mag;
+    fc->istar[k]++;	/* sequential star number */
+  }
+  fc->n = n;
+  fc->key = key;
+  return OK;
+}
+
+/* applies the linear transformations of fixstar_calc_from_struct()
+ * after aberration to the unit vectors; the columns of A and C are
+ * the resulting positions and speeds */
+static void fixstar_epoch_matrices(double tjd, int32 iflag, struct fixstar_epoch *fe)
+{
+  int i, j;
+  double x[6];
+  struct epsilon *oe;
+  for (j = 0; j <= 2; j++) {
+    for (i = 0; i <= 5; i++)
+      x[i] = (i == j) ? 1 : 0;
+    /* ICRS to J2000 */
+    if (!(iflag & SEFLG_ICRS) && (swi_get_denum(SEI_SUN, iflag) >= 403 || (iflag & SEFLG_BARYCTR))) 
+      swi_bias(x, tjd, iflag, FALSE);
+    /* precession */
+    if ((iflag & SEFLG_J2000) == 0) {
+      swi_precess(x, tjd, iflag, J2000_TO_J);
+      swi_precess_speed(x, tjd, iflag, J2000_TO_J);
+      oe = &swed.oec;
+    } else
+      oe = &swed.oec2000;
+    /* nutation */
+    if (!(iflag & SEFLG_NONUT))
+      swi_nutate(x, iflag, FALSE);
+    /* transformation to ecliptic */
+    if ((iflag & SEFLG_EQUATORIAL) == 0) {
+      swi_coortrf2(x, x, oe->seps, oe->ceps);
+      swi_coortrf2(x+3, x+3, oe->seps, oe->ceps);
+      if (!(iflag & SEFLG_NONUT)) {
+	swi_coortrf2(x, x, swed.nut.snut, swed.nut.cnut);
+	swi_coortrf2(x+3, x+3, swed.nut.snut, swed.nut.cnut);
+      }
+    }
+    for (i = 0; i <= 2; i++) {
+      fe->A[i][j] = x[i];
+      fe->C[i][j] = x[i+3];
+    }
+  }
+}
+
+/* sets up the constants of swi_deflect_light() and aberr_light() 
+ * which do not depend on the star; s. there */
+static void fixstar_epoch_setup(double tjd, int32 iflag, double *xpo, double *xpo_dt, struct fixstar_epoch *fe)
+{
+  int i;
+  double re, v2;
+  struct plan_data *pedp = &swed.pldat[SEI_EARTH];
+  struct plan_data *psdp = &swed.pldat[SEI_SUNBARY];
+  AS_BOOL is_sweph = (pedp->iephe == SEFLG_JPLEPH || pedp->iephe == SEFLG_SWIEPH);
+  fe->xpo = xpo;
+  fe->xpo_dt = xpo_dt;
+  fe->dt = PLAN_SPEED_INTV * 0.1;
+  fe->do_defl = (iflag & SEFLG_TRUEPOS) == 0 && (iflag & SEFLG_NOGDEFL) == 0;
+  fe->do_aberr = (iflag & SEFLG_TRUEPOS) == 0 && (iflag & SEFLG_NOABERR) == 0;
+  if (fe->do_defl) {
+    fe->dtsp = -DEFL_SPEED_INTV;
+    for (i = 0; i <= 2; i++) {
+      fe->e0[i] = pedp->x[i] - (is_sweph ? psdp->x[i] : 0);
+      fe->e1[i] = fe->e0[i] - fe->dtsp * (pedp->x[i+3] - (is_sweph ? psdp->x[i+3] : 0));
+      fe->qo0[i] = pedp->x[i] - psdp->x[i];
+      fe->qo1[i] = fe->qo0[i] - fe->dtsp * (pedp->x[i+3] - psdp->x[i+3]);
+    }
+    re = sqrt(square_sum(fe->e0));
+    for (i = 0; i <= 2; i++)
+      fe->e0[i] /= re;
+    fe->g0 = 2.0 * HELGRAVCONST / CLIGHT / CLIGHT / AUNIT / re; 
+    fe->sunr0 = SUN_RADIUS / re;
+    re = sqrt(square_sum(fe->e1));
+    for (i = 0; i <= 2; i++)
+      fe->e1[i] /= re;
+    fe->g1 = 2.0 * HELGRAVCONST / CLIGHT / CLIGHT / AUNIT / re; 
+    fe->sunr1 = SUN_RADIUS / re;
+  }
+  if (fe->do_aberr) {
+    for (i = 0; i <= 2; i++) {
+      fe->v0[i] = xpo[i+3] / 24.0 / 3600.0 / CLIGHT * AUNIT;
+      fe->v1[i] = xpo_dt[i+3] / 24.0 / 3600.0 / CLIGHT * AUNIT;
+    }
+    v2 = square_sum(fe->v0);
+    fe->b0 = sqrt(1 - v2);
+    v2 = square_sum(fe->v1);
+    fe->b1 = sqrt(1 - v2);
+  }
+  fixstar_epoch_matrices(tjd, iflag, fe);
+}
+
+/* deflection of light for one position and its speed x;
+ * returns FALSE, without changing x, if the star is behind the sun, 
+ * where the deflection needs the mass distribution of swi_deflect_light() */
+static AS_BOOL fixstar_deflect(const struct fixstar_epoch *fe, double *x)
+{
+  int i;
+  double u[3], q[3], x2[3], x3[3], ru, rq, uq, ue, qe, g;
+  double u2[3], ru2;
+  ru = sqrt(square_sum(x));
+  for (i = 0; i <= 2; i++) {
+    u[i] = x[i] / ru;
+    q[i] = x[i] + fe->qo0[i];
+  }
+  rq = sqrt(square_sum(q));
+  for (i = 0; i <= 2; i++) 
+    q[i] /= rq;
+  uq = dot_prod(u, q);
+  ue = dot_prod(u, fe->e0);
+  qe = dot_prod(q, fe->e0);
+  if (sqrt(1 - ue * ue) < fe->sunr0)
+    return FALSE;
+  g = fe->g0 / (1.0 + qe);
+  for (i = 0; i <= 2; i++) 
+    x2[i] = ru * (u[i] + g * (uq * fe->e0[i] - ue * q[i]));
+  /* speed */
+  for (i = 0; i <= 2; i++) 
+    u2[i] = x[i] - fe->dtsp * x[i+3]; 
+  ru2 = sqrt(square_sum(u2));
+  for (i = 0; i <= 2; i++) {
+    u2[i] /= ru2;
+    q[i] = x[i] - fe->dtsp * x[i+3] + fe->qo1[i];
+  }
+  rq = sqrt(square_sum(q));
+  for (i = 0; i <= 2; i++) 
+    q[i] /= rq;
+  uq = dot_prod(u2, q);
+  ue = dot_prod(u2, fe->e1);
+  qe = dot_prod(q, fe->e1);
+  if (sqrt(1 - ue * ue) < fe->sunr1)
+    return FALSE;
+  g = fe->g1 / (1.0 + qe);
+  for (i = 0; i <= 2; i++) 
+    x3[i] = ru2 * (u2[i] + g * (uq * fe->e1[i] - ue * q[i]));
+  for (i = 0; i <= 2; i++) {
+    x[i+3] += ((x2[i] - x[i]) - (x3[i] - u2[i] * ru2)) / fe->dtsp;
+    x[i] = x2[i];
+  }
+  return TRUE;
+}
+
+/* aberration of light of position u with velocity v, b = sqrt(1 - v^2) */
+static void fixstar_aberr(double *u, const double *v, double b)
+{
+  int i;
+  double ru, f1, f2;
+  ru = sqrt(square_sum(u));
+  f1 = dot_prod(u, v) / ru;
+  f2 = 1.0 + f1 / (1.0 + b);
+  for (i = 0; i <= 2; i++) 
+    u[i] = (b * u[i] + f2 * ru * v[i]) / (1.0 + f1);
+}
+
+/* apparent position of one star of the catalog, cartesian, in the
+ * frame of fixstar_epoch_matrices(); k is its index in swed.fixstar_cat */
+static void fixstar_cat_apparent(const struct fixstar_epoch *fe, int32 k, double t, double *xx)
+{
+  int i;
+  double x[6], x2[3];
+  const struct fixstar_cat *fc = &swed.fixstar_cat;
+  t -= fc->tref[k];
+  for (i = 0; i <= 2; i++) {
+    x[i] = fc->x[i][k] + t * fc->x[i+3][k];
+    x[i+3] = fc->x[i+3][k];
+    if (fe->xpo != NULL) {
+      x[i] -= fe->xpo[i];
+      x[i+3] -= fe->xpo[i+3];
+    }
+  }
+  if (fe->do_defl && !fixstar_deflect(fe, x))
+    swi_deflect_light(x, 0, SEFLG_SPEED);
+  if (fe->do_aberr) {
+    for (i = 0; i <= 2; i++) 
+      x2[i] = x[i] - fe->dt * x[i+3];
+    fixstar_aberr(x, fe->v0, fe->b0);
+    fixstar_aberr(x2, fe->v1, fe->b1);
+    for (i = 0; i <= 2; i++)
+      x[i+3] = (x[i] - x2[i]) / fe->dt;
+  }
+  for (i = 0; i <= 2; i++) {
+    xx[i] = fe->A[i][0] * x[0] + fe->A[i][1] * x[1] + fe->A[i][2] * x[2];
+    xx[i+3] = fe->A[i][0] * x[3] + fe->A[i][1] * x[4] + fe->A[i][2] * x[5]
+	    + fe->C[i][0] * x[0] + fe->C[i][1] * x[1] + fe->C[i][2] * x[2];
+  }
+}
+
+#if SWI_USE_AVX2
+__attribute__((target("avx2")))
+static inline __m256d dot3_avx2(const __m256d *a, const __m256d *b)
+{
+  return _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(a[0], b[0]), _mm256_mul_pd(a[1], b[1])), _mm256_mul_pd(a[2], b[2]));
+}
+
+/* s. fixstar_aberr(); 4 positions */
+__attribute__((target("avx2")))
+static inline void fixstar_aberr_avx2(__m256d *u, const double *v, double b)
+{
+  int i;
+  __m256d V[3], ru, f1, f2, one = _mm256_set1_pd(1.0), B = _mm256_set1_pd(b);
+  for (i = 0; i <= 2; i++)
+    V[i] = _mm256_set1_pd(v[i]);
+  ru = _mm256_sqrt_pd(dot3_avx2(u, u));
+  f1 = _mm256_div_pd(dot3_avx2(u, V), ru);
+  f2 = _mm256_add_pd(one, _mm256_div_pd(f1, _mm256_set1_pd(1.0 + b)));
+  f1 = _mm256_add_pd(one, f1);
+  for (i = 0; i <= 2; i++)
+    u[i] = _mm256_div_pd(_mm256_add_pd(_mm256_mul_pd(B, u[i]), _mm256_mul_pd(_mm256_mul_pd(f2, ru), V[i])), f1);
+}
+
+/* s. fixstar_deflect(); 4 positions and speeds, one set of e, qo, g, sunr.
+ * returns the deflected positions xd, and in u the unit vectors, 
+ * in *pru their lengths; FALSE if one of the stars is behind the sun */
+__attribute__((target("avx2")))
+static inline AS_BOOL fixstar_deflect_avx2(const __m256d *x, const double *e, const double *qo, double g, double sunr, __m256d *xd, __m256d *u, __m256d *pru)
+{
+  int i;
+  __m256d E[3], q[3], ru, rq, uq, ue, qe, G, one = _mm256_set1_pd(1.0);
+  for (i = 0; i <= 2; i++)
+    E[i] = _mm256_set1_pd(e[i]);
+  ru = _mm256_sqrt_pd(dot3_avx2(x, x));
+  for (i = 0; i <= 2; i++) {
+    u[i] = _mm256_div_pd(x[i], ru);
+    q[i] = _mm256_add_pd(x[i], _mm256_set1_pd(qo[i]));
+  }
+  rq = _mm256_sqrt_pd(dot3_avx2(q, q));
+  for (i = 0; i <= 2; i++) 
+    q[i] = _mm256_div_pd(q[i], rq);
+  uq = dot3_avx2(u, q);
+  ue = dot3_avx2(u, E);
+  qe = dot3_avx2(q, E);
+  if (_mm256_movemask_pd(_mm256_cmp_pd(_mm256_sqrt_pd(_mm256_sub_pd(one, _mm256_mul_pd(ue, ue))), _mm256_set1_pd(sunr), _CMP_LT_OQ)) != 0)
+    return FALSE;
+  G = _mm256_div_pd(_mm256_set1_pd(g), _mm256_add_pd(one, qe));
+  for (i = 0; i <= 2; i++) 
+    xd[i] = _mm256_mul_pd(ru, _mm256_add_pd(u[i], _mm256_mul_pd(G, _mm256_sub_pd(_mm256_mul_pd(uq, E[i]), _mm256_mul_pd(ue, q[i])))));
+  *pru = ru;
+  return TRUE;
+}
+
+/* s. fixstar_cat_apparent(); the 4 stars k .. k + 3, k a multiple of 4.
+ * returns FALSE if one of them needs swi_deflect_light() */
+__attribute__((target("avx2")))
+static AS_BOOL fixstar_cat_apparent_avx2(const struct fixstar_epoch *fe, int32 k, double t, double *xx)
+{
+  int i, j;
+  __m256d T, x[6], x2[3], x3[3], xs[3], u[3], ru, dtsp, dt;
+  double out[6][4];
+  const struct fixstar_cat *fc = &swed.fixstar_cat;
+  T = _mm256_sub_pd(_mm256_set1_pd(t), _mm256_load_pd(fc->tref + k));
+  for (i = 0; i <= 2; i++) {
+    x[i+3] = _mm256_load_pd(fc->x[i+3] + k);
+    x[i] = _mm256_add_pd(_mm256_load_pd(fc->x[i] + k), _mm256_mul_pd(T, x[i+3]));
+    if (fe->xpo != NULL) {
+      x[i] = _mm256_sub_pd(x[i], _mm256_set1_pd(fe->xpo[i]));
+      x[i+3] = _mm256_sub_pd(x[i+3], _mm256_set1_pd(fe->xpo[i+3]));
+    }
+  }
+  if (fe->do_defl) {
+    dtsp = _mm256_set1_pd(fe->dtsp);
+    if (!fixstar_deflect_avx2(x, fe->e0, fe->qo0, fe->g0, fe->sunr0, x2, u, &ru))
+      return FALSE;
+    for (i = 0; i <= 2; i++) 
+      xs[i] = _mm256_sub_pd(x[i], _mm256_mul_pd(dtsp, x[i+3]));
+    if (!fixstar_deflect_avx2(xs, fe->e1, fe->qo1, fe->g1, fe->sunr1, x3, u, &ru))
+      return FALSE;
+    for (i = 0; i <= 2; i++) {
+      x[i+3] = _mm256_add_pd(x[i+3], _mm256_div_pd(_mm256_sub_pd(_mm256_sub_pd(x2[i], x[i]), _mm256_sub_pd(x3[i], _mm256_mul_pd(u[i], ru))), dtsp));
+      x[i] = x2[i];
+    }
+  }
+  if (fe->do_aberr) {
+    dt = _mm256_set1_pd(fe->dt);
+    for (i = 0; i <= 2; i++) 
+      x2[i] = _mm256_sub_pd(x[i], _mm256_mul_pd(dt, x[i+3]));
+    fixstar_aberr_avx2(x, fe->v0, fe->b0);
+    fixstar_aberr_avx2(x2, fe->v1, fe->b1);
+    for (i = 0; i <= 2; i++)
+      x[i+3] = _mm256_div_pd(_mm256_sub_pd(x[i], x2[i]), dt);
+  }
+  for (i = 0; i <= 2; i++) {
+    _mm256_storeu_pd(out[i], 
+      _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(_mm256_set1_pd(fe->A[i][0]), x[0]), _mm256_mul_pd(_mm256_set1_pd(fe->A[i][1]), x[1])), _mm256_mul_pd(_mm256_set1_pd(fe->A[i][2]), x[2])));
+    _mm256_storeu_pd(out[i+3], 
+      _mm256_add_pd(
+	_mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(_mm256_set1_pd(fe->A[i][0]), x[3]), _mm256_mul_pd(_mm256_set1_pd(fe->A[i][1]), x[4])), _mm256_mul_pd(_mm256_set1_pd(fe->A[i][2]), x[5])),
+	_mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(_mm256_set1_pd(fe->C[i][0]), x[0]), _mm256_mul_pd(_mm256_set1_pd(fe->C[i][1]), x[1])), _mm256_mul_pd(_mm256_set1_pd(fe->C[i][2]), x[2]))));
+  }
+  for (j = 0; j < 4; j++)
+    for (i = 0; i <= 5; i++)
+      xx[(k + j) * 6 + i] = out[i][j];
+  return TRUE;
+}
+#endif /* SWI_USE_AVX2 */
+
 /* function searches a star in fixed stars list, i.e. the data loaded from file 
  * sefstars.txt
  */
@@ -6731,7 +8502,10 @@ static int32 search_star_in_list(char *sstar, struct fixed_star *stardata, char
       stardatabegp = &(swed.fixed_stars[swed.n_fixstars_real]);
       ndata = swed.n_fixstars_named;
     }
-    stardatap = (struct fixed_star *) bsearch((void *) searchkey, 
+    if (swed.fixstar_hash != NULL)
+      stardatap = fixstar_hash_find(searchkey, stardatabegp, ndata);
+    else
+      stardatap = (struct fixed_star *) bsearch((void *) searchkey, 
 	       (void *) stardatabegp, (size_t) ndata,
 	       sizeof (struct fixed_star), 
 	       fstar_node_compare);
@@ -6896,6 +8670,124 @@ int32 CALL_CONV swe_fixstar2_ut(char *star, double tjd_ut, int32 iflag,
   return retflag;
 }
 
+/* apparent positions of all stars of the fixed stars file (without the
+ * named duplicates) brighter than or equal to magnitude magmax, for one
+ * epoch. This is the same as calling swe_fixstar2() for each star, but
+ * the transformations, which do not depend on the star, are done only 
+ * once and the stars are kept in a separate array.
+ * input:
+ * double tjd        julian daynumber, ET
+ * int32 iflag       SEFLG_ specifications, as with swe_fixstar2()
+ * double magmax     faintest magnitude
+ * int32 nmax        size of arrays istar and xx / 6
+ * output:
+ * int32 *istar      sequential star numbers, as can be passed to 
+ *                   swe_fixstar2() as string; brightest star first
+ * double *xx        6 doubles per star, position and speed
+ * double *mag       magnitudes of the stars, may be NULL
+ * int32 *nstar      number of stars returned, at most nmax
+ * char *serr        error return string
+ * return value: iflag or ERR, as with swe_fixstar2()
+ */
+int32 CALL_CONV swe_fixstar2_catalog(double tjd, int32 iflag, double magmax, int32 nmax, int32 *istar, double *xx, double *mag, int32 *nstar, char *serr)
+{
+  int i;
+  int32 k, n, iflgsave = iflag;
+  double daya[2], xobs[6], xobs_dt[6], *xpo = NULL, *xpo_dt = NULL, *x;
+  char star[AS_MAXCH];
+  struct fixstar_epoch fe;
+  struct fixstar_cat *fc = &swed.fixstar_cat;
+  *nstar = 0;
+  if (serr != NULL)
+    *serr = '\0';
+  if (load_all_fixed_stars(serr) == ERR)
+    return ERR;
+  iflag = fixstar_prepare(tjd, iflag, serr);
+  if (fixstar_cat_build(iflag, serr) != OK)
+    return ERR;
+  for (n = 0; n < fc->n && n < nmax && fc->mag[n] <= magmax; n++) {
+    istar[n] = fc->istar[n];
+    if (mag != NULL)
+      mag[n] = fc->mag[n];
+  }
+  if (n == 0)
+    return iflgsave;
+  /* rigorous sidereal positions need the J2000 coordinates */
+  if ((iflag & SEFLG_SIDEREAL) && (swed.sidd.sid_mode & (SE_SIDBIT_ECL_T0 | SE_SIDBIT_SSY_PLANE))) {
+    for (k = 0; k < n; k++) {
+      if (fixstar_calc_from_struct(&swed.fixed_stars[istar[k] - 1], tjd, iflgsave, star, xx + 6 * k, serr) == ERR)
+	return ERR;
+    }
+    *nstar = n;
+    return iflgsave;
+  }
+  if (fixstar_observer(tjd, iflag, PLAN_SPEED_INTV * 0.1, xobs, xobs_dt, &xpo, &xpo_dt, serr) != OK)
+    return ERR;
+  fixstar_epoch_setup(tjd, iflag, xpo, xpo_dt, &fe);
+  if ((iflag & SEFLG_SIDEREAL) && swi_get_ayanamsa_with_speed(tjd, iflag, daya, serr) == ERR)
+    return ERR;
+  k = 0;
+#if SWI_USE_AVX2
+  if (swi_simd_level() == SWI_SIMD_AVX2) {
+    for (; k + 4 <= n; k += 4) {
+      if (!fixstar_cat_apparent_avx2(&fe, k, tjd, xx)) {
+	for (i = 0; i < 4; i++)
+	  fixstar_cat_apparent(&fe, k + i, tjd, xx + 6 * (k + i));
+      }
+    }
+  }
+#endif
+  for (; k < n; k++)
+    fixstar_cat_apparent(&fe, k, tjd, xx + 6 * k);
+  /* sidereal positions, polar coordinates and degrees, 
+   * as in fixstar_calc_from_struct() */
+  for (k = 0; k < n; k++) {
+    x = xx + 6 * k;
+    if (iflag & SEFLG_SIDEREAL) {
+      swi_cartpol_sp(x, x); 
+      x[0] -= daya[0] * DEGTORAD;
+      x[3] -= daya[1] * DEGTORAD;
+      swi_polcart_sp(x, x); 
+    }
+    if ((iflag & SEFLG_XYZ) == 0)
+      swi_cartpol_sp(x, x); 
+    if ((iflag & SEFLG_RADIANS) == 0 && (iflag & SEFLG_XYZ) == 0) {
+      for (i = 0; i < 2; i++) {
+	x[i] *= RADTODEG;
+	x[i+3] *= RADTODEG;
+      }
+    }
+    if (!(iflgsave & SEFLG_SPEED)) {
+      for (i = 3; i <= 5; i++)
+	x[i] = 0;
+    }
+  }
+  *nstar = n;
+  /* swe_fixstar2() returns the flags as they were passed */
+  return iflgsave;
+}
+
+int32 CALL_CONV swe_fixstar2_catalog_ut(double tjd_ut, int32 iflag, double magmax, int32 nmax, int32 *istar, double *xx, double *mag, int32 *nstar, char *serr)
+{
+  double deltat;
+  int32 retflag;
+  int32 epheflag = 0;
+  iflag = plaus_iflag(iflag, -1, tjd_ut, serr);
+  epheflag = iflag & SEFLG_EPHMASK;
+  if (epheflag == 0) {
+    epheflag = SEFLG_SWIEPH;
+    iflag |= SEFLG_SWIEPH;
+  }
+  deltat = swe_deltat_ex(tjd_ut, iflag, serr);
+  /* if ephe required is not ephe returned, adjust delta t: */
+  retflag = swe_fixstar2_catalog(tjd_ut + deltat, iflag, magmax, nmax, istar, xx, mag, nstar, serr);
+  if (retflag != ERR && (retflag & SEFLG_EPHMASK) != epheflag) {
+    deltat = swe_deltat_ex(tjd_ut, retflag, NULL);
+    retflag = swe_fixstar2_catalog(tjd_ut + deltat, iflag, magmax, nmax, istar, xx, mag, nstar, NULL);
+  }
+  return retflag;
+}
+
 /**********************************************************
  * get fixstar magnitude
  * parameters:
@@ -7640,8 +9532,7 @@ static int32 swi_fixstar_calc_from_record(char *srecord, double tjd, int32 iflag
       swed.jpl_file_is_open = FALSE;
     }
     for (i = 0; i < SEI_NEPHFILES; i ++) {
-      if (swed.fidat[i].fptr != NULL) 
-	fclose(swed.fidat[i].fptr);
+      close_ephe_file(&swed.fidat[i]);
       memset((void *) &swed.fidat[i], 0, sizeof(struct file_data));
     }
     swed.last_epheflag = epheflag;
@@ -8304,6 +10195,156 @@ const char *CALL_CONV swe_get_current_file_data(int ifno, double *tfstart, doubl
   return pfp->fnam;
 }
 
+/* Sets the number of decoded ephemeris segments that are kept per body
+ * (SWISSEPH files only). With nseg > 1, alternating between dates in 
+ * different segments does not require reading and unpacking the same 
+ * segments again. nseg = 0 switches the cache off (default).
+ */
+void CALL_CONV swe_set_segment_cache(int32 nseg)
+{
+  int i;
+  swi_init_swed_if_start();
+  if (nseg < 0)
+    nseg = 0;
+  if (nseg > SEI_SEGCACHE_MAX)
+    nseg = SEI_SEGCACHE_MAX;
+  if (nseg == swed.segcache_size)
+    return;
+  swed.segcache_size = nseg;
+  /* caches with the old size are rebuilt when needed */
+  for (i = 0; i < SEI_NPLANETS; i++)
+    segcache_free(&swed.pldat[i]);
+  for (i = 0; i < SEI_NFIT; i++)
+    segcache_free(&swed.fitdat[i]);
+}
+
+/* Sets the number of files of single asteroids and planetary moons 
+ * (SWISSEPH files only) that are kept open, with the constants and 
+ * the current segment of their body, while another one is computed. 
+ * Computing many such bodies in alternation then does not require 
+ * opening the files and reading their headers again. If more files are
+ * needed, the least recently used one is closed. nfiles = 0 switches 
+ * the pool off (default).
+ */
+void CALL_CONV swe_set_asteroid_pool(int32 nfiles)
+{
+  swi_init_swed_if_start();
+  if (nfiles < 0)
+    nfiles = 0;
+  if (nfiles > SEI_ASTPOOL_MAX)
+    nfiles = SEI_ASTPOOL_MAX;
+  if (nfiles == swed.astpool_size)
+    return;
+  free_astpool();
+  swed.astpool_size = nfiles;
+}
+
+/* number of files in the pool, as set by swe_set_asteroid_pool() */
+int32 CALL_CONV swe_get_asteroid_pool(void)
+{
+  swi_init_swed_if_start();
+  return swed.astpool_size;
+}
+
+/* Makes the Moshier theories of the planets and the Moon, and the 
+ * interpolated lunar apsides, be computed from Chebyshev polynomials, 
+ * which are fitted to the theories on the fly and kept in the segment 
+ * cache. precision is the maximum deviation from the theory, in arcsec
+ * (relative to the distance of the body); 0 turns the fits off (default).
+ * This pays off if a body is computed many times within some days
+ * or weeks, e.g. in searches. */
+void CALL_CONV swe_set_analytical_cache(double precision)
+{
+  swi_init_swed_if_start();
+  if (precision < 0)
+    precision = 0;
+  if (precision == swed.fit_prec)
+    return;
+  swed.fit_prec = precision;
+  free_fits();
+}
+
+/* Makes the calling thread use (do_share = TRUE) or stop using 
+ * (do_share = FALSE) a store of decoded ephemeris segments that is shared 
+ * by all threads of the process. Each segment is then read and unpacked
+ * only once per process; all other threads copy it from the store.
+ * The store is freed when the last thread has stopped using it.
+ * A thread that uses the store should call swe_set_shared_segments(FALSE)
+ * or swe_close() before it terminates; after swe_close(), the thread 
+ * must call swe_set_shared_segments(TRUE) again to use the store.
+ * Returns ERR, if the store is not available on this platform.
+ */
+int32 CALL_CONV swe_set_shared_segments(AS_BOOL do_share)
+{
+#if SWI_USE_SHARED_SEGS
+  int i;
+  struct seg_store *st;
+  struct seg_store_node *np, *nnext;
+  swi_init_swed_if_start();
+  if ((do_share && swed.segstore != NULL) || (!do_share && swed.segstore == NULL))
+    return OK;
+  /* only acquisition and release of the store are locked */
+  while (__atomic_test_and_set(&segstore_lock, __ATOMIC_ACQUIRE))
+    ;
+  if (do_share) {
+    if (segstore_global == NULL) 
+      segstore_global = (struct seg_store *) calloc(1, sizeof(struct seg_store));
+    if (segstore_global != NULL) {
+      segstore_global->nrefs++;
+      swed.segstore = segstore_global;
+    }
+  } else {
+    st = swed.segstore;
+    swed.segstore = NULL;
+    if (--st->nrefs == 0) {
+      for (i = 0; i < SEI_SEGSTORE_NBUCKETS; i++) {
+	for (np = st->bucket[i]; np != NULL; np = nnext) {
+	  nnext = np->next;
+	  free((void *) np);
+	}
+      }
+      free((void *) st);
+      segstore_global = NULL;
+    }
+  }
+  __atomic_clear(&segstore_lock, __ATOMIC_RELEASE);
+  if (do_share && swed.segstore == NULL)
+    return ERR;
+  return OK;
+#else
+  (void) do_share;
+  return ERR;
+#endif
+}
+
+/* Returns the number of segments of body ipl that were found in the
+ * segment cache or in the shared segment store (hits) or had to be 
+ * read from the ephemeris file (misses)
+ * since the file was opened. ipl = -1 returns the sum over all bodies.
+ * Numbered asteroids and planetary moons share one counter.
+ */
+int32 CALL_CONV swe_get_segment_cache_stats(int32 ipl, int32 *hits, int32 *misses)
+{
+  int i, ipli;
+  *hits = *misses = 0;
+  if (ipl == -1) {
+    for (i = 0; i < SEI_NPLANETS; i++) {
+      *hits += swed.pldat[i].seghits;
+      *misses += swed.pldat[i].segmisses;
+    }
+    return OK;
+  }
+  if (ipl > SE_PLMOON_OFFSET) 
+    ipli = SEI_ANYBODY;
+  else if (ipl >= SE_SUN && ipl <= SE_VESTA && (ipl < SE_MEAN_NODE || ipl > SE_OSCU_APOG))
+    ipli = pnoext2int[ipl];
+  else
+    return ERR;
+  *hits = swed.pldat[ipli].seghits;
+  *misses = swed.pldat[ipli].segmisses;
+  return OK;
+}
+
 #define CROSS_PRECISION (1 / 3600000.0) 	// one milliarc sec
 
 /*************************************************
@@ -187,10 +187,150 @@
 #define SEI_FILE_REORD  	2
 
 #define SEI_FILE_NMAXPLAN	50
+
+/* SWISSEPH files are read through a read-only memory mapping where the 
+ * platform supports it; the stdio file pointer is kept as a fallback.
+ * Compile with -DNO_SWE_MMAP to always use stdio. */
+#if !MSDOS && !defined(NO_SWE_MMAP)
+#define SWI_USE_MMAP	1
+#else
+#define SWI_USE_MMAP	0
+#endif
+/* Chebyshev series of x, y and z are evaluated with SIMD instructions,
+ * if the CPU supports them, s. swi_echeb_xyz() and interp() in swejpl.c.
+ * AVX2 is detected at runtime (swi_simd_level()), NEON is always 
+ * present on aarch64.
+ * Compile with -DNO_SWE_SIMD to use the scalar code only. */
+#if defined(__GNUC__) && defined(__x86_64__) && !defined(NO_SWE_SIMD)
+#define SWI_USE_AVX2	1
+#else
+#define SWI_USE_AVX2	0
+#endif
+#if defined(__GNUC__) && defined(__aarch64__) && !defined(NO_SWE_SIMD)
+#define SWI_USE_NEON	1
+#else
+#define SWI_USE_NEON	0
+#endif
 #define SEI_FILE_EFPOSBEGIN      500
 
 #define SE_FILE_SUFFIX	"se1"
 
+/* unpacked companion of a SWISSEPH file, created by swephunp.c:
+ * sepl_18.se1 -> sepl_18.su1, in the same directory.
+ * Native byte order, fully unpacked Chebyshev coefficients after 
+ * rot_back(), every segment aligned to SEI_UFILE_ALIGN bytes at a fixed
+ * stride, so that a segment is found without reading an index.
+ * Layout: struct ufile_header, npl x struct ufile_body, then for each
+ * body its segments (nndx x stride doubles) and int32 neval[nndx]. */
+#define SE_UFILE_SUFFIX		"su1"
+#define SEI_UFILE_MAGIC		"SWEPHU1"
+#define SEI_UFILE_VERSION	1
+#define SEI_UFILE_ALIGN		64
+
+struct ufile_header {
+  char magic[8];	/* SEI_UFILE_MAGIC */
+  int32 test_endian;	/* SEI_FILE_TEST_ENDIAN in native byte order */
+  int32 version;	/* SEI_UFILE_VERSION */
+  uint32 fcrc;		/* header CRC of the .se1 file it was made from */
+  int32 npl;		/* number of bodies */
+  double tfstart, tfend;
+  char reserved[24];	/* total size 64 bytes */
+};
+
+struct ufile_body {
+  int32 ibdy;		/* body number as on .se1 file */
+  int32 ncoe;		/* coefficients per coordinate */
+  int32 nndx;		/* number of segments */
+  int32 stride;		/* doubles per segment, multiple of 8 */
+  int32 pos_coef;	/* file position of segment 0 */
+  int32 pos_neval;	/* file position of neval[] */
+  double tfstart, dseg;
+  char reserved[24];	/* total size 64 bytes */
+};
+
+/* binary index of the fixed stars file, created by swephunp.c:
+ * sefstars.txt -> sefstars.sbi, in the same directory.
+ * It contains the array of struct fixed_star as load_all_fixed_stars() 
+ * builds it from the text file, sorted by search key, and an open
+ * addressing hash table of the search keys. The file is mapped into
+ * memory and used without parsing; it is only valid for the text file
+ * with the CRC and length in its header, on machines with the same byte 
+ * order and the same layout of struct fixed_star.
+ * Layout: struct sfile_header, nrecs x struct fixed_star, 
+ * int32 hash[nhash]. */
+#define SE_SFILE_SUFFIX		"sbi"
+#define SEI_SFILE_MAGIC		"SWESTAR"
+#define SEI_SFILE_VERSION	1
+
+struct sfile_header {
+  char magic[8];	/* SEI_SFILE_MAGIC */
+  int32 test_endian;	/* SEI_FILE_TEST_ENDIAN in native byte order */
+  int32 version;	/* SEI_SFILE_VERSION */
+  uint32 tcrc;		/* CRC of the text file it was made from */
+  int32 tlen;		/* length of the text file */
+  int32 recsize;	/* sizeof(struct fixed_star) */
+  int32 nrecs, nreal, nnamed;	/* as swed.n_fixstars_... */
+  int32 nhash;		/* size of hash table, a power of 2 */
+  int32 pos_recs;	/* file position of the records */
+  int32 pos_hash;	/* file position of the hash table */
+  char reserved[12];	/* total size 64 bytes */
+};
+
+/* a mapped star index; with SWI_USE_SHARED_SEGS, one of them is shared
+ * by all threads of the process */
+struct star_index {
+  char fnam[AS_MAXCH];	/* name of the .sbi file */
+  unsigned char *mptr;	/* mapping of the file */
+  size_t mlen;
+  int32 tlen;		/* length of the text file when validated */
+  uint32 tcrc;		/* CRC of the text file when validated */
+  int nrefs;		/* threads using it */
+};
+
+/* catalog of solar and lunar eclipses, created by swephunp.c:
+ * seeclips.sec (SE_ECLFILE) in the ephemeris path. It contains for all
+ * eclipses between tstart and tend, in order of time, the results of 
+ * swe_sol_eclipse_when_glob() and swe_sol_eclipse_where() at maximum,
+ * or of swe_lun_eclipse_when() and swe_lun_eclipse_how(), as computed
+ * with the ephemeris epheflag and the default delta t, tidal 
+ * acceleration and astronomical models. swe_sol_eclipse_when_glob_cat()
+ * and swe_lun_eclipse_when_cat() search it binary; other settings and
+ * dates outside the range fall back to the live search. The file is 
+ * only valid on machines with the same byte order.
+ * Layout: struct efile_header, nsol x struct ecl_record (solar),
+ * nlun x struct ecl_record (lunar). */
+#define SEI_EFILE_MAGIC		"SWEECLI"
+#define SEI_EFILE_VERSION	1
+
+struct efile_header {
+  char magic[8];	/* SEI_EFILE_MAGIC */
+  int32 test_endian;	/* SEI_FILE_TEST_ENDIAN in native byte order */
+  int32 version;	/* SEI_EFILE_VERSION */
+  int32 recsize;	/* sizeof(struct ecl_record) */
+  int32 epheflag;	/* ephemeris used, SEFLG_SWIEPH etc. */
+  int32 nsol, nlun;	/* number of solar and lunar eclipses */
+  int32 pos_sol;	/* file position of the solar eclipses */
+  int32 pos_lun;	/* file position of the lunar eclipses */
+  double tstart, tend;	/* time range searched, UT */
+  char reserved[8];	/* total size 64 bytes */
+};
+
+struct ecl_record {
+  double tret[8];	/* maximum and contacts as from the _when() function */
+  double attr[11];	/* attributes at maximum, saros series and member
+			 * in attr[9] and attr[10] */
+  double geopos[2];	/* solar eclipses: position of maximum */
+  int32 retflag;	/* eclipse type, SE_ECL_TOTAL etc. */
+  int32 reserved;
+};
+
+/* the mapped eclipse catalog of a thread */
+struct ecl_catalog {
+  AS_BOOL is_searched;	/* file has been searched in the ephemeris path */
+  unsigned char *mptr;	/* mapping of the file, NULL if not usable */
+  size_t mlen;
+};
+
 #define SEI_NEPHFILES   7
 #define SEI_CURR_FPOS   -1
 #define SEI_NMODELS 8
@@ -597,6 +737,62 @@ static const struct aya_init ayanamsa[SE_NSIDM_PREDEF] = {
 
 #define PLAN_DATA struct plan_data
 
+/* process-wide store of decoded ephemeris segments shared by all threads,
+ * s. swe_set_shared_segments(). Entries are published with atomic 
+ * compare-and-swap and never modified afterwards, so readers need no lock.
+ * Compile with -DNO_SWE_SHARED_SEGS to leave it out. */
+#if defined(__GNUC__) && !defined(NO_SWE_SHARED_SEGS)
+#define SWI_USE_SHARED_SEGS	1
+#else
+#define SWI_USE_SHARED_SEGS	0
+#endif
+#define SEI_SEGSTORE_NBUCKETS	65536
+#define SEI_SEGSTORE_MAXBYTES	(256L * 1024L * 1024L)
+
+struct seg_store_node {
+  struct seg_store_node *next;
+  uint32 fcrc;		/* CRC of file header, identifies the file */
+  int32 ibdy;		/* body number as on file */
+  int32 iseg;		/* segment number on file */
+  int ncoe, neval;
+  double tseg0, tseg1;
+  double segp[1];	/* 3 x ncoe cheby coeffs, after rot_back() */
+};
+
+struct seg_store {
+  int32 nrefs;		/* number of threads using the store */
+  long nbytes;		/* memory used by nodes */
+  struct seg_store_node *bucket[SEI_SEGSTORE_NBUCKETS];
+};
+
+/* cache of decoded ephemeris segments per body, s. swe_set_segment_cache() */
+#define SEI_SEGCACHE_MAX	64
+
+struct seg_cache {
+  AS_BOOL is_used;	/* FALSE if slot is empty */
+  int32 iseg;		/* segment number, s. segcache_key() */
+  uint32 tused;		/* clock value of last use, for LRU replacement */
+  double tseg0, tseg1;	/* start and end jd of segment */
+  int neval;		/* number of coefficients to evaluate */
+  double *segp;		/* 3 x ncoe cheby coeffs, already rotated back 
+			 * to equatorial J2000 (s. rot_back()) */
+};
+
+/* analytical theories fitted by Chebyshev segments on the fly, 
+ * s. swe_set_analytical_cache(); the segments are kept in a struct plan_data
+ * per theory, as those of the SWISSEPH files */
+#define SEI_FIT_MOON		9	/* 0 - 8 are the Moshier planets, 
+					 * s. pnoint2msh[] in swemplan.c */
+#define SEI_FIT_INTP_APOG	10
+#define SEI_FIT_INTP_PERG	11
+#define SEI_NFIT		12
+#define SEI_FIT_NCOE		16	/* coefficients of a fitted segment */
+#define SEI_FIT_DSEG_MIN	0.0625	/* shortest segment, days */
+#define SEI_FIT_T0		2451903.5	/* origin of the segment grid, 24 Dec 2000 0h */
+
+/* a theory; returns polar coordinates pol of body ibody for time t */
+typedef int (*swi_theory_fn)(double t, int ibody, double *pol);
+
 /* obliquity of ecliptic */
 struct epsilon {
   double teps, eps, seps, ceps; 	/* jd, eps, sin(eps), cos(eps) */
@@ -642,6 +838,17 @@ struct plan_data {
 			 * the size is 3 x ncoe */
   int neval;		/* how many coefficients to evaluate. this may
 			 * be less than ncoe */
+  /* segments in unpacked companion file, if present: */
+  double *ucoef;	/* coefficients of segment 0 */
+  int32 *uneval;	/* neval of each segment */
+  int32 unndx;		/* number of segments */
+  int32 ustride;	/* doubles per segment */
+  /* recently used segments, only if swed.segcache_size > 0: */
+  struct seg_cache *segcache;	/* array of swed.segcache_size slots */
+  int nsegcache;	/* number of slots allocated */
+  uint32 segclock;	/* LRU clock */
+  int32 seghits;	/* segments found in cache */
+  int32 segmisses;	/* segments read from file */
   /* result of most recent data evaluation for this body: */
   double teval;		/* time for which previous computation was made */
   int32 iephe;            /* which ephemeris was used */
@@ -663,18 +870,46 @@ struct plan_data {
 #define STR             4.8481368110953599359e-6 /* radians per arc second */
 
 /* moon, s. moshmoon.c */
+#define MOSHMOON_NSC	80	/* sines and cosines of one epoch */
+#define MOSHMOON_NB	4	/* epochs of a block, s. swi_moshmoon2_batch() */
+#define MOSHMOON_NCHW	6	/* perturbation tables, s. chewm() */
+/* intermediate values of the lunar theory; one structure per thread 
+ * or per concurrent evaluation */
+struct moshmoon_state {
+  double T, T2, T3, T4;		/* Julian centuries from J2000 */
+  double SWELP, M, MP, D, NF;	/* mean elements of moon and sun */
+  double Ve, Ea, Ma, Ju, Sa;	/* mean longitudes of the planets */
+  double f, g, cg, sg;
+  double l, l1, l2, l3, l4, B;	/* longitude and latitude terms */
+  double moonpol[3];
+  double ss[5][8];		/* sin, cos of multiple angles, s. sscc() */
+  double cc[5][8];
+  /* swi_moshmoon2_batch(): epoch of the block and position in the 
+   * values of the block; NULL outside a batch */
+  int mode, nsc, lane, ichw;
+  struct moshmoon_block *blk;
+};
 extern int swi_mean_node(double jd, double *x, char *serr);
 extern int swi_mean_apog(double jd, double *x, char *serr);
 extern int swi_moshmoon(double tjd, AS_BOOL do_save, double *xpm, char *serr) ;
 extern int swi_moshmoon2(double jd, double *x);
+extern int swi_moshmoon2_r(double jd, struct moshmoon_state *ms, double *x);
+extern void swi_moshmoon2_batch(const double *tjd, int n, int simd, struct moshmoon_state *ms, double *x);
+extern int32 swi_moshmoon_batch(const double *tjd, int32 n, int32 iflag, double *xx, char *serr);
 extern int swi_intp_apsides(double J, double *pol, int ipli);
 
 /* planets, s. moshplan.c */
 extern int swi_moshplan(double tjd, int ipli, AS_BOOL do_save, double *xpret, double *xeret, char *serr);
 extern int swi_moshplan2(double J, int iplm, double *pobj);
+extern void swi_moshplan2_batch(const double *tjd, int n, int iplm, int simd, double *pobj);
 extern int swi_osc_el_plan(double tjd, double *xp, int ipl, int ipli, double *xearth, double *xsun, char *serr);
 extern FILE *swi_fopen(int ifno, char *fname, char *ephepath, char *serr);
+extern int32 swi_write_unpacked_file(char *fname, char *fnout, char *serr);
+extern int32 swi_write_star_index(char *fnout, char *serr);
+extern int32 swi_write_eclipse_catalog(double tstart, double tend, int32 epheflag, char *fnout, char *serr);
+extern void swi_close_eclipse_catalog(void);
 extern int32 swi_init_swed_if_start(void);
+extern int swi_fit_theory(int ifit, double tjd, int ibody, swi_theory_fn theory, double *pol);
 extern int32 swi_set_tid_acc(double tjd_ut, int32 iflag, int32 denum, char *serr);
 extern int32 swi_get_tid_acc(double tjd_ut, int32 iflag, int32 denum, int32 *denumret, double *tid_acc, char *serr);
 
@@ -695,6 +930,26 @@ struct nut {
   double matrix[3][3];	
 };
 
+/* precession matrices of the last SEI_PREC_NCACHE epochs, shared by all 
+ * bodies that are computed for the same or nearby dates, s. prec_matrix()
+ * and swi_precess_speed() */
+#define SEI_PREC_NCACHE	8
+struct prec_matrix {
+  double tjd;		/* epoch of pmat, 0 = not valid */
+  int prec_meth;	/* precession model of pmat */
+  int32 iflag;		/* SEFLG_JPLHOR bits of pmat, if the model depends on them */
+  double pmat[9];	/* precession matrix J2000 -> tjd */
+};
+
+struct prec_save {
+  struct prec_matrix mat[SEI_PREC_NCACHE];
+  int next;		/* entry of mat[] to be replaced next */
+  double tstep;		/* interpolation step in days, 0 = exact matrices, 
+  			 * s. swe_set_prec_interpolation() */
+  double tspeed;	/* epoch of dpre_speed, 0 = not valid */
+  double dpre_speed;	/* precession in longitude per day, Vondrak 2011 */
+};
+
 struct plantbl {
   char max_harmonic[9];
   char max_power_of_t;
@@ -712,6 +967,12 @@ struct file_data {
   int32 sweph_denum;     /* DE number of JPL ephemeris, which this file
 			 * is derived from. */
   FILE *fptr;		/* ephemeris file pointer */
+  uint32 fcrc;		/* CRC of file header, as stored on file */
+  unsigned char *mptr;	/* memory mapped image of file, or NULL */
+  size_t mlen;		/* size of mapped image */
+  int32 mpos;		/* current read position in mapped image */
+  unsigned char *uptr;	/* mapped unpacked companion file (*.su1), or NULL */
+  size_t ulen;		/* size of unpacked file */
   double tfstart;       /* file may be used from this date */
   double tfend;         /*      through this date          */
   int32 iflg; 		/* byte reorder flag and little/bigendian flag */
@@ -719,6 +980,19 @@ struct file_data {
   int ipl[SEI_FILE_NMAXPLAN];	/* planet numbers */
 };
  
+/* files of single asteroids and planetary moons that are kept open while
+ * another one occupies swed.fidat[SEI_FILE_ANY_AST], s. swe_set_asteroid_pool() */
+#define SEI_ASTPOOL_MAX	256
+
+struct ast_file {
+  struct file_data fd;	/* open file, as it was in swed.fidat[SEI_FILE_ANY_AST] */
+  struct plan_data pd;	/* constants and segments of its body, as they were
+			 * in swed.pldat[SEI_ANYBODY] */
+  double ast_G, ast_H, ast_diam;
+  char astelem[AS_MAXCH * 10];	/* orbital elements record (swed.astelem) */
+  uint32 tused;		/* clock value of last use, for LRU replacement */
+};
+
 struct gen_const {
  double clight, 
 	aunit, 
@@ -778,6 +1052,20 @@ struct fixed_star {
   double epoch, ra, de, ramot, demot, radvel, parall, mag;
 };
 
+/* the real stars of fixed_stars in separate arrays for 
+ * swe_fixstar2_catalog(), sorted by magnitude: 
+ * cartesian position and space motion per day referred to ICRF or J2000,
+ * not yet moved to the epoch */
+struct fixstar_cat {
+  int32 n;		/* number of stars, 0 = not built */
+  int32 key;		/* frame bias used, s. fixstar_cat_key() */
+  double *x[6];		/* position and speed, arrays aligned to 32 bytes */
+  double *tref;		/* date from which the proper motion is counted */
+  double *mag;		/* magnitude */
+  int32 *istar;		/* sequential star number */
+  double *buf;		/* allocated memory */
+};
+
 /* dpsi and deps loaded for 100 years after 1962 */
 #define SWE_DATA_DPSI_DEPS  36525   
 
@@ -787,6 +1075,31 @@ struct interpol {
   double nut_deps0, nut_deps1, nut_deps2;
 };
 
+/* table of nutation and mean obliquity, s. swe_set_nutation_table();
+ * per node dpsi, deps, eps and their derivatives times step */
+#define SEI_NUTTAB_NVAL		6
+#define SEI_NUTTAB_MAXNODES	2000000
+/* piecewise cubic delta t of one model and tidal acceleration,
+ * s. deltat_table_eval() in swephlib.c */
+#define SEI_DTTAB_MAX		4	/* tables per thread */
+#define SEI_DTTAB_NBUILD	100	/* calls before a table is built */
+struct deltat_table {
+  int deltat_model;
+  double tid_acc;
+  int32 ncalls;		/* calls so far, -1 if building failed */
+  int32 nintv;		/* number of intervals */
+  int32 *icell;		/* first interval of each year */
+  double *tab;		/* start and 4 coefficients per interval */
+};
+
+struct nut_table {
+  double tjd0, tjd1, step;	/* range and step of the nodes */
+  int32 n;			/* number of nodes */
+  int32 iflag;			/* SEFLG_JPLHOR bits of the table */
+  int32 astro_models[SEI_NMODELS];	/* models of the table */
+  double *tab;			/* SEI_NUTTAB_NVAL values per node */
+};
+
 /* if this is changed, then also update initialisation in sweph.c */
 struct swe_data {
   AS_BOOL ephe_path_is_set;
@@ -844,6 +1157,26 @@ struct swe_data {
   AS_BOOL n_fixstars_named;  // number of fixed stars with tradtional name
   AS_BOOL n_fixstars_records;// number of fixed stars records in fixed_stars
   struct fixed_star *fixed_stars;
+  int32 segcache_size;	/* segments cached per body, 0 = no cache */
+  struct seg_store *segstore;	/* shared segment store, if used by this thread */
+  struct prec_save prec;
+  struct nut_table nuttab;
+  struct deltat_table dttab[SEI_DTTAB_MAX];
+  int dttab_next;		/* table to be replaced next */
+  AS_BOOL dttab_on;		/* s. swe_set_deltat_table() */
+  AS_BOOL nut_simd;		/* s. swe_set_nutation_simd() */
+  double fit_prec;		/* s. swe_set_analytical_cache(), 0 = off */
+  struct plan_data fitdat[SEI_NFIT];
+  struct star_index *starindex;	/* mapped star index, if used */
+  int32 *fixstar_hash;	/* hash table of the search keys of fixed_stars,
+			 * index of record or -1 */
+  int32 fixstar_nhash;	/* size of fixstar_hash, a power of 2 */
+  struct fixstar_cat fixstar_cat;	/* s. swe_fixstar2_catalog() */
+  struct ast_file *astpool;	/* s. swe_set_asteroid_pool() */
+  int32 astpool_size;	/* files kept open, 0 = pool off */
+  int32 nastpool;	/* files in pool */
+  uint32 astpool_clock;	/* LRU clock */
+  struct ecl_catalog eclcat;	/* s. swe_sol_eclipse_when_glob_cat() */
 };
 
 extern TLS struct swe_data swed;
@@ -170,6 +170,7 @@ extern "C" {
 #define SE_COASC2		6	/* "co-ascendant" (M. Munkasey) */
 #define SE_POLASC		7	/* "polar ascendant" (M. Munkasey) */
 #define SE_NASCMC		8
+#define SE_HOUSES_ANGLE		100	/* + SE_ASC ... : point in swe_houses_cross() */
 
 /*
  * flag bits for parameter iflag in function swe_calc()
@@ -387,6 +388,7 @@ extern "C" {
 #define SE_STARFILE     "sefstars.txt"
 #define SE_ASTNAMFILE   "seasnam.txt"
 #define SE_FICTFILE     "seorbel.txt"
+#define SE_ECLFILE      "seeclips.sec"
 
 /*
  * ephemeris path
@@ -704,6 +706,17 @@ ext_def(int32) swe_calc_ut(double tjd_ut, int32 ipl, int32 iflag,
 
 ext_def(int32) swe_calc_pctr(double tjd, int32 ipl, int32 iplctr, int32 iflag, double *xxret, char *serr);
 
+/* one body at many epochs; xx returns 6 positions per epoch */
+ext_def(int32) swe_calc_batch(int32 ipl, double *tjd, int32 n, int32 iflag, double *xx, int32 *iflgret, char *serr);
+ext_def(int32) swe_calc_batch_ut(int32 ipl, double *tjd_ut, int32 n, int32 iflag, double *xx, int32 *iflgret, char *serr);
+ext_def(int32) swe_calc_all(double tjd, int32 *ipl, int32 nbody, int32 iflag, double *xx, int32 *iflgret, char *serr);
+ext_def(int32) swe_calc_all_ut(double tjd_ut, int32 *ipl, int32 nbody, int32 iflag, double *xx, int32 *iflgret, char *serr);
+/* heliocentric J2000 positions of a planet (geocentric of the Moon) from the Moshier theory at many epochs */
+ext_def(int32) swe_moshier_batch(int32 ipl, double *tjd, int32 n, int32 iflag, double *xx, char *serr);
+/* positions of many bodies on Keplerian orbits, SE_KEPLER_NELEM elements per body */
+#define SE_KEPLER_NELEM	8
+ext_def(int32) swe_kepler_batch(double tjd, int32 n, const double *elem, int32 iflag, double *xx, char *serr);
+
 ext_def(double) swe_solcross(double x2cross, double jd_et, int32 flag, char *serr);
 ext_def(double) swe_solcross_ut(double x2cross, double jd_ut, int32 flag, char *serr);
 ext_def(double) swe_mooncross(double x2cross, double jd_et, int32 flag, char *serr);
@@ -734,6 +747,12 @@ ext_def(int32) swe_fixstar2_ut(char *star, double tjd_ut, int32 iflag,
 
 ext_def(int32) swe_fixstar2_mag(char *star, double *mag, char *serr);
 
+ext_def(int32) swe_fixstar2_catalog(double tjd, int32 iflag, double magmax, 
+	int32 nmax, int32 *istar, double *xx, double *mag, int32 *nstar, char *serr);
+
+ext_def(int32) swe_fixstar2_catalog_ut(double tjd_ut, int32 iflag, double magmax, 
+	int32 nmax, int32 *istar, double *xx, double *mag, int32 *nstar, char *serr);
+
 /* close Swiss Ephemeris */
 ext_def( void ) swe_close(void);
 
@@ -762,6 +781,16 @@ ext_def(double) swe_get_ayanamsa_ut(double tjd_ut);
 ext_def(const char *) swe_get_ayanamsa_name(int32 isidmode);
 ext_def(const char *) swe_get_current_file_data(int ifno, double *tfstart, double *tfend, int *denum);
 
+/* cache of decoded ephemeris segments per body */
+ext_def(void) swe_set_segment_cache(int32 nseg);
+ext_def(int32) swe_get_segment_cache_stats(int32 ipl, int32 *hits, int32 *misses);
+ext_def(int32) swe_set_shared_segments(AS_BOOL do_share);
+/* files of single asteroids kept open */
+ext_def(void) swe_set_asteroid_pool(int32 nfiles);
+ext_def(int32) swe_get_asteroid_pool(void);
+/* Chebyshev fits of the Moshier theories, precision in arcsec, 0 = off */
+ext_def(void) swe_set_analytical_cache(double precision);
+
 /*ext_def(void) swe_set_timeout(int32 tsec);*/
 
 /**************************** 
@@ -821,6 +850,23 @@ ext_def( int ) swe_houses_ex2(
         double tjd_ut, int32 iflag, double geolat, double geolon, int hsys, 
 	double *cusps, double *ascmc, double *cusp_speed, double *ascmc_speed, char *serr);
 
+ext_def( int ) swe_houses_multi(
+        double tjd_ut, int32 iflag, double geolat, double geolon, int nhsys, const int *hsys, 
+	double *cusps, double *ascmc, double *cusp_speed, double *ascmc_speed, int32 *sysret, char *serr);
+
+ext_def( int ) swe_houses_grid(
+        double tjd_ut, int32 iflag, int hsys, 
+	double lat0, double dlat, int32 nlat, double lon0, double dlon, int32 nlon,
+	double *cusps, double *ascmc, int32 *cellret, char *serr);
+
+ext_def( int ) swe_houses_series(
+        double tjd_ut, double step, int32 n, int32 iflag, double geolat, double geolon, int hsys, 
+	double *cusps, double *ascmc, int32 *sampret, char *serr);
+
+ext_def( int ) swe_houses_cross(
+        double tjd_start, double tjd_end, int32 iflag, double geolat, double geolon, int hsys, 
+	int32 ipoint, double x2cross, double *tret, int32 nmax, int32 *nret, char *serr);
+
 ext_def( int ) swe_houses_armc(
         double armc, double geolat, double eps, int hsys, 
 	double *cusps, double *ascmc);
@@ -832,6 +878,9 @@ ext_def( int ) swe_houses_armc_ex2(
 ext_def(double) swe_house_pos(
 	double armc, double geolat, double eps, int hsys, double *xpin, char *serr);
 
+ext_def(int32) swe_house_pos_batch(
+	double armc, double geolat, double eps, int hsys, int32 n, double *xpin, double *hpos, char *serr);
+
 ext_def(const char *) swe_house_name(int hsys);
 
 
@@ -879,6 +928,14 @@ ext_def (int32) swe_lun_eclipse_when(double tjd_start, int32 ifl, int32 ifltype,
 ext_def (int32) swe_lun_eclipse_when_loc(double tjd_start, int32 ifl, 
      double *geopos, double *tret, double *attr, int32 backward, char *serr);
 
+/* next eclipse from the eclipse catalog, or from the live search
+ * outside the catalog, s. swephunp.c */
+ext_def (int32) swe_sol_eclipse_when_glob_cat(double tjd_start, int32 ifl, int32 ifltype,
+     double *tret, double *attr, double *geopos, int32 backward, char *serr);
+
+ext_def (int32) swe_lun_eclipse_when_cat(double tjd_start, int32 ifl, int32 ifltype,
+     double *tret, double *attr, int32 backward, char *serr);
+
 /* planetary phenomena */
 ext_def (int32) swe_pheno(double tjd, int32 ipl, int32 iflag, double *attr, char *serr);
  
@@ -956,6 +1013,12 @@ ext_def(int32) swe_lat_to_lmt(double tjd_lat, double geolon, double *tjd_lmt, ch
 ext_def( double ) swe_sidtime0(double tjd_ut, double eps, double nut);
 ext_def( double ) swe_sidtime(double tjd_ut);
 ext_def( void ) swe_set_interpolate_nut(AS_BOOL do_interpolate);
+/* nutation dpsi, deps in degrees for many epochs (ET) */
+ext_def( int32 ) swe_nutation_batch(double *tjd, int32 n, int32 iflag, double *dpsi, double *deps, char *serr);
+/* precomputed nutation and obliquity, interpolated within tjd_start..tjd_end */
+ext_def( int32 ) swe_set_nutation_table(double tjd_start, double tjd_end, double step, int32 iflag, char *serr);
+/* precession matrices interpolated between epochs tstep days apart, 0 = exact */
+ext_def( void ) swe_set_prec_interpolation(double tstep);
 
 /* coordinate transformation polar -> polar */
 ext_def( void ) swe_cotrans(double *xpo, double *xpn, double eps);
@@ -968,6 +1031,10 @@ ext_def( void ) swe_set_tid_acc(double t_acc);
 /* set a user defined delta t to be returned by functions
  * swe_deltat() and swe_deltat_ex() */
 ext_def (void) swe_set_delta_t_userdef(double dt);
+/* delta t from precomputed tables or from the model functions (default) */
+ext_def (void) swe_set_deltat_table(AS_BOOL use_table);
+/* IAU 2000 nutation series with SIMD instructions or scalar (default) */
+ext_def (void) swe_set_nutation_simd(AS_BOOL use_simd);
 
 ext_def( double ) swe_degnorm(double x);
 ext_def( double ) swe_radnorm(double x);
@@ -136,6 +136,8 @@ extern void swi_ldp_peps(double J, double *dpre, double *deps);
 /* nutation */
 extern void swi_check_nutation(double tjd, int32 iflag);
 extern int swi_nutation(double J, int32 iflag, double *nutlo);
+extern void swi_nutation_iau2000ab(double J, int nut_model, int simd, double *nutlo);
+extern void swi_free_deltat_tables(void);
 extern void swi_nutate(double *xx, int32 iflag, AS_BOOL backward);
 
 extern void swi_mean_lunar_elements(double tjd, 
@@ -147,6 +149,17 @@ extern double swi_mod2PI(double x);
 /* evaluation of chebyshew series and derivative */
 extern double swi_echeb(double x, double *coef, int ncf);
 extern double swi_edcheb(double x, double *coef, int ncf);
+/* evaluation of the series of x, y, z and their derivatives in one pass */
+extern void swi_echeb_xyz(double x, double *coef, int ncf, int nstride, double *xp, double *xpd);
+extern void swi_echeb_xyz_scalar(double x, double *coef, int ncf, int nstride, double *xp, double *xpd);
+
+/* SIMD instruction set used by vectorized routines, s. SWI_USE_AVX2 */
+#define SWI_SIMD_SCALAR	0
+#define SWI_SIMD_AVX2	1
+#define SWI_SIMD_NEON	2
+extern int swi_simd_level(void);
+extern const char *swi_simd_name(void);
+extern void swi_sincos(const double *x, int n, int simd, double *psin, double *pcos);
 
 /* cross product of vectors */
 extern void swi_cross_prod(double *a, double *b, double *x);
@@ -161,10 +174,15 @@ extern void swi_gen_filename(double tjd, int ipli, char *fname);
 /* cyclic redundancy checksum (CRC), 32 bit */
 extern uint32 swi_crc32(unsigned char *buf, int len);
 
+/* read-only memory mapping of an open file, s. SWI_USE_MMAP */
+extern unsigned char *swi_map_file(FILE *fp, size_t *len);
+extern void swi_unmap_file(unsigned char *p, size_t len);
+
 extern int swi_cutstr(char *s, char *cutlist, char *cpos[], int nmax);
 extern char *swi_right_trim(char *s);
 
 extern double swi_kepler(double E, double M, double ecce);
+extern void swi_kepler_batch(const double *M, const double *ecce, int n, int simd, double *E);
 
 extern char *swi_get_fict_name(int32 ipl, char *s);
 
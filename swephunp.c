@@ -0,0 +1,364 @@
+/********************************************************************
+swephunp.c	
+
+Create unpacked companion files *.su1 of SWISSEPH files *.se1.
+
+The unpacked file contains the Chebyshev coefficients of all segments
+fully decoded, rotated to the equator J2000 and in native byte order,
+each segment aligned to 64 bytes (s. struct ufile_header in sweph.h).
+If it is found next to its .se1 file, sweph() takes segments from it
+without any unpacking. It needs about 5 to 10 times the disk space of 
+the .se1 file. The unpacked file is only valid on machines with the 
+same byte order and must be recreated if the .se1 file is replaced.
+
+For the fixed stars file sefstars.txt, the binary index sefstars.sbi is
+created (s. struct sfile_header in sweph.h). It contains the stars as 
+swe_fixstar2() keeps them in memory, with a hash table of the names,
+and is used instead of reading and sorting the text file. It is ignored
+if the text file is changed.
+
+For the name seeclips.sec, the eclipse catalog is created (s. struct 
+efile_header in sweph.h): all solar and lunar eclipses of a range of 
+years, as found by swe_sol_eclipse_when_glob() and swe_lun_eclipse_when(),
+with contacts and attributes. swe_sol_eclipse_when_glob_cat() and 
+swe_lun_eclipse_when_cat() take the eclipses from it instead of searching
+them. The full range takes a few minutes.
+
+usage:	swephunp [-eDIR] [-yY1,Y2] [-t] file ...
+options: -eDIR	ephemeris directory, where the .se1 files are searched
+		and the .su1 files are written (default SE_EPHE_PATH)
+	 -yY1,Y2 range of years of the eclipse catalog 
+		(default -12998,16799, the range of the Swiss Ephemeris)
+	 -t	test: compare positions computed with and without 
+		the unpacked files
+
+example: swephunp -e./ephe sepl_18.se1 semo_18.se1 seas_18.se1 sefstars.txt
+	 swephunp -e./ephe -y1000,3000 seeclips.sec
+
+*********************************************************************/
+/* Copyright (C) 1997 - 2021 Astrodienst AG, Switzerland.  All rights reserved.
+
+  License conditions
+  ------------------
+
+  This file is part of Swiss Ephemeris.
+
+  Swiss Ephemeris is distributed with NO WARRANTY OF ANY KIND.  No author
+  or distributor accepts any responsibility for the consequences of using it,
+  or for whether it serves any particular purpose or works at all, unless he
+  or she says so in writing.  
+
+  Swiss Ephemeris is made available by its authors under a dual licensing
+  system. The software developer, who uses any part of Swiss Ephemeris
+  in his or her software, must choose between one of the two license models,
+  which are
+  a) GNU Affero General Public License (AGPL)
+  b) Swiss Ephemeris Professional License
+
+  The choice must be made before the software developer distributes software
+  containing parts of Swiss Ephemeris to others, and before any public
+  service using the developed software is activated.
+
+  If the developer choses the AGPL software license, he or she must fulfill
+  the conditions of that license, which includes the obligation to place his
+  or her whole software project under the AGPL or a compatible license.
+  See https://www.gnu.org/licenses/agpl-3.0.html
+
+  If the developer choses the Swiss Ephemeris Professional license,
+  he must follow the instructions as found in http://www.astro.com/swisseph/ 
+  and purchase the Swiss Ephemeris Professional Edition from Astrodienst
+  and sign the corresponding license contract.
+
+  The License grants you the right to use, copy, modify and redistribute
+  Swiss Ephemeris, but only under certain conditions described in the License.
+  Among other things, the License requires that the copyright notices and
+  this notice be preserved on all copies.
+
+  Authors of the Swiss Ephemeris: Dieter Koch and Alois Treindl
+
+  The authors of Swiss Ephemeris have no control or influence over any of
+  the derived works, i.e. over software or services created by other
+  programmers which use Swiss Ephemeris functions.
+
+  The names of the authors or of the copyright holder (Astrodienst) must not
+  be used for promoting any software, product or service which uses or contains
+  the Swiss Ephemeris. This copyright notice is the ONLY place where the
+  names of the authors can legally appear, except in cases where they have
+  given special permission in writing.
+
+  The trademarks 'Swiss Ephemeris' and 'Swiss Ephemeris inside' may be used
+  for promoting such software, products or services.
+*/
+
+# include <stdlib.h>
+# include <string.h>
+# include <math.h>
+# include "swephexp.h"
+# include "sweph.h"
+
+static char *arg0;
+
+#define NTEST	500
+
+/* compares positions computed with and without the unpacked file */
+static int test_file(char *ephepath, char *fname, char *fnout)
+{
+  int i, k, n, ipass, nerr = 0;
+  int32 iflag = SEFLG_SWIEPH | SEFLG_SPEED;
+  int plist[20];
+  double tjd, x[6], *xx[2];
+  char serr[AS_MAXCH], fnsave[AS_MAXCH + 4];
+  FILE *fp;
+  struct ufile_header uh;
+  struct ufile_body ub;
+  static const int pmain[] = {SE_SUN, SE_MOON, SE_MERCURY, SE_VENUS, SE_MARS, SE_JUPITER, SE_SATURN, SE_URANUS, SE_NEPTUNE, SE_PLUTO, SE_CHIRON, SE_PHOLUS, SE_CERES, SE_PALLAS, SE_JUNO, SE_VESTA};
+  if ((fp = fopen(fnout, BFILE_R_ACCESS)) == NULL 
+    || fread((void *) &uh, sizeof(uh), 1, fp) != 1
+    || fread((void *) &ub, sizeof(ub), 1, fp) != 1) {
+    fprintf(stderr, "%s: cannot read %s\n", arg0, fnout);
+    return 1;
+  }
+  fclose(fp);
+  n = (int) (sizeof(pmain) / sizeof(int));
+  for (k = 0; k < n; k++)
+    plist[k] = pmain[k];
+  if (ub.ibdy > SE_PLMOON_OFFSET)	/* single asteroid or planetary moon */
+    plist[n++] = ub.ibdy;
+  xx[0] = (double *) calloc((size_t) NTEST * n * 6, sizeof(double));
+  xx[1] = (double *) calloc((size_t) NTEST * n * 6, sizeof(double));
+  if (xx[0] == NULL || xx[1] == NULL) {
+    fprintf(stderr, "%s: error in malloc()\n", arg0);
+    return 1;
+  }
+  sprintf(fnsave, "%s.tmp", fnout);
+  /* pass 0 with, pass 1 without unpacked file */
+  for (ipass = 0; ipass < 2; ipass++) {
+    if (ipass == 1)
+      rename(fnout, fnsave);
+    swe_close();
+    swe_set_ephe_path(ephepath);
+    for (i = 0; i < NTEST; i++) {
+      tjd = uh.tfstart + 1 + (uh.tfend - uh.tfstart - 2) * i / NTEST;
+      for (k = 0; k < n; k++) {
+	if (swe_calc(tjd, plist[k], iflag, x, serr) < 0)
+	  memset((void *) x, 0, sizeof(x));
+	memcpy((void *) (xx[ipass] + (i * n + k) * 6), (void *) x, sizeof(x));
+      }
+    }
+    if (ipass == 1)
+      rename(fnsave, fnout);
+  }
+  swe_close();
+  for (i = 0; i < NTEST; i++) {
+    for (k = 0; k < n; k++) {
+      if (memcmp(xx[0] + (i * n + k) * 6, xx[1] + (i * n + k) * 6, 6 * sizeof(double)) != 0) {
+	fprintf(stderr, "%s: %s: body %d differs at jd %f\n", arg0, fname, plist[k], 
+	  uh.tfstart + 1 + (uh.tfend - uh.tfstart - 2) * i / NTEST);
+	nerr++;
+      }
+    }
+  }
+  free(xx[0]);
+  free(xx[1]);
+  if (nerr == 0) 
+    printf("%s: test ok\n", fnout);
+  return nerr;
+}
+
+/* compares star positions computed with and without the star index;
+ * each star is searched by number, by name and by Bayer designation */
+#define NSTARS_MAX	20000
+static int test_star_index(char *ephepath, char *fnout)
+{
+  int i, k, ipass, nstars = 0, nerr = 0;
+  int32 iflag = SEFLG_SWIEPH | SEFLG_SPEED;
+  double tjd = 2451545.0, x[6], *xx[2];
+  char star[AS_MAXCH], sname[AS_MAXCH], serr[AS_MAXCH], fnsave[AS_MAXCH + 4], *sp;
+  xx[0] = (double *) calloc((size_t) NSTARS_MAX * 18, sizeof(double));
+  xx[1] = (double *) calloc((size_t) NSTARS_MAX * 18, sizeof(double));
+  if (xx[0] == NULL || xx[1] == NULL) {
+    fprintf(stderr, "%s: error in malloc()\n", arg0);
+    return 1;
+  }
+  sprintf(fnsave, "%s.tmp", fnout);
+  /* pass 0 with, pass 1 without index */
+  for (ipass = 0; ipass < 2; ipass++) {
+    if (ipass == 1)
+      rename(fnout, fnsave);
+    swe_close();
+    swe_set_ephe_path(ephepath);
+    for (i = 0; i < NSTARS_MAX; i++) {
+      sprintf(star, "%d", i + 1);
+      if (swe_fixstar2(star, tjd, iflag, x, serr) < 0)
+	break;
+      memcpy((void *) (xx[ipass] + i * 18), (void *) x, sizeof(x));
+      /* star now contains "name,bayer" */
+      for (k = 1; k < 3; k++) {
+	strcpy(sname, star);
+	sp = strchr(sname, ',');
+	if (k == 1 && sp != NULL)
+	  *sp = '\0';
+	else if (sp != NULL)
+	  memmove(sname, sp, strlen(sp) + 1);
+	if (*sname == '\0' || swe_fixstar2(sname, tjd, iflag, x, serr) < 0)
+	  memset((void *) x, 0, sizeof(x));
+	memcpy((void *) (xx[ipass] + i * 18 + k * 6), (void *) x, sizeof(x));
+      }
+    }
+    if (ipass == 0)
+      nstars = i;
+    if (ipass == 1)
+      rename(fnsave, fnout);
+  }
+  swe_close();
+  for (i = 0; i < nstars; i++) {
+    if (memcmp(xx[0] + i * 18, xx[1] + i * 18, 18 * sizeof(double)) != 0) {
+      fprintf(stderr, "%s: star %d differs\n", arg0, i + 1);
+      nerr++;
+    }
+  }
+  free(xx[0]);
+  free(xx[1]);
+  if (nerr == 0) 
+    printf("%s: test ok, %d stars\n", fnout, nstars);
+  return nerr;
+}
+
+/* compares eclipses found with and without the eclipse catalog, 
+ * forward and backward from random dates, for all and for some types.
+ * Far from the present, the live search depends on the ephemeris files
+ * used before by a few nanoseconds of arc; times must agree within 
+ * ECL_TEST_TOL days, attributes within a relative ECL_TEST_TOL * 100. */
+#define NTEST_ECL	300
+#define ECL_TEST_TOL	1e-7
+static int test_eclipse_catalog(char *ephepath, char *fnout, double tstart, double tend)
+{
+  int i, j, k, ipass, nerr = 0;
+  double d, *x0, *x1;
+  int32 iflag = SEFLG_SWIEPH, rflag;
+  double tjd, tret[10], attr[20], geopos[2], *xx[2], *xp;
+  char serr[AS_MAXCH], fnsave[AS_MAXCH + 4];
+  static const int32 soltypes[] = {0, SE_ECL_TOTAL, SE_ECL_ANNULAR_TOTAL, SE_ECL_PARTIAL};
+  static const int32 luntypes[] = {0, SE_ECL_TOTAL, SE_ECL_PENUMBRAL, SE_ECL_PARTIAL};
+  xx[0] = (double *) calloc((size_t) NTEST_ECL * 2 * 33, sizeof(double));
+  xx[1] = (double *) calloc((size_t) NTEST_ECL * 2 * 33, sizeof(double));
+  if (xx[0] == NULL || xx[1] == NULL) {
+    fprintf(stderr, "%s: error in malloc()\n", arg0);
+    return 1;
+  }
+  sprintf(fnsave, "%s.tmp", fnout);
+  /* pass 0 with, pass 1 without catalog */
+  for (ipass = 0; ipass < 2; ipass++) {
+    if (ipass == 1)
+      rename(fnout, fnsave);
+    swe_close();
+    swe_set_ephe_path(ephepath);
+    srand(1);
+    for (i = 0; i < NTEST_ECL; i++) {
+      /* dates also a little outside the catalog */
+      tjd = tstart - 100 + (tend - tstart + 200) * rand() / RAND_MAX;
+      for (k = 0; k < 2; k++) {
+	xp = xx[ipass] + (i * 2 + k) * 33;
+	if (k == 0)
+	  rflag = swe_sol_eclipse_when_glob_cat(tjd, iflag, soltypes[i % 4], tret, attr, geopos, i % 8 >= 4, serr);
+	else
+	  rflag = swe_lun_eclipse_when_cat(tjd, iflag, luntypes[i % 4], tret, attr, i % 8 >= 4, serr);
+	if (rflag == ERR) {
+	  fprintf(stderr, "%s: %s\n", arg0, serr);
+	  rflag = 0;
+	}
+	xp[0] = rflag;
+	memcpy((void *) (xp + 1), (void *) tret, 10 * sizeof(double));
+	memcpy((void *) (xp + 11), (void *) attr, 20 * sizeof(double));
+	memcpy((void *) (xp + 31), (void *) geopos, 2 * sizeof(double));
+      }
+    }
+    if (ipass == 1)
+      rename(fnsave, fnout);
+  }
+  swe_close();
+  for (i = 0; i < NTEST_ECL * 2; i++) {
+    x0 = xx[0] + i * 33;
+    x1 = xx[1] + i * 33;
+    for (j = 0; j < 33; j++) {
+      d = fabs(x0[j] - x1[j]);
+      if (j >= 11)
+	d /= 100 * (fabs(x1[j]) > 1 ? fabs(x1[j]) : 1);
+      if (j == 0 ? d != 0 : d > ECL_TEST_TOL)
+	break;
+    }
+    if (j < 33) {
+      fprintf(stderr, "%s: %s eclipse %d differs\n", arg0, i % 2 == 0 ? "solar" : "lunar", i / 2);
+      nerr++;
+    }
+  }
+  free(xx[0]);
+  free(xx[1]);
+  if (nerr == 0) 
+    printf("%s: test ok, %d eclipses\n", fnout, NTEST_ECL * 2);
+  return nerr;
+}
+
+int main(int argc, char **argv)
+{
+  int i, nerr = 0;
+  int y1 = -12998, y2 = 16799;
+  AS_BOOL do_test = FALSE;
+  double tstart, tend;
+  char serr[AS_MAXCH], fnout[AS_MAXCH];
+  char ephepath[AS_MAXCH];
+  arg0 = argv[0];
+  strcpy(ephepath, SE_EPHE_PATH);
+  for (i = 1; i < argc; i++) {
+    if (strncmp(argv[i], "-e", 2) == 0) {
+      strncpy(ephepath, argv[i] + 2, AS_MAXCH - 1);
+      ephepath[AS_MAXCH - 1] = '\0';
+    } else if (strncmp(argv[i], "-y", 2) == 0) {
+      if (sscanf(argv[i] + 2, "%d,%d", &y1, &y2) != 2 || y2 <= y1) {
+	fprintf(stderr, "%s: invalid range of years %s\n", arg0, argv[i] + 2);
+	return 1;
+      }
+    } else if (strcmp(argv[i], "-t") == 0) {
+      do_test = TRUE;
+    }
+  }
+  for (i = 1; i < argc; i++) {
+    if (*argv[i] == '-')
+      continue;
+    swe_set_ephe_path(ephepath);
+    if (strcmp(argv[i], SE_STARFILE) == 0) {
+      if (swi_write_star_index(fnout, serr) != OK) {
+	fprintf(stderr, "%s: %s: %s\n", arg0, argv[i], serr);
+	nerr++;
+	continue;
+      }
+      printf("%s -> %s\n", argv[i], fnout);
+      if (do_test)
+	nerr += test_star_index(ephepath, fnout);
+      continue;
+    }
+    if (strcmp(argv[i], SE_ECLFILE) == 0) {
+      tstart = swe_julday(y1, 1, 1, 0, SE_GREG_CAL);
+      tend = swe_julday(y2, 1, 1, 0, SE_GREG_CAL);
+      if (swi_write_eclipse_catalog(tstart, tend, SEFLG_SWIEPH, fnout, serr) != OK) {
+	fprintf(stderr, "%s: %s: %s\n", arg0, argv[i], serr);
+	nerr++;
+	continue;
+      }
+      printf("%s -> %s\n", argv[i], fnout);
+      if (do_test)
+	nerr += test_eclipse_catalog(ephepath, fnout, tstart, tend);
+      continue;
+    }
+    if (swi_write_unpacked_file(argv[i], fnout, serr) != OK) {
+      fprintf(stderr, "%s: %s: %s\n", arg0, argv[i], serr);
+      nerr++;
+      continue;
+    }
+    printf("%s -> %s\n", argv[i], fnout);
+    if (do_test)
+      nerr += test_file(ephepath, argv[i], fnout);
+  }
+  swe_close();
+  return nerr > 0 ? 1 : 0;
+}
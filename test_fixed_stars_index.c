@@ -0,0 +1,201 @@
+/**
+ * @file test_fixed_stars_index.c
+ * @brief Test program for the longitude index of the fixed stars
+ *
+ * The lookups through the index are compared with a linear scan of
+ * all stars. Returns 0 if all of them agree.
+ */
+
+#include "astro_engine.h"
+#include "astro_fixed_stars.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_INDEX_MATCHES 4096
+
+static const double orbs[] = {0.5, 2.0, 8.0};
+#define NUM_ORBS ((int)(sizeof(orbs) / sizeof(orbs[0])))
+
+/* Closest major star within orb of longitude by a linear scan */
+static int scan_at_degree(const double positions[][2], double longitude,
+                          double orb, double *best) {
+    int found = 0;
+
+    for (int i = 0; i < FIXED_STAR_COUNT; i++) {
+        double diff = astro_core_angular_distance(positions[i][0], longitude);
+        if (diff <= orb && (!found || diff < *best)) {
+            *best = diff;
+            found = 1;
+        }
+    }
+    return found;
+}
+
+/* Major stars against astro_fixed_stars_find_at_degree() */
+static int test_find_at_degree(const AstroDateTime *date,
+                               const double positions[][2]) {
+    int failures = 0, checks = 0;
+
+    for (int k = 0; k < 1440; k++) {
+        double longitude = k * 0.25;
+        for (int o = 0; o < NUM_ORBS; o++) {
+            FixedStarID star_id;
+            double best = 0.0;
+            int expected = scan_at_degree(positions, longitude, orbs[o], &best);
+            int found = astro_fixed_stars_find_at_degree(longitude, date, orbs[o], &star_id);
+            checks++;
+            if (found != expected ||
+                (found && astro_core_angular_distance(positions[star_id][0], longitude) != best)) {
+                printf("✗ %.2f° orb %.1f: index %d, scan %d\n",
+                       longitude, orbs[o], found, expected);
+                failures++;
+            }
+        }
+    }
+    printf("  find_at_degree: %d lookups, %d failures\n", checks, failures);
+    return failures;
+}
+
+/* Major stars against astro_fixed_stars_find_conjunctions() */
+static int test_find_conjunctions(const AstroDateTime *date,
+                                  const double positions[][2]) {
+    static FixedStarConjunction conjunctions[FIXED_STAR_COUNT * ASTRO_MAX_PLANETS];
+    static AstroChart chart;
+    int failures = 0;
+
+    /* Points on both sides of 0° and spread over the zodiac */
+    memset(&chart, 0, sizeof(chart));
+    chart.birth_time = *date;
+    chart.num_planets = ASTRO_MAX_PLANETS;
+    for (int p = 0; p < chart.num_planets; p++) {
+        chart.planets[p].planet = (AstroPlanet)p;
+        chart.planets[p].longitude = astro_core_normalize_angle(-3.0 + p * 360.0 / chart.num_planets);
+        snprintf(chart.planets[p].name, ASTRO_MAX_NAME_LEN, "Point %d", p);
+    }
+
+    for (int o = 0; o < NUM_ORBS; o++) {
+        int num = 0, expected = 0;
+        if (astro_fixed_stars_find_conjunctions(&chart, orbs[o], conjunctions,
+                                                FIXED_STAR_COUNT * ASTRO_MAX_PLANETS,
+                                                &num) != ASTRO_OK) {
+            printf("✗ find_conjunctions failed\n");
+            return failures + 1;
+        }
+        for (int p = 0; p < chart.num_planets; p++) {
+            for (int i = 0; i < FIXED_STAR_COUNT; i++) {
+                if (astro_core_angular_distance(positions[i][0], chart.planets[p].longitude) > orbs[o]) {
+                    continue;
+                }
+                expected++;
+                int found = 0;
+                for (int c = 0; c < num; c++) {
+                    if (conjunctions[c].star_id == (FixedStarID)i &&
+                        conjunctions[c].planet == chart.planets[p].planet) {
+                        found = 1;
+                    }
+                }
+                if (!found) {
+                    printf("✗ orb %.1f: %s on %s missing\n", orbs[o],
+                           astro_fixed_stars_get_data((FixedStarID)i)->name,
+                           chart.planets[p].name);
+                    failures++;
+                }
+            }
+        }
+        if (num != expected) {
+            printf("✗ orb %.1f: %d conjunctions, scan %d\n", orbs[o], num, expected);
+            failures++;
+        }
+    }
+    printf("  find_conjunctions: %d orbs, %d failures\n", NUM_ORBS, failures);
+    return failures;
+}
+
+/* Catalog index against a scan of its own arrays */
+static int test_index_query(const AstroDateTime *date) {
+    static int matches[MAX_INDEX_MATCHES];
+    FixedStarIndex index;
+    int failures = 0, checks = 0;
+
+    if (astro_fixed_stars_index_build(date, 4.0, &index) != ASTRO_OK) {
+        printf("  index_query: skipped, sefstars.txt not found\n");
+        return 0;
+    }
+    for (int i = 1; i < index.num_stars; i++) {
+        if (index.longitude[i] < index.longitude[i - 1]) {
+            printf("✗ index not sorted at %d\n", i);
+            failures++;
+        }
+    }
+    for (int k = 0; k < 3600; k++) {
+        double longitude = k * 0.1;
+        for (int o = 0; o < NUM_ORBS; o++) {
+            int num = 0, expected = 0;
+            astro_fixed_stars_index_query(&index, longitude, orbs[o],
+                                          matches, MAX_INDEX_MATCHES, &num);
+            for (int i = 0; i < index.num_stars; i++) {
+                if (astro_core_angular_distance(index.longitude[i], longitude) <= orbs[o]) {
+                    expected++;
+                }
+            }
+            for (int m = 0; m < num; m++) {
+                if (astro_core_angular_distance(index.longitude[matches[m]], longitude) > orbs[o]) {
+                    expected = -1;
+                }
+            }
+            checks++;
+            if (num != expected) {
+                printf("✗ %.1f° orb %.1f: %d matches, scan %d\n",
+                       longitude, orbs[o], num, expected);
+                failures++;
+            }
+        }
+    }
+    printf("  index_query: %d stars, %d lookups, %d failures\n",
+           index.num_stars, checks, failures);
+    astro_fixed_stars_index_free(&index);
+    return failures;
+}
+
+int main(void) {
+    static const int years[] = {1900, 2000, 2025, 2100};
+    double positions[FIXED_STAR_COUNT][2];
+    int num_stars, failures = 0;
+
+    printf("\n");
+    printf("════════════════════════════════════════════════════════════════\n");
+    printf("  FIXED STAR INDEX TEST\n");
+    printf("════════════════════════════════════════════════════════════════\n\n");
+
+    astro_core_init(NULL);
+    astro_core_set_ephemeris_path("./ephe");
+
+    for (int y = 0; y < (int)(sizeof(years) / sizeof(years[0])); y++) {
+        AstroDateTime date;
+        memset(&date, 0, sizeof(date));
+        date.year = years[y];
+        date.month = 1;
+        date.day = 1;
+        date.hour = 12;
+
+        printf("%d-01-01 12:00 UTC\n", years[y]);
+        if (astro_fixed_stars_calc_all_positions(&date, positions, FIXED_STAR_COUNT,
+                                                 &num_stars) != ASTRO_OK) {
+            printf("✗ FAILED: positions of the major stars\n");
+            failures++;
+            continue;
+        }
+        failures += test_find_at_degree(&date, (const double (*)[2])positions);
+        failures += test_find_conjunctions(&date, (const double (*)[2])positions);
+        failures += test_index_query(&date);
+    }
+
+    printf("\n════════════════════════════════════════════════════════════════\n");
+    printf("  %s\n", failures == 0 ? "ALL TESTS PASSED" : "TESTS FAILED");
+    printf("════════════════════════════════════════════════════════════════\n\n");
+
+    astro_core_cleanup();
+
+    return failures == 0 ? 0 : 1;
+}